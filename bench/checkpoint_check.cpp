@@ -0,0 +1,181 @@
+#include "core/simulation.hpp"
+#include "core/snapshot.hpp"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace dune;
+    using namespace dune::core;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::uint64_t SEED = 5;
+    constexpr std::uint64_t CHECKPOINT_TICK = 3000;  // 체크포인트를 잡는 틱
+    constexpr std::uint64_t END_TICK = 20000;        // 두 시뮬레이션을 비교하는 틱
+    constexpr int FUTURES = 4;                       // 되돌리기 전에 시험하는 서로 다른 미래 수
+    constexpr int UNIT_SPACING = 8;                  // 되돌리기 시간 측정 맵에서 병사 간격 (타일 64개당 하나)
+    constexpr int ROUNDS = 20;                       // 되돌리기 시간을 평균 내는 횟수
+
+    bool execute(Simulation& simulation, CommandType type, types::Position source, types::Position target,
+        types::BuildingType building = types::BuildingType::None) {
+        Command command;
+        command.type = type;
+        command.source = source;
+        command.target = target;
+        command.building = building;
+        return simulation.execute(command);
+    }
+
+    /**
+     * @brief 체크포인트 전에 지형, 건물, 유닛이 모두 바뀌도록 명령을 내립니다.
+     */
+    void setUp(Simulation& simulation) {
+        simulation.run(50);
+        execute(simulation, CommandType::Harvest, { constants::MAP_HEIGHT - 5, 0 }, { 15, 4 });
+        execute(simulation, CommandType::PlacePlate, {}, { 10, 10 });
+        simulation.run(30);
+        execute(simulation, CommandType::PlaceBuilding, {}, { 10, 10 }, types::BuildingType::Barracks);
+        execute(simulation, CommandType::ProduceUnit, { 10, 10 }, { 9, 12 });
+        execute(simulation, CommandType::ProduceUnit, { 10, 10 }, { 12, 12 });
+        simulation.run(20);
+        execute(simulation, CommandType::Move, { 9, 12 }, { 3, 40 });
+        execute(simulation, CommandType::Patrol, { 12, 12 }, { 16, 30 });
+        simulation.run(CHECKPOINT_TICK - simulation.getTickCount());
+    }
+
+    std::string saveToBytes(const Simulation& simulation, const std::filesystem::path& path) {
+        if (!saveSnapshot(simulation, path.string())) {
+            return {};
+        }
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+    /**
+     * @brief 체크포인트 → 다른 미래 진행 → 되돌리기를 반복한 뒤 끝까지 진행한 상태가,
+     * 되돌리지 않고 끝까지 진행한 상태와 바이트 단위로 같은지 확인합니다.
+     */
+    bool check(std::size_t threads, const std::filesystem::path& directory) {
+        Simulation reference(nullptr, SEED);
+        reference.setThreadCount(threads);
+        setUp(reference);
+        reference.run(END_TICK - reference.getTickCount());
+        const std::string expected = saveToBytes(reference, directory / "reference.snap");
+
+        Simulation simulation(nullptr, SEED);
+        simulation.setThreadCount(threads);
+        setUp(simulation);
+        const auto checkpoint = simulation.checkpoint();
+
+        bool ok = !expected.empty();
+        for (int future = 0; future < FUTURES; ++future) {
+            execute(simulation, CommandType::Move, { 3, 40 }, { 2 + future, 5 + 10 * future });
+            execute(simulation, CommandType::PlacePlate, {}, { 4, 20 + future * 3 });
+            execute(simulation, CommandType::PlaceBuilding, {}, { 4, 20 + future * 3 }, types::BuildingType::Barracks);
+            simulation.run(500 + static_cast<std::uint64_t>(future) * 3000);
+
+            const auto start = Clock::now();
+            const bool restored = simulation.restore(checkpoint);
+            const double microseconds = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            std::cout << "threads " << threads << ", future " << future << ": restore "
+                      << microseconds << " us" << (restored ? "" : " (failed)") << '\n';
+            ok = ok && restored && simulation.getTickCount() == CHECKPOINT_TICK;
+        }
+
+        // 중간 체크포인트로 되돌린 뒤 첫 체크포인트로 되돌려도 첫 체크포인트에서 이어 간 결과와 같아야 하고,
+        // 첫 체크포인트로 되돌리면 그 뒤에 잡은 중간 체크포인트는 사라집니다.
+        simulation.run(100);
+        const auto middle = simulation.checkpoint();
+        simulation.run(400);
+        ok = ok && simulation.restore(middle);
+        simulation.run(200);
+        ok = ok && simulation.restore(checkpoint) && !simulation.restore(middle);
+        simulation.release(checkpoint);
+
+        simulation.run(END_TICK - simulation.getTickCount());
+        const bool identical = ok && saveToBytes(simulation, directory / "restored.snap") == expected;
+        std::cout << "threads " << threads << ": " << (identical ? "identical" : "MISMATCH") << '\n';
+        return identical;
+    }
+
+
+    /**
+     * @brief 맵에 타일 64개당 병사 하나를 두고 체크포인트를 잡은 뒤, 병사 changed명을 옮기고 체력을 깎고
+     * 타일 changed개를 바위로 바꾸고 되돌리기를 반복해 되돌리는 평균 시간을 잽니다.
+     * @return false 되돌린 뒤 병사나 타일이 체크포인트 때와 다른 경우.
+     */
+    bool measureRollback(int size, int changed) {
+        core::Map map(size, size);
+        std::vector<entity::Unit*> units;
+        for (int row = 0; row < size; row += UNIT_SPACING) {
+            for (int column = 0; column < size; column += UNIT_SPACING) {
+                auto soldier = std::make_unique<entity::Unit>(types::UnitType::Soldier, 1, 1,
+                    types::Position{ row, column }, 15, constants::SOLDIER_SPEED, 5, 1, types::Camp::ArtLadies);
+                soldier->initializeAI();
+                units.push_back(soldier.get());
+                map.addUnit(std::move(soldier));
+            }
+        }
+
+        const auto checkpoint = map.checkpoint();
+        double total = 0;
+        core::Map::JournalStats stats;
+        bool ok = true;
+        for (int round = 0; round < ROUNDS; ++round) {
+            for (int i = 0; i < changed; ++i) {
+                entity::Unit* unit = units[static_cast<std::size_t>(i) * units.size() / changed];
+                const types::Position position = unit->getPosition();
+                map.moveUnit(unit, { position.row, position.column + 1 });
+                map.setUnitHealth(unit, 1);
+                map.setTerrain({ position.row + 1, position.column }, types::TerrainType::Rock);
+            }
+            stats = map.getJournalStats();
+
+            const auto start = Clock::now();
+            ok = map.rollback(checkpoint) && ok;
+            total += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        }
+        for (const auto* unit : units) {
+            const types::Position position = unit->getPosition();
+            ok = ok && unit->getHealth() == 15 && position.row % UNIT_SPACING == 0 && position.column % UNIT_SPACING == 0 &&
+                map.getTerrainManager().getType({ position.row + 1, position.column }) != types::TerrainType::Rock;
+        }
+        map.releaseCheckpoint(checkpoint);
+
+        std::cout << "map " << size << 'x' << size << " (" << units.size() << " units), changed " << changed
+                  << ": restore " << total / ROUNDS << " us (journal: " << stats.units << " units, "
+                  << stats.tiles << " tiles, " << stats.pathCaches << " path caches)"
+                  << (ok ? "" : " MISMATCH") << '\n';
+        return ok;
+    }
+}
+
+/**
+ * @brief 체크포인트 왕복이 결과를 바꾸지 않는지 확인하는 회귀 검사입니다. (ctest에 등록)
+ * 실패하면 0이 아닌 값으로 끝납니다.
+ */
+int main() {
+    const auto directory = std::filesystem::temp_directory_path() / "dune_checkpoint_check";
+    std::filesystem::create_directories(directory);
+
+    bool ok = true;
+    for (const std::size_t threads : { 1, 4 }) {
+        ok = check(threads, directory) && ok;
+    }
+
+    // 되돌리는 시간은 맵 크기가 아니라 바뀐 양을 따라가야 합니다.
+    for (const int size : { 128, 256, 512, 1024 }) {
+        ok = measureRollback(size, 64) && ok;
+    }
+    for (const int changed : { 16, 64, 256, 1024 }) {
+        ok = measureRollback(512, changed) && ok;
+    }
+    std::filesystem::remove_all(directory);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include "core/map.hpp"
+#include "entity/combat_unit_ai.hpp"
+#include "utils/constants.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    using namespace dune;
+    using Clock = std::chrono::steady_clock;
+
+    // 벤치마크 월드 (기본 맵보다 크게 잡고 바위를 흩어 A*가 돌아가야 하도록 합니다)
+    constexpr int WORLD_WIDTH = 256;
+    constexpr int WORLD_HEIGHT = 256;
+    constexpr double ROCK_RATIO = 0.2;
+    constexpr types::Position GOAL{ 200, 200 };
+    constexpr int CHECK_INTERVAL = 100;     // 이동 중인 유닛 수를 세는 주기 (틱)
+
+    /**
+     * @brief 바위를 흩은 맵의 왼쪽 위에 병사들을 배치합니다.
+     */
+    std::vector<entity::Unit*> setUp(core::Map& map, int count) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> roll(0.0, 1.0);
+        for (int row = 0; row < WORLD_HEIGHT; ++row) {
+            for (int column = 0; column < WORLD_WIDTH; ++column) {
+                if (roll(rng) < ROCK_RATIO) {
+                    map.setTerrain({ row, column }, types::TerrainType::Rock);
+                }
+            }
+        }
+        map.setTerrain(GOAL, types::TerrainType::Desert);
+
+        std::vector<entity::Unit*> units;
+        for (int i = 0; i < count; ++i) {
+            types::Position position{ 10 + (i / 20) * 2, 10 + (i % 20) * 2 };
+            map.setTerrain(position, types::TerrainType::Desert);
+            auto soldier = std::make_unique<entity::Unit>(types::UnitType::Soldier, 1, 1, position, 15,
+                constants::SOLDIER_SPEED, 5, 1, types::Camp::ArtLadies);
+            soldier->initializeAI();
+            units.push_back(soldier.get());
+            map.addUnit(std::move(soldier));
+        }
+        return units;
+    }
+
+    int countMoving(const std::vector<entity::Unit*>& units) {
+        return static_cast<int>(std::count_if(units.begin(), units.end(), [](const entity::Unit* unit) {
+            return unit->getCombatUnitAI()->getStateKind() == entity::combat::CombatStateKind::Moving;
+        }));
+    }
+
+    /**
+     * @brief 모든 병사를 한 목표로 보내고 모두 멈출 때까지 진행합니다.
+     * @param count 병사 수.
+     * @param maxTicks 모두 멈추지 않아도 끝낼 틱 수.
+     * @param grouped true면 Map::orderMove()로 명령하고(무리는 흐름장 공유), false면 유닛마다 경로를 찾습니다.
+     */
+    void runBenchmark(int count, int maxTicks, bool grouped) {
+        core::Map map(WORLD_WIDTH, WORLD_HEIGHT);
+        auto units = setUp(map, count);
+        for (auto* unit : units) {
+            if (grouped) {
+                map.orderMove(unit, GOAL);
+            }
+            else {
+                unit->getCombatUnitAI()->moveCommand(GOAL, entity::combat::MoveMode::Path);
+            }
+            map.wakeUnit(unit);
+        }
+
+        std::chrono::milliseconds time{ 0 };
+        int ticks = 0;
+        const auto start = Clock::now();
+        while (ticks < maxTicks) {
+            map.update(time);
+            time += std::chrono::milliseconds(constants::TICK);
+            ++ticks;
+            if (ticks % CHECK_INTERVAL == 0 && countMoving(units) == 0) {
+                break;
+            }
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // 목표까지 남은 평균 거리로 같은 게임 시간 동안 얼마나 나아갔는지 비교합니다.
+        long long distance = 0;
+        for (const auto* unit : units) {
+            const auto position = unit->getPosition();
+            distance += std::abs(position.row - GOAL.row) + std::abs(position.column - GOAL.column);
+        }
+        std::cout << std::left << std::setw(10) << (grouped ? "orderMove" : "path")
+                  << std::right << std::setw(6) << count
+                  << "  game " << std::setw(7) << std::fixed << std::setprecision(1) << ticks * constants::TICK / 1000.0 << " s"
+                  << "  wall " << std::setw(8) << std::setprecision(3) << seconds << " s"
+                  << "  moving " << std::setw(5) << countMoving(units)
+                  << "  mean distance " << std::setw(6) << std::setprecision(1) << static_cast<double>(distance) / count
+                  << "  flow fields " << map.getFlowFieldCache().getBuildCount() << '\n';
+    }
+}
+
+/**
+ * 사용법: group_move_bench [병사 수 (기본 400, 최대 400)] [게임 시간 상한 초 (기본 30)]
+ */
+int main(int argc, char* argv[]) {
+    int count = 400;
+    int seconds = 30;
+    if (argc > 1) {
+        count = std::clamp(std::atoi(argv[1]), 1, 400);
+    }
+    if (argc > 2) {
+        seconds = std::max(1, std::atoi(argv[2]));
+    }
+
+    const int maxTicks = seconds * 1000 / constants::TICK;
+    runBenchmark(count, maxTicks, true);
+    runBenchmark(count, maxTicks, false);
+    return 0;
+}
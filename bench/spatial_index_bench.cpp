@@ -0,0 +1,118 @@
+#include "spatial/spatial_index.hpp"
+#include "entity/unit.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    using namespace dune;
+    using Clock = std::chrono::steady_clock;
+
+    // 벤치마크 월드 크기 (100k 유닛이 서로 다른 타일에 배치될 수 있도록 기본 맵보다 크게 잡습니다)
+    constexpr int WORLD_WIDTH = 512;
+    constexpr int WORLD_HEIGHT = 512;
+    constexpr int SIGHT_RANGE = 8;      // 범위 쿼리 반경 (유닛 시야와 비슷한 크기)
+    constexpr int MOVE_ROUNDS = 4;      // 이동 벤치마크에서 모든 유닛을 옮기는 횟수
+    constexpr int QUERY_COUNT = 100000; // 범위 쿼리 횟수
+
+    const char* indexName(spatial::SpatialIndexType type) {
+        return type == spatial::SpatialIndexType::QuadTree ? "QuadTree" : "UniformGrid";
+    }
+
+    /**
+     * @brief 서로 겹치지 않는 위치에 유닛을 생성합니다. (AI 없이 위치만 가진 유닛)
+     */
+    std::vector<std::unique_ptr<entity::Unit>> makeUnits(int count, std::mt19937& rng) {
+        std::vector<int> tiles(static_cast<size_t>(WORLD_WIDTH) * WORLD_HEIGHT);
+        for (size_t i = 0; i < tiles.size(); ++i) tiles[i] = static_cast<int>(i);
+        std::shuffle(tiles.begin(), tiles.end(), rng);
+
+        std::vector<std::unique_ptr<entity::Unit>> units;
+        units.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            types::Position pos{ tiles[i] / WORLD_WIDTH, tiles[i] % WORLD_WIDTH };
+            units.push_back(std::make_unique<entity::Unit>(
+                types::UnitType::Soldier, 0, 0, pos, 1, 1, 1, SIGHT_RANGE, types::Camp::ArtLadies));
+        }
+        return units;
+    }
+
+    double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    void report(const char* index, int units, const char* op, long long ops, double seconds) {
+        std::cout << std::left << std::setw(12) << index
+                  << std::right << std::setw(8) << units
+                  << "  " << std::left << std::setw(7) << op
+                  << std::right << std::setw(14) << std::fixed << std::setprecision(0)
+                  << (seconds > 0 ? ops / seconds : 0.0) << " ops/s\n";
+    }
+
+    void runBenchmark(spatial::SpatialIndexType type, int unitCount) {
+        std::mt19937 rng(12345);
+        auto units = makeUnits(unitCount, rng);
+        auto index = spatial::createSpatialIndex(type, WORLD_WIDTH, WORLD_HEIGHT);
+
+        // 삽입
+        auto start = Clock::now();
+        for (const auto& unit : units) {
+            index->insert(unit.get());
+        }
+        report(indexName(type), unitCount, "insert", unitCount, secondsSince(start));
+
+        // 이동: 한 칸씩 움직이는 유닛을 remove → moveTo → insert 로 갱신합니다.
+        std::uniform_int_distribution<int> step(-1, 1);
+        start = Clock::now();
+        for (int round = 0; round < MOVE_ROUNDS; ++round) {
+            for (const auto& unit : units) {
+                types::Position pos = unit->getPosition();
+                pos.row = std::clamp(pos.row + step(rng), 0, WORLD_HEIGHT - 1);
+                pos.column = std::clamp(pos.column + step(rng), 0, WORLD_WIDTH - 1);
+                index->remove(unit.get());
+                unit->moveTo(pos);
+                index->insert(unit.get());
+            }
+        }
+        report(indexName(type), unitCount, "move", static_cast<long long>(unitCount) * MOVE_ROUNDS, secondsSince(start));
+
+        // 범위 쿼리: 유닛 위치를 중심으로 시야 범위 사각형을 조회합니다.
+        std::vector<const entity::Unit*> results;
+        std::uniform_int_distribution<int> pick(0, unitCount - 1);
+        size_t found = 0;
+        start = Clock::now();
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            types::Position center = units[pick(rng)]->getPosition();
+            results.clear();
+            index->queryRange(center.column - SIGHT_RANGE, center.row - SIGHT_RANGE,
+                SIGHT_RANGE * 2, SIGHT_RANGE * 2, results);
+            found += results.size();
+        }
+        report(indexName(type), unitCount, "query", QUERY_COUNT, secondsSince(start));
+
+        // 최적화로 쿼리가 제거되지 않도록 결과 수를 사용합니다.
+        if (found == 0) {
+            std::cout << "(no units found in queries)\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> counts = { 1000, 10000, 100000 };
+    if (argc > 1) {
+        counts = { std::max(1, std::atoi(argv[1])) };
+    }
+
+    for (int count : counts) {
+        count = std::min(count, WORLD_WIDTH * WORLD_HEIGHT);
+        for (auto type : { spatial::SpatialIndexType::QuadTree, spatial::SpatialIndexType::UniformGrid }) {
+            runBenchmark(type, count);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "../utils/types.hpp"
+#include <cstdint>
+
+namespace dune {
+    namespace core {
+
+        /**
+         * @brief 플레이어 입력이 시뮬레이션에 내리는 명령의 종류입니다.
+         * 리플레이 파일에 그대로 저장되므로 값을 바꾸거나 중간에 끼워 넣지 않습니다.
+         */
+        enum class CommandType : std::uint8_t {
+            PlacePlate,     // target에 장판 설치
+            PlaceBuilding,  // target에 building 종류의 건물 설치
+            ProduceUnit,    // source 건물이 target에 유닛 생산
+            Move,           // source 유닛을 target으로 이동
+            Harvest,        // source 하베스터가 target 매장지에서 수확
+            Attack,         // source 유닛이 target의 적 유닛을 공격
+            Patrol          // source 유닛이 현재 위치와 target 사이를 순찰
+        };
+
+        /**
+         * @brief 시뮬레이션 명령 하나입니다.
+         * 유닛과 건물은 명령을 내린 틱의 위치로 가리킵니다. 같은 시드에서 같은 틱에 적용하면
+         * 같은 대상을 찾으므로 포인터 없이 저장하고 재생할 수 있습니다.
+         */
+        struct Command {
+            CommandType type = CommandType::Move;
+            types::BuildingType building = types::BuildingType::None;  // PlaceBuilding 전용
+            types::Position source{};   // 명령을 받는 유닛이나 생산 건물의 위치
+            types::Position target{};   // 커서 위치
+        };
+
+    } // namespace core
+} // namespace dune
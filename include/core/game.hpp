@@ -1,5 +1,7 @@
 #pragma once
 #include "map.hpp"
+#include "simulation.hpp"
+#include "replay.hpp"
 #include "../ui/cursor.hpp"
 #include "../ui/display.hpp"
 #include "../utils/types.hpp"
@@ -38,36 +40,11 @@ namespace dune {
              */
             void init();
 
-            /**
-             * @brief 자원 정보를 초기화합니다.
-             */
-            void initResources();
-
-            /**
-             * @brief 초기 건물을 생성하고 배치합니다.
-             */
-            void initBuildings();
-
-            /**
-             * @brief 지형 정보를 초기화합니다.
-             */
-            void initTerrain();
-
-            /**
-             * @brief 샌드웜을 초기화합니다.
-             */
-            void initSandworms();
-
             /**
             * @brief 공중 유닛을 초기화합니다. (현재 미구현)
             */
             void initAirUnits();
 
-            /**
-            * @brief 하베스터 유닛을 초기화합니다.
-            */
-            void initHarvesters();
-
             /**
             * @brief 맵을 초기화합니다.
             */
@@ -107,34 +84,10 @@ namespace dune {
             void handleBuildPlate();
             
             /**
-             * @brief 숙소를 설치합니다.
-             */
-            void handleBuildDormitory();
-
-            /**
-             * @brief 창고를 설치합니다.
-             */
-            void handleBuildGarage();
-
-            /**
-             * @brief 병영을 설치합니다.
-             */
-            void handleBuildBarracks();
-
-            /**
-             * @brief 은신처을 설치합니다.
-             */
-            void handleBuildShelter();
-
-            /**
-             * @brief 투기장을 설치합니다.
-             */
-            void handleBuildArena();
-
-            /**
-             * @brief 공장을 설치합니다.
+             * @brief 커서 위치에 건물을 설치하고 비용과 보너스를 정산합니다.
+             * @param descriptor 설치할 건물 종류의 정보.
              */
-            void handleBuildFactory();
+            void handlePlaceBuilding(const entity::BuildingDescriptor& descriptor);
 
             /**
              * @brief 건물 근처의 빈 공간을 찾습니다.
@@ -144,34 +97,10 @@ namespace dune {
             types::Position findEmptySpaceNearBuilding(const Building* building);
 
             /**
-             * @brief 하베스터를 생산합니다.
-             * @param building 하베스터를 생산할 건물(본진).
-             */
-            void handleBuildHarvester(const Building* building);
-
-            /**
-             * @brief 보병을 생산합니다.
-             * @param building 보병을 생상할 건물(병영).
+             * @brief 선택한 건물이 생산하는 유닛을 커서 위치에 생산합니다.
+             * @param building 선택한 건물.
              */
-            void handleBuildSoldier(const Building* building);
-
-            /**
-             * @brief 프레멘을 생산합니다.
-             * @param building 프레멘을 생상할 건물(은신처).
-             */
-            void handleBuildFremen(const Building* building);
-
-            /**
-             * @brief 투사을 생산합니다.
-             * @param building 투사을 생상할 건물(투기장).
-             */
-            void handleBuildFighter(const Building* building);
-
-            /**
-             * @brief 중전차을 생산합니다.
-             * @param building 중전차을 생상할 건물(공장).
-             */
-            void handleBuildH_Tank(const Building* building);
+            void handleProduceUnit(const Building* building);
 
             /**
              * @brief 선택을 취소하거나 현재 작업을 종료합니다.
@@ -198,30 +127,25 @@ namespace dune {
              */
             void render();
 
-            void addHarvester(const types::Position& pos, types::Camp camp);
-            void addSoldier(const types::Position& pos, types::Camp camp);
-            void addFremen(const types::Position& pos, types::Camp camp);
-            void addFighter(const types::Position& pos, types::Camp camp);
-            void addHeavyTank(const types::Position& pos, types::Camp camp);
-
-            bool placeBuilding(std::unique_ptr<managers::BuildingManager::Building> building);
-
             void showUnitList();
 
+            /**
+             * @brief 선택한 유닛에게 커서 위치를 목표로 이동/수확/공격/순찰 명령을 내립니다.
+             * @param key 입력된 명령 키.
+             */
             void handleUnitCommands(types::Key key);
-            void handleHarvesterCommands(Unit* unit, types::Key key, const types::Position& targetPos);
-            void handleCombatUnitCommands(Unit* unit, types::Key key, const types::Position& targetPos);
 
             // 게임 상태
-            std::chrono::milliseconds sys_clock;
             types::GameState game_state;
             Selection current_selection;
 
             // 게임 객체들
             ui::Display display;
-            Map map;
-            types::Resource resource;
+            Simulation simulation;      // 맵, 자원, 게임 시간을 소유하는 시뮬레이션 코어
+            Map& map;                   // simulation이 소유한 맵
+            types::Resource& resource;  // simulation이 소유한 자원
             ui::Cursor cursor;
+            ReplayWriter replay;        // 이번 경기의 명령 기록
         };
 	} // namespace core
 } // namespace dune
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include "../utils/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        /**
+         * @brief 시뮬레이션에서 일어난 사건의 종류입니다.
+         */
+        enum class GameEventType : std::uint8_t {
+            SpiceDelivered,     // 하베스터가 본진에 스파이스를 내려놓음 (amount: 양)
+            UnitKilled,         // 유닛이 죽음 (unitType: 죽은 유닛, sourceType: 죽인 유닛)
+            BuildingDestroyed,  // 건물이 파괴됨
+            SpiceCreated,       // 샌드웜이 스파이스 매장지를 만듦
+            UnitAttacked        // 전투 유닛이 공격함 (camp/unitType: 공격한 유닛, amount: 피해량)
+        };
+
+        /**
+         * @brief 시뮬레이션 코드가 발행하는 사건 하나입니다.
+         * 문자열을 담지 않는 고정 크기 값이므로 발행과 전달에 할당이 없습니다.
+         */
+        struct GameEvent {
+            GameEventType type;
+            types::Camp camp = types::Camp::Common;                   // 사건 주체의 진영
+            types::UnitType unitType = types::UnitType::Harvester;    // 사건 주체 유닛 종류
+            types::UnitType sourceType = types::UnitType::Harvester;  // 사건을 일으킨 유닛 종류 (UnitKilled)
+            types::Position position{};
+            int amount = 0;
+        };
+
+        /**
+         * @brief 타입이 있는 게임 사건 큐입니다.
+         *
+         * 시뮬레이션 코드는 publish()로 사건을 쌓고, 틱이 끝날 때 dispatch()가 구독자에게 발행 순서대로
+         * 전달한 뒤 큐를 비웁니다. 큐는 용량을 유지하므로 평상시에는 할당하지 않습니다.
+         * 자원 정산과 메시지 창 출력이 각각 구독자입니다.
+         */
+        class EventBus {
+        public:
+            using Handler = std::function<void(const GameEvent&)>;
+
+            EventBus() { pending_.reserve(INITIAL_CAPACITY); }
+
+            /**
+             * @brief 구독자를 등록합니다. 구독자는 등록한 순서대로 사건을 받습니다.
+             * @param handler 사건을 받을 콜백.
+             */
+            void subscribe(Handler handler);
+
+            /**
+             * @brief 사건을 큐에 넣습니다. 구독자에게는 다음 dispatch()에서 전달됩니다.
+             * @param event 발행할 사건.
+             */
+            void publish(const GameEvent& event) { pending_.push_back(event); }
+
+            /**
+             * @brief 쌓인 사건을 모든 구독자에게 전달하고 큐를 비웁니다.
+             * 전달 중에 발행된 사건도 같은 호출에서 전달됩니다.
+             */
+            void dispatch();
+
+            /**
+             * @brief 전달되지 않은 사건 수를 반환합니다.
+             */
+            std::size_t getPendingCount() const { return pending_.size(); }
+
+        private:
+            std::vector<GameEvent> pending_;
+            std::vector<Handler> handlers_;
+
+            static constexpr std::size_t INITIAL_CAPACITY = 256;
+        };
+
+    } // namespace core
+} // namespace dune
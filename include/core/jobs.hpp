@@ -0,0 +1,151 @@
+#pragma once
+#include "work_stealing_deque.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        class JobSystem;
+
+        /**
+         * @brief JobSystem에 제출하는 작업 하나입니다.
+         * 호출자가 소유하며, JobSystem::wait()으로 끝난 것을 확인할 때까지 살아 있어야 합니다.
+         * 한 번만 제출할 수 있습니다.
+         */
+        class Job {
+        public:
+            using Function = std::function<void()>;
+
+            Job() = default;
+            explicit Job(Function function) : function_(std::move(function)) {}
+
+            Job(const Job&) = delete;
+            Job& operator=(const Job&) = delete;
+
+            /**
+             * @brief dependency가 끝난 뒤에 이 작업이 실행되도록 합니다.
+             * 두 작업 모두 제출하기 전에 호출해야 합니다.
+             */
+            void dependsOn(Job& dependency) {
+                dependency.successors_.push_back(this);
+                pending_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 작업과 후속 작업 해제가 모두 끝났는지 확인합니다.
+             */
+            bool isDone() const { return done_.load(std::memory_order_acquire); }
+
+        private:
+            friend class JobSystem;
+
+            /**
+             * @brief 작업 내용을 실행합니다. parallelFor의 구간 작업은 구간 콜백을 부릅니다.
+             */
+            void run(std::size_t worker);
+
+            Function function_;
+            const std::function<void(std::size_t, std::size_t, std::size_t)>* range_ = nullptr;
+            std::size_t begin_ = 0;
+            std::size_t end_ = 0;
+
+            std::vector<Job*> successors_;         // 이 작업이 끝나야 실행할 수 있는 작업
+            std::atomic<int> pending_{ 1 };        // 남은 선행 작업 수 + 제출 전 1
+            std::atomic<bool> done_{ false };
+        };
+
+        /**
+         * @brief 작업자마다 Chase-Lev 덱을 두는 작업 훔치기 스레드 풀입니다.
+         *
+         * 작업자는 자기 덱에서 최근 작업을 꺼내고, 비면 다른 작업자의 덱에서 오래된 작업을 훔칩니다.
+         * 시뮬레이션 계획 단계, 경로 탐색 묶음, 화면 구성처럼 틱마다 생기는 작업이 스레드를 따로 만들지 않고
+         * 이 풀 하나를 함께 씁니다.
+         *
+         * JobSystem을 만든 스레드가 0번 작업자이며, 외부에서는 이 스레드만 작업을 제출하고 기다려야 합니다.
+         * 작업 안에서는 어느 작업자든 제출과 대기를 할 수 있습니다.
+         */
+        class JobSystem {
+        public:
+            /**
+             * @brief 구간 작업 콜백 타입입니다. (begin, end, 작업자 번호)
+             */
+            using RangeFunction = std::function<void(std::size_t, std::size_t, std::size_t)>;
+
+            /**
+             * @brief JobSystem 클래스의 생성자입니다.
+             * @param threadCount 만든 스레드를 포함한 작업자 수 (0이면 1로 취급합니다).
+             */
+            explicit JobSystem(std::size_t threadCount = 1);
+            ~JobSystem();
+
+            JobSystem(const JobSystem&) = delete;
+            JobSystem& operator=(const JobSystem&) = delete;
+
+            /**
+             * @brief 만든 스레드를 포함한 작업자 수를 반환합니다.
+             */
+            std::size_t getThreadCount() const { return deques_.size(); }
+
+            /**
+             * @brief 현재 스레드의 작업자 번호를 반환합니다. (작업자가 아닌 스레드는 0)
+             * 작업자별 버퍼를 고를 때 사용합니다.
+             */
+            std::size_t getCurrentWorker() const;
+
+            /**
+             * @brief 작업을 제출합니다. 선행 작업이 남아 있으면 모두 끝난 뒤에 실행됩니다.
+             */
+            void submit(Job& job);
+
+            /**
+             * @brief 작업이 끝날 때까지 다른 작업을 실행하며 기다립니다.
+             */
+            void wait(Job& job);
+
+            /**
+             * @brief [0, count)를 grain 크기 구간으로 나눠 병렬로 실행하고, 모두 끝나면 반환합니다.
+             * 구간이 어느 작업자에게 갈지는 정해져 있지 않으므로, 결과가 작업자 배정에 따라 달라지면 안 됩니다.
+             * @param count 전체 항목 수.
+             * @param grain 한 작업이 맡을 항목 수.
+             * @param body 구간을 처리할 콜백.
+             */
+            void parallelFor(std::size_t count, std::size_t grain, const RangeFunction& body);
+
+        private:
+            void workerLoop(std::size_t worker);
+
+            /**
+             * @brief 선행 작업 하나가 끝났음을 알리고, 남은 것이 없으면 실행 대기열에 넣습니다.
+             */
+            void release(Job& job);
+            void enqueue(Job& job);
+            void execute(Job& job, std::size_t worker);
+
+            /**
+             * @brief 자기 덱이나 다른 작업자의 덱에서 작업을 하나 찾아 실행합니다.
+             * @return true 작업을 실행한 경우.
+             */
+            bool runOne(std::size_t worker);
+
+            std::vector<std::unique_ptr<WorkStealingDeque<Job*>>> deques_;
+            std::vector<std::thread> threads_;
+
+            std::atomic<std::size_t> queuedJobs_{ 0 };     // 덱에 들어 있는 작업 수 (잠든 작업자 깨우기용)
+            std::atomic<std::size_t> sleepingWorkers_{ 0 };
+            std::atomic<bool> stopping_{ false };
+            std::mutex sleepMutex_;
+            std::condition_variable sleepCondition_;
+
+            static constexpr std::size_t DEQUE_CAPACITY = 4096;
+            static constexpr int IDLE_SPINS = 64;  // 잠들기 전에 작업을 다시 찾아보는 횟수
+        };
+
+    } // namespace core
+} // namespace dune
@@ -2,11 +2,24 @@
 #include "../managers/unit_manager.hpp"
 #include "../managers/building_manager.hpp"
 #include "../managers/terrain_manager.hpp"
-#include "../ui/window/message_window.hpp"
+#include "../pathfinding/pathfinder.hpp"
+#include "../pathfinding/path_cache.hpp"
+#include "../pathfinding/cluster_graph.hpp"
+#include "../pathfinding/flow_field.hpp"
+#include "occupancy_grid.hpp"
+#include "game_event.hpp"
+#include "jobs.hpp"
+#include "plan_context.hpp"
+#include "timing_wheel.hpp"
+#include "snapshot_format.hpp"
+#include "../utils/random.hpp"
 #include "../utils/types.hpp"
 #include <memory>
 #include <chrono>
 #include <string>
+#include <functional>
+#include <span>
+#include <vector>
 
 namespace dune {
     namespace core {
@@ -20,17 +33,27 @@ namespace dune {
             using Building = managers::BuildingManager::Building;
             using Terrain = managers::TerrainManager::Terrain;
 
+            /**
+             * @brief 시스템 메시지를 전달받는 콜백 타입입니다.
+             * UI가 없는 헤드리스 실행에서는 비워 둘 수 있습니다.
+             */
+            using MessageHandler = std::function<void(const std::wstring&)>;
+
             /**
              * @brief Map 클래스의 생성자입니다.
              * @param width 맵의 가로 크기.
              * @param height 맵의 세로 크기.
-             * @param messageWindow 메시지 창 포인터.
+             * @param messageHandler 시스템 메시지를 전달받을 콜백 (없으면 메시지를 버립니다).
              */
-            Map(int width, int height, ui::MessageWindow* messageWindow);
+            Map(int width, int height, MessageHandler messageHandler = nullptr);
+
+            // 매니저 콜백이 this를 참조하므로 복사/이동하지 않습니다.
+            Map(const Map&) = delete;
+            Map& operator=(const Map&) = delete;
 
             /**
              * @brief 특정 위치의 엔티티를 반환하는 템플릿 메서드입니다.
-             * @tparam T 반환할 엔티티의 타입 (Unit, Building, Terrain).
+             * @tparam T 반환할 엔티티의 타입 (Unit, Building). 지형은 getTerrainManager()로 조회합니다.
              * @param position 확인할 위치.
              * @return const T* 해당 위치의 엔티티 포인터.
              */
@@ -40,8 +63,6 @@ namespace dune {
                     return unitManager_.getUnitAt(position);
                 } else if constexpr (std::is_same_v<T, Building>) {
                     return buildingManager_.getBuildingAt(position);
-                } else if constexpr (std::is_same_v<T, Terrain>) {
-                    return &terrainManager_.getTerrain(position);
                 }
                 return nullptr;
             }
@@ -53,16 +74,48 @@ namespace dune {
 
             /**
              * @brief 맵을 업데이트하고 필요한 동작을 수행합니다.
+             * 한 틱은 두 단계로 나뉩니다. 계획 단계에서는 깨어난 유닛의 AI가 틱 시작 시점의 맵을 읽기만 하며
+             * 경로 탐색과 시야 검사 결과를 자기 상태에 준비합니다 (여러 스레드에서 동시에 실행).
+             * 반영 단계에서는 유닛 순서대로 한 스레드에서 AI를 업데이트해 이동/포식/상태 전환을 적용합니다.
+             * 따라서 결과는 계획 스레드 수와 관계없이 항상 같습니다.
              * @param currentTime 현재 시간.
              */
             void update(std::chrono::milliseconds currentTime);
 
+            /**
+             * @brief 계획 단계를 나눠 실행할 작업 풀을 설정합니다. 없으면 update()를 부른 스레드에서 실행합니다.
+             * @param jobs 작업 풀 (맵보다 오래 살아 있어야 합니다).
+             */
+            void setJobSystem(JobSystem* jobs);
+
             /**
              * @brief 시스템 메시지를 추가합니다.
              * @param message 추가할 메시지.
              */
             void addSystemMessage(const std::wstring& message);
 
+            /**
+             * @brief 게임 사건 큐를 반환합니다. 커밋 단계의 상태 코드가 사건을 발행하고, Simulation이 틱마다 전달합니다.
+             */
+            EventBus& getEvents() { return events_; }
+
+            /**
+             * @brief 용도별 난수 생성기를 반환합니다. 커밋 단계(update)에서만 뽑아야 결과가 스레드 수와 무관합니다.
+             * @param stream 난수 용도.
+             */
+            utils::Xoshiro256& getRandom(utils::RandomStream stream) { return random_.get(stream); }
+
+            /**
+             * @brief 경기 시드를 바꾸고 모든 난수 수열을 처음부터 다시 시작합니다.
+             * @param seed 경기 시드.
+             */
+            void setSeed(std::uint64_t seed) { random_.reseed(seed); }
+
+            /**
+             * @brief 경기 시드를 반환합니다.
+             */
+            std::uint64_t getSeed() const { return random_.getSeed(); }
+
             // Manager 접근자
             const managers::TerrainManager& getTerrainManager() const { return terrainManager_; }
             managers::TerrainManager& getTerrainManager() { return terrainManager_; }
@@ -70,6 +123,12 @@ namespace dune {
             managers::UnitManager& getUnitManager() { return unitManager_; }
             const managers::BuildingManager& getBuildingManager() const { return buildingManager_; }
 
+            /**
+             * @brief 지형/건물/유닛 점유 맵을 반환합니다. 막힌 타일 검사에 사용합니다.
+             * @return const OccupancyGrid& 매니저들이 갱신하는 점유 맵.
+             */
+            const OccupancyGrid& getOccupancy() const { return occupancy_; }
+
             // 객체 추가 함수
 
             /**
@@ -101,12 +160,143 @@ namespace dune {
              */
             types::Position findNearestUnit(const types::Position& fromPosition, types::UnitType excludeType);
 
+            /**
+             * @brief 유닛을 새 위치로 이동시키고 유닛 위치 인덱스를 갱신합니다.
+             * 유닛의 위치를 바꿀 때는 Unit::moveTo() 대신 이 함수를 사용해야 합니다.
+             * @param unit 이동할 유닛의 포인터.
+             * @param newPosition 이동할 위치.
+             * @return true 이동 성공, false 대상 위치에 다른 유닛이 있는 경우.
+             */
+            bool moveUnit(Unit* unit, const types::Position& newPosition);
+
+            /**
+             * @brief 유닛의 체력을 바꿉니다. 다른 유닛을 공격할 때는 Unit::setHealth() 대신 이 함수를 사용해야 합니다.
+             * @param unit 체력을 바꿀 유닛.
+             * @param health 새 체력.
+             */
+            void setUnitHealth(Unit* unit, int health);
+
+            /**
+             * @brief 유닛을 바꾸기 전에 체크포인트 이후 처음이면 변경 전 상태를 기록합니다.
+             * 맵 함수를 거치지 않고 AI에 직접 명령을 내리는 곳(플레이어 명령, 전술 계획기)에서 부릅니다.
+             * 잡아 둔 체크포인트가 없으면 아무것도 하지 않습니다.
+             * @param unit 바꿀 유닛.
+             */
+            void touchUnit(const Unit* unit);
+
+            /**
+             * @brief 공유 경로 탐색기로 start에서 goal까지의 경로를 찾습니다.
+             * 경로는 다음 이동 위치가 맨 뒤에 오므로 back()/pop_back()으로 한 칸씩 소비합니다.
+             * @param start 시작 위치.
+             * @param goal 목표 위치.
+             * @param path 결과 경로를 담을 버퍼 (상태 객체가 재사용합니다).
+             * @return true 경로를 찾은 경우.
+             */
+            bool findPath(const types::Position& start, const types::Position& goal, std::vector<types::Position>& path);
+
+            /**
+             * @brief findPath()와 같지만 경로 캐시를 거칩니다.
+             * 하베스터 왕복처럼 같은 목표로 반복해서 이동하는 고정 목표 이동에 사용합니다.
+             * @param unit 이동할 유닛 (현재 위치와 이동 종류를 사용합니다).
+             * @param goal 목표 위치.
+             * @param path 결과 경로를 담을 버퍼.
+             * @return true 경로를 찾은 경우.
+             */
+            bool findCachedPath(const Unit* unit, const types::Position& goal, std::vector<types::Position>& path);
+
+            /**
+             * @brief 먼 거리 이동을 계층적 경로 탐색으로 처리합니다.
+             * 목표가 LONG_PATH_DISTANCE보다 멀면 클러스터 그래프에서 경유지 목록을 구하고, 다음 경유지까지만 A*로 구체화합니다.
+             * 가까우면 findCachedPath()와 같습니다. path를 다 소비하면 같은 waypoints로 다시 호출해 다음 구간을 받습니다.
+             * @param unit 이동할 유닛.
+             * @param goal 목표 위치.
+             * @param waypoints 남은 경유지 (호출자가 보관하며, 비어 있으면 새로 계산합니다).
+             * @param path 다음 경유지까지의 경로를 담을 버퍼.
+             * @return true 경로를 찾은 경우. path와 waypoints가 모두 비면 목표에 도달한 것입니다.
+             */
+            bool findHierarchicalPath(const Unit* unit, const types::Position& goal,
+                std::vector<types::Position>& waypoints, std::vector<types::Position>& path);
+
+            /**
+             * @brief 목표에 대한 공유 흐름장을 반환합니다.
+             * 같은 목표로 이동하는 유닛들은 하나의 흐름장을 함께 참조하며, 마지막 참조가 사라지면 해제됩니다.
+             * @param goal 목표 위치.
+             * @return std::shared_ptr<const pathfinding::FlowField> 흐름장.
+             */
+            std::shared_ptr<const pathfinding::FlowField> acquireFlowField(const types::Position& goal);
+
+            /**
+             * @brief 전투 유닛에게 이동 명령을 내립니다. 플레이어 명령과 전술 계획기가 모두 이 함수를 거칩니다.
+             * 최근 GROUP_MOVE_WINDOW 틱 안에 같은 목표로 GROUP_MOVE_SIZE개 이상의 유닛이 모이면 먼저 명령받은 유닛까지
+             * 모두 MoveMode::FlowField로 바꿔 하나의 흐름장을 공유하고, 그보다 적으면 유닛마다 경로를 찾습니다.
+             * (플레이어가 유닛을 하나씩 찍어 보내도 무리로 묶이도록 같은 틱이 아니어도 모읍니다)
+             * 유닛은 깨우지 않으므로 호출자가 wakeUnit()을 부릅니다.
+             * @param unit 명령을 받을 유닛.
+             * @param goal 목표 위치.
+             * @return false 전투 유닛이 아닌 경우.
+             */
+            bool orderMove(Unit* unit, const types::Position& goal);
+
+            static constexpr std::size_t GROUP_MOVE_SIZE = 3;      // 흐름장을 공유할 최소 유닛 수
+            static constexpr std::uint64_t GROUP_MOVE_WINDOW = 50;  // 같은 무리로 모으는 명령 간격 (틱)
+
+            // 계획 단계용 경로 탐색 (AI의 plan()에서 호출)
+            // 맵을 바꾸지 않고 context의 버퍼만 사용하므로 여러 스레드에서 동시에 호출할 수 있습니다.
+
+            /**
+             * @brief findPath()의 계획 단계 버전입니다.
+             */
+            bool planPath(PlanContext& context, const types::Position& start, const types::Position& goal,
+                std::vector<types::Position>& path) const;
+
+            /**
+             * @brief findCachedPath()의 계획 단계 버전입니다. 캐시 갱신은 계획 단계가 끝난 뒤 반영됩니다.
+             */
+            bool planCachedPath(PlanContext& context, const Unit* unit, const types::Position& goal,
+                std::vector<types::Position>& path) const;
+
+            /**
+             * @brief findHierarchicalPath()의 계획 단계 버전입니다.
+             * 새 경유지 목록이 필요하면(클러스터 그래프 탐색) 계획 단계에서 처리하지 않고 false를 반환하므로,
+             * 반영 단계에서 findHierarchicalPath()로 이어서 처리합니다.
+             */
+            bool planHierarchicalPath(PlanContext& context, const Unit* unit, const types::Position& goal,
+                std::vector<types::Position>& waypoints, std::vector<types::Position>& path) const;
+
+            const pathfinding::PathCache& getPathCache() const { return pathCache_; }
+            const pathfinding::FlowFieldCache& getFlowFieldCache() const { return flowFieldCache_; }
+
+            static constexpr int LONG_PATH_DISTANCE = 64;  // 계층적 탐색을 사용할 최소 맨해튼 거리
+
             /**
              * @brief 유닛을 제거합니다.
              * @param unit 제거할 유닛의 포인터.
              */
             void removeUnit(Unit* unit);
 
+            /**
+             * @brief 예약된 시간과 관계없이 다음 update()에서 유닛을 업데이트하도록 깨웁니다.
+             * 대기 중인 유닛에게 외부에서 명령을 내린 뒤 호출합니다.
+             * @param unit 깨울 유닛.
+             */
+            void wakeUnit(const Unit* unit);
+
+            /**
+             * @brief 가장 먼저 깨어날 유닛의 예약 시간을 구합니다.
+             * 그 전까지의 update()는 아무 유닛도 업데이트하지 않으므로 건너뛸 수 있습니다.
+             * @param time 예약 시간을 받을 변수 (이미 지난 시간일 수 있습니다).
+             * @return true 예약된 유닛이 있으면 true.
+             */
+            bool getNextWakeTime(std::chrono::milliseconds& time) const;
+
+            /**
+             * @brief getNextWakeTime()으로 건너뛴 틱만큼 update() 없이 시간을 진행합니다.
+             * 명령과 스냅샷이 보는 현재 틱이 update()를 부른 틱이 아니라 진행한 틱으로 정해지므로,
+             * 이미 무효가 된 예약 때문에 건너뛰지 못한 틱이 있어도 결과가 같습니다.
+             * @param currentTime 다음으로 처리할 틱의 시간.
+             */
+            void advanceIdle(std::chrono::milliseconds currentTime);
+
             // 건물 관련 함수
 
             /**
@@ -121,6 +311,66 @@ namespace dune {
              */
             void removeDestroyedBuildings();
 
+            // 체크포인트
+
+            using CheckpointId = std::uint64_t;
+
+            /**
+             * @brief 체크포인트 이후 쌓인 변경 기록의 크기입니다. (bench/checkpoint_check.cpp가 출력)
+             */
+            struct JournalStats {
+                std::size_t tiles = 0;      // 바뀐 타일 수 (같은 타일도 바뀔 때마다)
+                std::size_t units = 0;      // 변경 전 상태를 기록한 유닛 수
+                std::size_t buildings = 0;  // 기록한 건물 목록 수
+                std::size_t pathCaches = 0; // 기록한 경로 캐시 수
+            };
+
+            /**
+             * @brief 되돌릴 시점을 잡습니다. 틱 사이(update()가 끝난 뒤)에 불러야 합니다.
+             * 상태를 복사하지 않고 이후에 바뀌는 타일, 건물, 유닛의 변경 전 값을 기록하기 시작할 뿐이라
+             * 비용은 난수 상태와 최근 이동 명령을 복사하는 정도입니다. 잡은 시점은 releaseCheckpoint()로 놓아야 기록이 멈춥니다.
+             * @return CheckpointId rollback()에 넘길 번호.
+             */
+            CheckpointId checkpoint();
+
+            /**
+             * @brief checkpoint()로 잡은 시점으로 되돌립니다. 틱 사이에 불러야 합니다.
+             * 그 뒤에 기록한 변경만 되감으므로 비용은 맵 크기나 유닛 수가 아니라 그동안 바뀐 타일, 건물, 유닛 수에 비례합니다.
+             * (경로 캐시와 건물 목록은 크기가 제한되어 있어 처음 바뀔 때 통째로 기록합니다)
+             * 되돌린 시점은 남아 있어 다시 되돌릴 수 있고, 그 뒤에 잡은 시점은 사라집니다.
+             * @param checkpoint 되돌릴 시점.
+             * @return false 잡혀 있지 않은 시점인 경우 (놓았거나 더 이른 시점으로 되돌려 사라졌으면).
+             */
+            bool rollback(CheckpointId checkpoint);
+
+            /**
+             * @brief 잡은 시점을 놓습니다. 남은 시점이 없으면 변경 기록을 멈추고 비웁니다.
+             * @param checkpoint 놓을 시점 (잡혀 있지 않으면 무시합니다).
+             */
+            void releaseCheckpoint(CheckpointId checkpoint);
+
+            /**
+             * @brief 가장 먼저 잡은 시점 이후 쌓인 변경 기록의 크기를 반환합니다.
+             */
+            JournalStats getJournalStats() const;
+
+            // 스냅샷
+
+            /**
+             * @brief 지형, 건물, 유닛과 AI, 깨우기 예약, 난수 상태, 경로 캐시를 스냅샷 구역에 기록합니다.
+             * 틱 사이(update()가 끝난 뒤)에 불러야 합니다.
+             * @param sections 채울 구역 (시뮬레이션 레코드는 맵이 가진 값만 채웁니다).
+             */
+            void saveSnapshot(snapshot::Sections& sections) const;
+
+            /**
+             * @brief 스냅샷 구역으로 맵을 되살립니다. 유닛과 건물이 없는 새 맵에서만 불러야 합니다.
+             * (같은 맵 안에서 되돌릴 때는 checkpoint()/rollback()을 사용합니다)
+             * @param view 읽을 구역.
+             * @return false 레코드 값이 범위를 벗어난 경우 (맵은 일부만 복원된 상태이므로 버려야 합니다).
+             */
+            bool restoreSnapshot(const snapshot::SectionView& view);
+
             // 유틸리티 함수
 
             /**
@@ -141,14 +391,130 @@ namespace dune {
             void updateSandworm(Unit* unit, std::chrono::milliseconds currentTime);
             types::Position calculateSandwormMove(const Unit* sandworm, const types::Position& targetPosition);
             bool isValidSandwormTarget(const Unit* target) const;
-            std::wstring getUnitTypeName(types::UnitType type) const;
+
+            /**
+             * @brief 유닛의 AI 계획 단계를 실행합니다. (계획 스레드에서 호출)
+             */
+            void planUnit(std::size_t slot, PlanContext& context, std::chrono::milliseconds currentTime) const;
+
+            /**
+             * @brief 경유지 목록의 다음 경유지까지 경로를 구체화합니다.
+             * 구간이 막혀 있으면 경유지를 버리고 목표까지 직접 탐색합니다.
+             */
+            bool refineRoute(pathfinding::Pathfinder& pathfinder, const types::Position& start,
+                const types::Position& goal, std::vector<types::Position>& waypoints,
+                std::vector<types::Position>& path) const;
+
+            /**
+             * @brief 유닛을 tick에 깨우도록 예약합니다. 같은 틱에 이미 예약되어 있으면 무시합니다.
+             */
+            void scheduleWake(std::uint32_t unitId, std::uint64_t tick);
+
+            /**
+             * @brief 이번 틱에 제거된 유닛을 해제하기 전에, 그 유닛을 노리던 전투 AI가 타겟을 놓게 합니다.
+             */
+            void releaseRemovedTargets();
+
+            /**
+             * @brief 창을 벗어났거나 사라진 유닛의 최근 이동 명령을 지웁니다.
+             */
+            void pruneGroupMoves();
+
+            // 스냅샷과 체크포인트 기록이 함께 쓰는 레코드 변환
+
+            void appendBuildings(std::vector<snapshot::BuildingRecord>& records) const;
+            void appendPathCache(std::vector<snapshot::PathCacheRecord>& records,
+                std::vector<snapshot::PositionRecord>& positions) const;
+            void appendUnit(const Unit* unit, std::vector<snapshot::UnitRecord>& records,
+                std::vector<snapshot::PositionRecord>& positions, const snapshot::UnitIds& ids) const;
+
+            /**
+             * @brief 건물 구성이 같으면 체력만 되돌리고, 다르면 (파괴/건설이 있었으면) 목록을 다시 만듭니다.
+             */
+            bool restoreBuildings(std::span<const snapshot::BuildingRecord> records);
+            bool restorePathCache(std::span<const snapshot::PathCacheRecord> records,
+                std::span<const snapshot::PositionRecord> positions, std::uint64_t clock);
+
+            // 체크포인트 변경 기록 (잡은 시점이 없거나 되돌리는 중이면 아무것도 하지 않습니다)
+
+            bool isJournaling() const { return !checkpoints_.empty() && !restoring_; }
+            void journalUnit(std::uint32_t id);
+            void journalBuildings();
+            void journalPathCache();
 
             int width_;
             int height_;
+            OccupancyGrid occupancy_;  // 매니저가 추가/제거/이동 시 갱신하는 타일 점유 비트
             managers::TerrainManager terrainManager_;
             managers::UnitManager unitManager_;
             managers::BuildingManager buildingManager_;
-            ui::MessageWindow* messageWindow_;  // Display의 MessageWindow를 참조
+            pathfinding::Pathfinder pathfinder_;  // 모든 유닛이 공유하는 A* 탐색 버퍼
+            pathfinding::PathCache pathCache_;    // 지형/건물 변경 시에만 폐기되는 경로 캐시
+            pathfinding::ClusterGraph clusterGraph_;  // 먼 거리 탐색용 클러스터 추상 그래프 (첫 사용 시 생성)
+            pathfinding::FlowFieldCache flowFieldCache_;  // 그룹 이동용 목표별 흐름장
+            MessageHandler messageHandler_;  // 시스템 메시지 출력 대상 (Display 또는 없음)
+            EventBus events_;                // 이번 틱에 일어난 게임 사건
+            utils::RandomStreams random_;    // 경기 시드에서 나눈 용도별 난수 수열
+
+            // 유닛 고유 번호를 다음 업데이트 틱에 예약하는 스케줄러.
+            // 다시 예약된 유닛의 이전 항목은 wakeTickById_와 틱이 달라 꺼낼 때 버려집니다.
+            TimingWheel<std::uint32_t> scheduler_;
+            std::vector<std::uint64_t> wakeTickById_;  // 유닛별 유효한 예약 틱 (없으면 NO_TICK)
+            std::vector<std::size_t> dueSlots_;        // 이번 틱에 깨어난 유닛의 칸 번호
+            std::vector<const Unit*> removedUnits_;    // 이번 틱에 제거된 유닛 (releaseRemovedTargets() 버퍼)
+            // 무리 이동으로 묶을 수 있는 최근 이동 명령. 유닛이 사라져도 남지 않도록 고유 번호로 들고,
+            // update()마다 창을 벗어났거나 사라진 유닛의 명령을 지웁니다. 다음 틱 이후에도 남으므로 스냅샷에 함께 저장합니다.
+            struct GroupMove {
+                std::uint32_t unitId;
+                types::Position goal;
+                std::uint64_t tick;     // 명령을 내린 뒤 처음 처리할 틱
+            };
+            std::vector<GroupMove> groupMoves_;
+
+            // 체크포인트. 잡은 시점마다 변경 기록의 시작 위치와, 기록하지 않는 작은 상태(난수, 최근 이동 명령)를 둡니다.
+            // 유닛/건물 목록/경로 캐시는 시점마다 처음 바뀔 때 한 번만 변경 전 레코드를 남기고(시대 번호로 확인),
+            // 되돌릴 때는 범위 안에서 가장 이른 레코드가 그 시점의 상태입니다. 타일은 바뀔 때마다 남겨 거꾸로 되감습니다.
+            struct Checkpoint {
+                CheckpointId id;
+                std::size_t tiles;           // 아래는 각 기록의 시작 위치
+                std::size_t units;
+                std::size_t positions;
+                std::size_t buildingImages;
+                std::size_t pathCacheImages;
+                std::uint32_t unitIdCount;
+                std::uint64_t schedulerNow;
+                utils::RandomStreams random;
+                std::vector<GroupMove> groupMoves;
+            };
+            struct TileChange {
+                types::Position position;
+                types::TerrainType type;     // 바뀌기 전 지형
+            };
+            struct PathCacheImage {
+                std::size_t begin;           // pathCacheJournal_에서 시작 위치
+                std::uint64_t clock;
+            };
+            std::vector<Checkpoint> checkpoints_;   // 잡은 순서대로
+            CheckpointId nextCheckpointId_ = 1;
+            std::uint64_t epoch_ = 1;               // 체크포인트/되돌리기마다 증가 (처음 바뀌는지 확인용)
+            bool restoring_ = false;                // 되돌리는 중에는 기록하지 않습니다.
+            std::vector<TileChange> tileJournal_;
+            std::vector<snapshot::UnitRecord> unitJournal_;
+            std::vector<snapshot::PositionRecord> journalPositions_;  // 유닛 경로와 경로 캐시 경로
+            std::vector<std::uint64_t> unitEpochs_;                   // 고유 번호별 마지막으로 기록한 시대
+            std::vector<snapshot::BuildingRecord> buildingJournal_;
+            std::vector<std::size_t> buildingImages_;                 // 건물 목록마다 buildingJournal_에서 시작 위치
+            std::uint64_t buildingEpoch_ = 0;
+            std::vector<snapshot::PathCacheRecord> pathCacheJournal_;
+            std::vector<PathCacheImage> pathCacheImages_;
+            std::uint64_t pathCacheEpoch_ = 0;
+            std::vector<snapshot::UnitRecord> rollbackUnits_;         // rollback() 버퍼
+
+            JobSystem* jobs_ = nullptr;                // 계획 단계 작업 풀 (없으면 직렬 실행)
+            std::vector<PlanContext> planContexts_;    // 작업자별 계획 버퍼
+            std::vector<pathfinding::PathCacheUpdate> cacheUpdates_;  // 작업자별 갱신을 모아 정렬하는 버퍼
+
+            static constexpr std::size_t PLAN_GRAIN = 64;  // 작업자가 한 번에 가져가는 유닛 수
         };
 
     } // namespace core
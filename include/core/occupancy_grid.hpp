@@ -0,0 +1,95 @@
+#pragma once
+#include "../utils/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        /**
+         * @brief 타일마다 무엇이 자리를 차지하고 있는지 비트로 기록하는 점유 맵입니다.
+         *
+         * 각 매니저가 추가/제거/이동 시 갱신하므로, 막힌 타일 검사는 건물 목록 순회나
+         * 유닛 해시 조회 없이 비트 검사 한 번으로 끝납니다.
+         */
+        class OccupancyGrid {
+        public:
+            /**
+             * @brief 점유 종류를 나타내는 비트입니다.
+             */
+            enum Layer : std::uint8_t {
+                Rock = 1 << 0,      // 통과할 수 없는 지형
+                Building = 1 << 1,  // 건물이 차지한 타일
+                Unit = 1 << 2       // 유닛이 서 있는 타일
+            };
+
+            static constexpr std::uint8_t STATIC_LAYERS = Rock | Building;   // 지형/건물처럼 유닛 이동과 무관한 장애물
+            static constexpr std::uint8_t ALL_LAYERS = Rock | Building | Unit;
+
+            /**
+             * @brief OccupancyGrid 클래스의 생성자입니다.
+             * @param width 맵의 가로 크기.
+             * @param height 맵의 세로 크기.
+             */
+            OccupancyGrid(int width, int height);
+
+            /**
+             * @brief 위치가 주어진 종류 중 하나라도 점유되어 있는지 확인합니다.
+             * @param position 확인할 위치.
+             * @param layers 검사할 점유 종류의 비트 조합.
+             * @return true 점유되어 있거나 맵 범위 밖이면 true.
+             */
+            bool isBlocked(const types::Position& position, std::uint8_t layers = ALL_LAYERS) const {
+                if (!isValidPosition(position)) return true;
+                return (cells_[indexOf(position)] & layers) != 0;
+            }
+
+            /**
+             * @brief 행 우선 인덱스로 점유 여부를 확인합니다. 범위 검사를 하지 않습니다.
+             * @param index 타일 인덱스 (row * width + column).
+             * @param layers 검사할 점유 종류의 비트 조합.
+             * @return true 점유되어 있으면 true.
+             */
+            bool isBlockedAt(std::size_t index, std::uint8_t layers = ALL_LAYERS) const {
+                return (cells_[index] & layers) != 0;
+            }
+
+            /**
+             * @brief 한 타일의 점유 비트를 켜거나 끕니다. 범위 밖 위치는 무시합니다.
+             * @param position 갱신할 위치.
+             * @param layer 갱신할 점유 종류.
+             * @param occupied 점유 여부.
+             */
+            void assign(const types::Position& position, Layer layer, bool occupied);
+
+            /**
+             * @brief 사각형 영역의 점유 비트를 켜거나 끕니다. 맵 밖 부분은 잘라냅니다.
+             * @param origin 영역의 좌상단 위치.
+             * @param width 영역의 가로 크기.
+             * @param height 영역의 세로 크기.
+             * @param layer 갱신할 점유 종류.
+             * @param occupied 점유 여부.
+             */
+            void assignArea(const types::Position& origin, int width, int height, Layer layer, bool occupied);
+
+            int getWidth() const { return width_; }
+            int getHeight() const { return height_; }
+
+        private:
+            bool isValidPosition(const types::Position& position) const {
+                return position.row >= 0 && position.row < height_ &&
+                    position.column >= 0 && position.column < width_;
+            }
+
+            std::size_t indexOf(const types::Position& position) const {
+                return static_cast<std::size_t>(position.row) * width_ + position.column;
+            }
+
+            int width_;
+            int height_;
+            std::vector<std::uint8_t> cells_;  // 행 우선 순서의 Layer 비트 조합
+        };
+
+    } // namespace core
+} // namespace dune
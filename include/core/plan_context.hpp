@@ -0,0 +1,27 @@
+#pragma once
+#include "../pathfinding/pathfinder.hpp"
+#include "../pathfinding/path_cache.hpp"
+#include "../utils/types.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace dune {
+    namespace entity { class Unit; }
+
+    namespace core {
+
+        /**
+         * @brief 계획 단계에서 작업자 스레드 하나가 쓰는 버퍼 묶음입니다.
+         * 계획 단계는 맵을 읽기만 하므로, 공유 캐시에 반영할 내용은 여기 모았다가
+         * 계획이 끝난 뒤 유닛 순서(order)대로 적용합니다.
+         */
+        struct PlanContext {
+            pathfinding::Pathfinder pathfinder;              // 작업자 전용 A* 탐색 버퍼
+            std::vector<types::Position> stitch;             // 경로 캐시 국소 탐색 버퍼
+            std::vector<pathfinding::PathCacheUpdate> cacheUpdates;  // 계획 후 적용할 경로 캐시 갱신
+            std::vector<const entity::Unit*> nearbyUnits;    // 시야/먹이 검사의 공간 인덱스 결과 버퍼
+            std::size_t order = 0;                           // 지금 계획 중인 유닛의 이번 틱 업데이트 순번
+        };
+
+    } // namespace core
+} // namespace dune
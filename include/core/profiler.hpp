@@ -0,0 +1,262 @@
+#pragma once
+#include "trace.hpp"
+#include "../utils/types.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        /**
+         * @brief 시간을 재는 고정 구간입니다. 유닛 업데이트 구간은 Profiler::unitZone()으로 따로 만듭니다.
+         * 구간은 안쪽 구간의 시간을 포함합니다. (예: MapUpdate ⊃ MapPlan ⊃ 유닛 ⊃ AStar)
+         */
+        enum class ProfileZone : std::uint8_t {
+            ProcessInput,               // Game::processInput
+            UpdateGameState,            // Game::updateGameState
+            DisplayUpdate,              // Display::update (화면 구성과 콘솔 출력)
+            ConsoleFlush,               // 구성한 화면을 콘솔에 내보내는 부분
+            SimulationStep,             // Simulation::step
+            TacticalPlanner,            // TacticalPlanner::plan
+            MapUpdate,                  // Map::update
+            MapPlan,                    // Map::update의 병렬 계획 단계
+            MapApply,                   // Map::update의 반영 단계
+            RemoveDestroyedBuildings,   // Map::removeDestroyedBuildings
+            EventDispatch,              // 틱 끝의 사건 전달
+            AStar,                      // Pathfinder의 A* 탐색 한 번
+            FlowField,                  // 흐름장 하나를 만드는 BFS
+            ClusterRoute,               // 클러스터 그래프 경로 탐색 한 번
+            Count
+        };
+
+        /**
+         * @brief HdrHistogram처럼 값의 크기에 비례하는 폭의 칸으로 나눠 세는 히스토그램입니다.
+         * 2의 거듭제곱 구간마다 32칸(64 미만은 1칸에 1값)을 두므로 어느 크기에서나 상대 오차가 약 3% 이내이고,
+         * 기록은 시프트 몇 번과 덧셈 하나입니다.
+         */
+        class LatencyHistogram {
+        public:
+            void record(std::uint64_t value);
+
+            std::uint64_t getCount() const { return count_; }
+            std::uint64_t getMax() const { return max_; }
+            std::uint64_t getTotal() const { return total_; }
+
+            /**
+             * @brief 기록한 값 중 percentile(%) 위치의 값을 반환합니다. 칸의 상한으로 답하되 최댓값을 넘지 않습니다.
+             * @param percentile 0 ~ 100.
+             * @return std::uint64_t 값 (기록이 없으면 0).
+             */
+            std::uint64_t getValueAtPercentile(double percentile) const;
+
+        private:
+            static constexpr unsigned SUB_BUCKET_BITS = 6;
+            static constexpr std::size_t SUB_BUCKET_COUNT = std::size_t{ 1 } << SUB_BUCKET_BITS;
+            static constexpr std::size_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+            // 64 미만은 값마다 1칸, 그 위는 2의 거듭제곱 구간마다 절반 칸씩 (uint64 전체)
+            static constexpr std::size_t BUCKET_COUNT = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+
+            static std::size_t indexOf(std::uint64_t value);
+            static std::uint64_t highestEquivalentValue(std::size_t index);
+
+            std::array<std::uint64_t, BUCKET_COUNT> counts_{};
+            std::uint64_t count_ = 0;
+            std::uint64_t max_ = 0;
+            std::uint64_t total_ = 0;
+        };
+
+        /**
+         * @brief 틱마다 구간별 시간을 모아 히스토그램으로 보여 주는 프로파일러입니다.
+         *
+         * 구간 시간은 ProfileScope가 스레드마다 따로 더하고, 루프를 도는 쪽이 틱 끝에서 endTick()을 부르면
+         * 모든 스레드의 합을 구간별 히스토그램에 한 값으로 넣습니다. 그래서 히스토그램 값은 "한 틱 동안 그 구간에
+         * 쓴 시간"이고, 병렬 계획 단계 안의 구간은 작업자들의 시간을 더한 값입니다. 시간을 건너뛴 빈 틱은 세지 않습니다.
+         * 꺼져 있으면 ProfileScope는 원자 변수 두 개(측정, 타임라인)만 읽습니다. 켜고 끄는 것은 실행 중 언제든 할 수 있습니다.
+         */
+        class Profiler {
+        public:
+            static constexpr std::size_t UNIT_STATE_COUNT = 8;  // 유닛 타입마다 구간을 나눌 AI 상태 수
+            static constexpr std::size_t FIXED_ZONE_COUNT = static_cast<std::size_t>(ProfileZone::Count);
+            static constexpr std::size_t UNIT_TYPE_COUNT = static_cast<std::size_t>(types::UnitType::Sandstorm) + 1;
+            static constexpr std::size_t ZONE_COUNT = FIXED_ZONE_COUNT + UNIT_TYPE_COUNT * UNIT_STATE_COUNT;
+
+            /**
+             * @brief 프로세스 전체가 공유하는 프로파일러를 반환합니다.
+             */
+            static Profiler& instance();
+
+            /**
+             * @brief 보고서 경로가 정해져 있으면 종료할 때 보고서를 씁니다.
+             */
+            ~Profiler();
+
+            Profiler(const Profiler&) = delete;
+            Profiler& operator=(const Profiler&) = delete;
+
+            /**
+             * @brief 구간 번호를 반환합니다.
+             */
+            static constexpr std::size_t zone(ProfileZone zone) { return static_cast<std::size_t>(zone); }
+
+            /**
+             * @brief 유닛 타입과 업데이트 전 AI 상태로 구간 번호를 만듭니다.
+             * @param type 유닛 타입.
+             * @param state 해당 타입의 상태 종류 (HarvesterStateKind, CombatStateKind 등).
+             */
+            template<typename StateKind>
+            static constexpr std::size_t unitZone(types::UnitType type, StateKind state) {
+                const auto stateIndex = static_cast<std::size_t>(state);
+                return FIXED_ZONE_COUNT + static_cast<std::size_t>(type) * UNIT_STATE_COUNT +
+                    (stateIndex < UNIT_STATE_COUNT ? stateIndex : UNIT_STATE_COUNT - 1);
+            }
+
+            /**
+             * @brief 측정을 켜거나 끕니다. 켤 때는 끄기 전에 쌓다 만 틱 값을 버립니다. 틱 사이에 불러야 합니다.
+             */
+            void setEnabled(bool enabled);
+
+            bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief 종료할 때 보고서를 쓸 파일을 정합니다. 빈 문자열이면 쓰지 않습니다.
+             */
+            void setReportPath(const std::string& path);
+
+            /**
+             * @brief 지금 스레드의 이번 틱 구간 시간에 더합니다. 보통은 ProfileScope가 부릅니다.
+             * @param zone 구간 번호.
+             * @param elapsed 걸린 시간.
+             */
+            void record(std::size_t zone, std::chrono::nanoseconds elapsed);
+
+            /**
+             * @brief 이번 틱에 모인 구간 시간을 히스토그램에 넣고 다음 틱을 시작합니다.
+             * 병렬 작업이 모두 끝난 뒤 루프를 도는 스레드에서 불러야 합니다.
+             */
+            void endTick();
+
+            /**
+             * @brief 모은 통계를 모두 지웁니다. 틱 사이에 불러야 합니다.
+             */
+            void reset();
+
+            /**
+             * @brief 구간별 p50/p99/최댓값과 호출 수를 표로 씁니다.
+             */
+            void writeReport(std::ostream& out) const;
+
+            /**
+             * @brief 보고서를 파일로 씁니다.
+             * @return false 파일을 열 수 없는 경우.
+             */
+            bool writeReport(const std::string& path) const;
+
+            /**
+             * @brief 구간 이름을 반환합니다. (예: "MapPlan", "Soldier/Pursuing")
+             */
+            static std::string getZoneName(std::size_t zone);
+
+            /**
+             * @brief 구간의 틱당 시간 히스토그램을 반환합니다. (ns, 기록이 없으면 nullptr)
+             */
+            const LatencyHistogram* getHistogram(std::size_t zone) const { return zones_[zone].histogram.get(); }
+
+            std::uint64_t getCallCount(std::size_t zone) const { return zones_[zone].calls; }
+            std::uint64_t getTickCount() const { return ticks_; }
+
+        private:
+            Profiler() = default;
+
+            // 스레드 하나가 이번 틱에 쌓은 값 (그 스레드만 씁니다)
+            struct ThreadTotals {
+                std::array<std::uint64_t, ZONE_COUNT> nanoseconds{};
+                std::array<std::uint32_t, ZONE_COUNT> calls{};
+            };
+
+            struct ZoneStats {
+                std::unique_ptr<LatencyHistogram> histogram;  // 처음 기록할 때 만듭니다.
+                std::uint64_t calls = 0;
+            };
+
+            ThreadTotals& getThreadTotals();
+
+            /**
+             * @brief 끝나는 스레드의 칸을 다른 스레드가 쓰도록 돌려받습니다.
+             */
+            void releaseThreadTotals(ThreadTotals* totals);
+
+            std::atomic<bool> enabled_{ false };
+            std::mutex threadsMutex_;
+            std::vector<std::unique_ptr<ThreadTotals>> threads_;  // 동시에 살아 있던 스레드 수만큼만 만듭니다.
+            std::vector<ThreadTotals*> freeThreads_;               // 끝난 스레드가 돌려준 칸 (threads_ 안을 가리킴)
+            std::array<ZoneStats, ZONE_COUNT> zones_;
+            std::uint64_t ticks_ = 0;
+            std::string reportPath_;
+        };
+
+        /**
+         * @brief 만들 때부터 사라질 때까지의 시간을 구간에 더하는 범위 타이머입니다.
+         * 타임라인을 기록 중이면 고정 구간은 TraceRecorder에도 구간 사건으로 남깁니다.
+         */
+        class ProfileScope {
+        public:
+            explicit ProfileScope(ProfileZone zone) : ProfileScope(Profiler::zone(zone)) {}
+
+            explicit ProfileScope(std::size_t zone)
+                : zone_(zone)
+                , profiling_(Profiler::instance().isEnabled())
+                , tracing_(zone < Profiler::FIXED_ZONE_COUNT && TraceRecorder::instance().isRecording()) {
+                if (profiling_ || tracing_) {
+                    start_ = std::chrono::steady_clock::now();
+                }
+            }
+
+            ~ProfileScope() {
+                if (!profiling_ && !tracing_) {
+                    return;
+                }
+                const auto end = std::chrono::steady_clock::now();
+                if (profiling_) {
+                    Profiler::instance().record(zone_, end - start_);
+                }
+                if (tracing_) {
+                    TraceRecorder::instance().recordZone(zone_, start_, end, args_.data(), argCount_);
+                }
+            }
+
+            ProfileScope(const ProfileScope&) = delete;
+            ProfileScope& operator=(const ProfileScope&) = delete;
+
+            /**
+             * @brief 타임라인 사건에 붙일 정수 인자를 정합니다. 순서는 구간마다 정해져 있습니다. (trace.cpp 참고)
+             */
+            void setTraceArgs(std::initializer_list<std::int32_t> args) {
+                if (tracing_) {
+                    argCount_ = std::min(args.size(), args_.size());
+                    std::copy_n(args.begin(), argCount_, args_.begin());
+                }
+            }
+
+            bool isTracing() const { return tracing_; }
+
+        private:
+            std::size_t zone_;
+            bool profiling_;
+            bool tracing_;
+            std::chrono::steady_clock::time_point start_;
+            std::array<std::int32_t, TraceEvent::MAX_ARGS> args_;
+            std::size_t argCount_ = 0;
+        };
+
+    } // namespace core
+} // namespace dune
@@ -0,0 +1,100 @@
+#pragma once
+#include "command.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        class Simulation;
+
+        /**
+         * @brief 리플레이에 기록된 명령 하나와 적용한 틱입니다.
+         */
+        struct ReplayEntry {
+            std::uint64_t tick;
+            Command command;
+        };
+
+        /**
+         * @brief 메모리에 읽어 들인 리플레이입니다.
+         */
+        struct Replay {
+            std::uint64_t seed = 0;
+            std::uint64_t endTick = 0;   // 경기가 끝난 틱 (끝 표시가 없으면 마지막 명령의 틱)
+            bool complete = false;       // 끝 표시까지 온전히 기록되었는지 여부
+            std::vector<ReplayEntry> entries;
+        };
+
+        /**
+         * @brief 명령을 이진 리플레이 파일로 기록합니다.
+         *
+         * 파일은 16바이트 헤더(매직 "DUNR", 버전, 경기 시드) 뒤에 명령이 이어집니다.
+         * 명령은 이전 명령과의 틱 차이, 종류, 건물 종류, 위치 4개를 가변 길이 정수로 담아 보통 7바이트입니다.
+         * 경기 도중 프로그램이 죽어도 그때까지의 명령은 남도록 명령마다 파일에 내보냅니다.
+         */
+        class ReplayWriter {
+        public:
+            ReplayWriter() = default;
+            ~ReplayWriter();
+
+            ReplayWriter(const ReplayWriter&) = delete;
+            ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+            /**
+             * @brief 파일을 만들고 헤더를 씁니다. 이미 열려 있으면 끝 표시 없이 먼저 닫습니다.
+             * @param path 리플레이 파일 경로.
+             * @param seed 경기 시드.
+             * @return false 파일을 열 수 없는 경우.
+             */
+            bool open(const std::string& path, std::uint64_t seed);
+
+            /**
+             * @brief 명령 하나를 기록합니다. 틱은 이전 기록보다 작으면 안 됩니다.
+             * @param tick 명령을 적용한 틱 (적용 후 step()이 진행할 틱).
+             * @param command 기록할 명령.
+             */
+            void record(std::uint64_t tick, const Command& command);
+
+            /**
+             * @brief 경기가 끝난 틱을 끝 표시로 쓰고 파일을 닫습니다.
+             * @param endTick 경기가 끝난 틱.
+             */
+            void close(std::uint64_t endTick);
+
+            bool isOpen() const { return file_.is_open(); }
+
+            /**
+             * @brief 지금까지 기록한 명령 수를 반환합니다.
+             */
+            std::size_t getCommandCount() const { return commandCount_; }
+
+        private:
+            std::ofstream file_;
+            std::vector<std::uint8_t> buffer_;  // 명령 하나를 인코딩하는 임시 버퍼
+            std::uint64_t lastTick_ = 0;
+            std::size_t commandCount_ = 0;
+        };
+
+        /**
+         * @brief 리플레이 파일을 읽습니다.
+         * 끝 표시 없이 잘린 파일은 마지막으로 온전한 명령까지 읽고 complete를 false로 둡니다.
+         * @param path 리플레이 파일 경로.
+         * @param replay 읽은 내용을 담을 객체.
+         * @return false 파일이 없거나 헤더나 명령이 손상된 경우.
+         */
+        bool loadReplay(const std::string& path, Replay& replay);
+
+        /**
+         * @brief 리플레이의 명령을 기록된 틱에 맞춰 다시 넣으며 끝 틱까지 대기 없이 진행합니다.
+         * 시뮬레이션은 리플레이와 같은 시드로 막 만든 상태여야 합니다.
+         * @param simulation 재생할 시뮬레이션.
+         * @param replay 재생할 리플레이.
+         */
+        void playReplay(Simulation& simulation, const Replay& replay);
+
+    } // namespace core
+} // namespace dune
@@ -3,6 +3,7 @@
 #include "../managers/terrain_manager.hpp"
 #include "../managers/building_manager.hpp"
 #include "../managers/unit_manager.hpp"
+#include <type_traits>
 #include <variant>
 
 namespace dune {
@@ -31,11 +32,13 @@ namespace dune {
             /**
              * @brief 선택된 객체를 반환하는 템플릿 함수입니다.
              * @tparam T 반환할 객체의 타입 (Unit, Building, Terrain).
-             * @return T* 선택된 객체의 포인터.
+             * @return T* 선택된 객체의 포인터. 지형은 선택 시점의 뷰를 가리킵니다.
              */
             template<typename T>
             const T* getSelected() const {
-                if (auto* ptr = std::get_if<const T*>(&selectedPtr_)) {
+                if constexpr (std::is_same_v<T, Terrain>) {
+                    return std::get_if<Terrain>(&selectedPtr_);
+                } else if (auto* ptr = std::get_if<const T*>(&selectedPtr_)) {
                     return *ptr;
                 }
                 return nullptr;
@@ -56,7 +59,8 @@ namespace dune {
         private:
             types::SelectionType type_ = types::SelectionType::None;
             types::Position position_ = { 0, 0 };
-            std::variant<std::monostate, const Terrain*, const Building*, const Unit*> selectedPtr_;
+            // 지형은 맵에 객체로 저장되지 않으므로 뷰를 값으로 보관합니다.
+            std::variant<std::monostate, Terrain, const Building*, const Unit*> selectedPtr_;
 
             friend class Game;
         };
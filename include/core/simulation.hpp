@@ -0,0 +1,213 @@
+#pragma once
+#include "command.hpp"
+#include "jobs.hpp"
+#include "map.hpp"
+#include "../entity/tactical_planner.hpp"
+#include "../utils/types.hpp"
+#include "../utils/constants.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        class ReplayWriter;
+
+        /**
+         * @brief 콘솔/입력과 분리된 고정 스텝 게임 시뮬레이션 코어입니다.
+         * 한 번의 step()은 constants::TICK 만큼의 게임 시간을 진행하며,
+         * 실제 시간 대기(sleep)나 Windows 콘솔 API에 의존하지 않습니다.
+         */
+        class Simulation {
+        public:
+            using Unit = managers::UnitManager::Unit;
+            using Building = managers::BuildingManager::Building;
+            using MessageHandler = Map::MessageHandler;
+
+            /**
+             * @brief checkpoint()가 잡아 둔 시점의 번호입니다. 상태는 맵의 변경 기록에 있고 핸들은 번호뿐이며,
+             * 되돌려도 시점이 남으므로 같은 핸들로 여러 번 되돌려 여러 미래를 시험할 수 있습니다.
+             */
+            using Checkpoint = Map::CheckpointId;
+
+            /**
+             * @brief Simulation 클래스의 생성자입니다. 초기 지형, 건물, 유닛을 배치합니다.
+             * @param messageHandler 시스템 메시지를 전달받을 콜백 (헤드리스 실행 시 생략).
+             * @param seed 경기 시드. 같은 시드와 같은 입력이면 같은 경기가 재현됩니다.
+             */
+            explicit Simulation(MessageHandler messageHandler = nullptr,
+                std::uint64_t seed = utils::RandomStreams::DEFAULT_SEED);
+
+            /**
+             * @brief 시뮬레이션을 한 틱(constants::TICK ms) 진행합니다.
+             * 틱 동안 발행된 게임 사건은 틱이 끝날 때 한 번에 구독자에게 전달됩니다.
+             */
+            void step();
+
+            /**
+             * @brief 지정한 틱 수만큼 대기 없이 시뮬레이션을 진행합니다.
+             * 깨어날 유닛이 없는 틱은 맵을 업데이트하지 않고 시간만 진행합니다.
+             * @param ticks 진행할 틱 수.
+             */
+            void run(std::uint64_t ticks);
+
+            /**
+             * @brief 플레이어 명령을 적용합니다. 게임 입력과 리플레이 재생이 모두 이 함수를 거칩니다.
+             * 기록기가 연결되어 있으면 적용 전에 현재 틱과 함께 기록합니다.
+             * 다음 step() 전에 호출해야 기록한 틱과 재생 시점이 일치합니다.
+             * @param command 적용할 명령.
+             * @return false 조건이 맞지 않아 아무것도 바뀌지 않은 경우 (이유는 시스템 메시지로 알립니다).
+             */
+            bool execute(const Command& command);
+
+            /**
+             * @brief 명령을 기록할 리플레이 기록기를 연결합니다. nullptr이면 기록하지 않습니다.
+             * @param recorder 기록기 (Simulation보다 오래 살아야 합니다).
+             */
+            void setRecorder(ReplayWriter* recorder) { recorder_ = recorder; }
+
+            /**
+             * @brief 한 진영의 전투 유닛을 지휘할 전술 계획기를 연결합니다. nullptr이면 끕니다. (기본 꺼짐)
+             * 계획기는 주기가 된 틱의 맵 업데이트 직전에 명령을 내립니다. 스냅샷과 체크포인트에는 저장하지 않습니다.
+             * @param planner 계획기.
+             */
+            void setTacticalPlanner(std::unique_ptr<entity::combat::TacticalPlanner> planner) { planner_ = std::move(planner); }
+            const entity::combat::TacticalPlanner* getTacticalPlanner() const { return planner_.get(); }
+
+            // 유닛 생성 (초기화 및 생산 명령에서 사용)
+            void addHarvester(const types::Position& pos, types::Camp camp);
+            void addSoldier(const types::Position& pos, types::Camp camp);
+            void addFremen(const types::Position& pos, types::Camp camp);
+            void addFighter(const types::Position& pos, types::Camp camp);
+            void addHeavyTank(const types::Position& pos, types::Camp camp);
+
+            /**
+             * @brief 시뮬레이션 작업 풀의 스레드 수를 바꿉니다. (만든 스레드 포함, 기본 1)
+             * 시뮬레이션 결과는 스레드 수와 관계없이 같습니다.
+             * @param threadCount 스레드 수 (0이면 1로 취급합니다).
+             */
+            void setThreadCount(std::size_t threadCount);
+
+            /**
+             * @brief 맵 계획 단계와 화면 구성이 함께 쓰는 작업 풀을 반환합니다.
+             */
+            JobSystem& getJobSystem() { return *jobs_; }
+
+            /**
+             * @brief 게임 사건 큐를 반환합니다. UI는 여기에 구독해 사건을 메시지로 표시합니다.
+             */
+            EventBus& getEvents() { return map_.getEvents(); }
+
+            // 접근자
+            Map& getMap() { return map_; }
+            const Map& getMap() const { return map_; }
+            types::Resource& getResource() { return resource_; }
+            const types::Resource& getResource() const { return resource_; }
+
+            /**
+             * @brief 현재 게임 시간을 반환합니다.
+             * @return std::chrono::milliseconds 시뮬레이션 시작 후 경과한 게임 시간.
+             */
+            std::chrono::milliseconds getCurrentTime() const { return currentTime_; }
+
+            /**
+             * @brief 지금까지 진행한 틱 수를 반환합니다.
+             * @return std::uint64_t 틱 수.
+             */
+            std::uint64_t getTickCount() const { return tickCount_; }
+
+            /**
+             * @brief 경기 시드를 반환합니다.
+             */
+            std::uint64_t getSeed() const { return map_.getSeed(); }
+
+            /**
+             * @brief 시뮬레이션 전체 상태를 스냅샷 구역에 기록합니다. step() 사이에 불러야 합니다.
+             * 파일로 저장하려면 saveSnapshot()을 사용합니다.
+             * @param sections 채울 구역.
+             */
+            void writeSnapshot(snapshot::Sections& sections) const;
+
+            /**
+             * @brief 스냅샷 구역으로 시뮬레이션을 되살립니다. 되살린 시뮬레이션은 저장 전과 같은 틱을 이어 갑니다.
+             * 리플레이 기록기와 작업 스레드 수는 저장하지 않으므로 필요하면 다시 설정합니다.
+             * @param view 읽을 구역.
+             * @param messageHandler 시스템 메시지를 전달받을 콜백.
+             * @return std::unique_ptr<Simulation> 되살린 시뮬레이션 (레코드가 손상되었으면 nullptr).
+             */
+            static std::unique_ptr<Simulation> restoreSnapshot(const snapshot::SectionView& view,
+                MessageHandler messageHandler = nullptr);
+
+            /**
+             * @brief 현재 시점을 잡아 둡니다. step() 사이에 불러야 합니다.
+             * 상태를 복사하지 않고 맵이 이후의 변경 전 값을 기록하기 시작할 뿐이므로 비용은 맵 크기와 무관합니다. (Map::checkpoint())
+             * 다 쓴 시점은 release()로 놓아야 변경 기록이 멈춥니다.
+             * @return Checkpoint restore()에 넘길 핸들.
+             */
+            Checkpoint checkpoint();
+
+            /**
+             * @brief checkpoint()로 잡은 시점으로 되돌립니다. 이어서 진행하면 그 시점부터 진행한 결과와 같습니다.
+             * 그 뒤에 바뀐 타일, 건물, 유닛만 되감으므로 비용은 그동안 바뀐 양에 비례합니다.
+             * 되돌린 시점은 남고, 그 뒤에 잡은 시점은 사라집니다.
+             * 왕복 결과가 되돌리지 않은 경기와 같은지와 되돌리는 시간은 bench/checkpoint_check.cpp가 확인합니다. (ctest)
+             * 리플레이 기록기는 되돌리지 않으므로 기록 중에는 쓰지 않습니다.
+             * @param checkpoint 이 시뮬레이션에서 잡은 핸들.
+             * @return false 잡혀 있지 않은 핸들인 경우 (놓았거나 더 이른 시점으로 되돌려 사라졌으면).
+             */
+            bool restore(Checkpoint checkpoint);
+
+            /**
+             * @brief 잡은 시점을 놓습니다. 남은 시점이 없으면 맵의 변경 기록이 멈춥니다.
+             * @param checkpoint 놓을 핸들.
+             */
+            void release(Checkpoint checkpoint);
+
+        private:
+            struct EmptyTag {};
+
+            /**
+             * @brief 초기 배치 없이 빈 맵으로 만듭니다. (restoreSnapshot() 전용)
+             */
+            Simulation(MessageHandler messageHandler, EmptyTag);
+
+            void initResources();
+            void initTerrain();
+            void initBuildings();
+            void initSandworms();
+            void initHarvesters();
+
+            /**
+             * @brief 플레이어 하베스터가 배달한 스파이스를 창고 용량까지 적립합니다. (EventBus 구독자)
+             */
+            void onSpiceDelivered(const GameEvent& event);
+
+            // 명령 종류별 처리 (execute에서 호출)
+            bool placePlate(const types::Position& position);
+            bool placeBuilding(types::BuildingType kind, const types::Position& position);
+            bool produceUnit(const types::Position& buildingPosition, const types::Position& position);
+            bool commandUnit(const Command& command);
+
+            std::unique_ptr<JobSystem> jobs_;  // 맵이 참조하므로 맵보다 먼저 만들고 나중에 해제합니다.
+            Map map_;
+            types::Resource resource_;
+            std::chrono::milliseconds currentTime_;
+            std::uint64_t tickCount_;
+            ReplayWriter* recorder_ = nullptr;
+            std::unique_ptr<entity::combat::TacticalPlanner> planner_;
+
+            // 잡은 시점마다 맵 밖의 상태 (맵 상태는 Map이 기록합니다)
+            struct SavedClock {
+                Checkpoint checkpoint;
+                std::chrono::milliseconds currentTime;
+                std::uint64_t tickCount;
+                types::Resource resource;
+            };
+            std::vector<SavedClock> checkpoints_;
+        };
+
+    } // namespace core
+} // namespace dune
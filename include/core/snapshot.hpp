@@ -0,0 +1,32 @@
+#pragma once
+#include "simulation.hpp"
+#include "snapshot_format.hpp"
+#include <memory>
+#include <string>
+
+namespace dune {
+    namespace core {
+
+        /**
+         * @brief 시뮬레이션 전체 상태를 스냅샷 파일로 저장합니다. step() 사이에 불러야 합니다.
+         *
+         * 파일은 snapshot_format.hpp의 고정 레이아웃이며, 지형/건물/유닛 구역이 평평한 배열이라
+         * loadSnapshot()은 파일을 메모리에 매핑한 뒤 레코드를 그대로 읽어 맵을 다시 채웁니다.
+         * @param simulation 저장할 시뮬레이션.
+         * @param path 스냅샷 파일 경로.
+         * @return false 파일을 쓸 수 없는 경우.
+         */
+        bool saveSnapshot(const Simulation& simulation, const std::string& path);
+
+        /**
+         * @brief 스냅샷 파일을 읽어 시뮬레이션을 되살립니다.
+         * 되살린 시뮬레이션을 진행하면 저장하지 않고 계속 진행한 경기와 같은 결과가 나옵니다.
+         * @param path 스냅샷 파일 경로.
+         * @param messageHandler 시스템 메시지를 전달받을 콜백.
+         * @return std::unique_ptr<Simulation> 되살린 시뮬레이션 (파일이 없거나 버전이 다르거나 손상되었으면 nullptr).
+         */
+        std::unique_ptr<Simulation> loadSnapshot(const std::string& path,
+            Simulation::MessageHandler messageHandler = nullptr);
+
+    } // namespace core
+} // namespace dune
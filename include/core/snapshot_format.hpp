@@ -0,0 +1,252 @@
+#pragma once
+#include "../utils/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace dune {
+    namespace entity { class Unit; }
+}
+
+namespace dune {
+    namespace core {
+        namespace snapshot {
+
+            /**
+             * @brief 스냅샷 파일의 고정 레이아웃입니다.
+             *
+             * 파일은 헤더, 구역 목차, 구역 본문 순서이며 모든 구역은 8바이트 경계에서 시작합니다.
+             * 구역 본문은 아래 레코드의 평평한 배열이라, 파일을 메모리에 매핑한 뒤 포인터만 맞춰 바로 읽습니다.
+             * 레코드는 리틀 엔디언 고정 크기 정수만 담고, 레이아웃이 바뀌면 VERSION을 올립니다.
+             */
+            inline constexpr char MAGIC[4] = { 'D', 'U', 'N', 'S' };
+            inline constexpr std::uint16_t VERSION = 4;
+            inline constexpr std::size_t ALIGNMENT = 8;
+
+            // 가리키는 유닛이 없거나 이미 맵에서 사라진 경우의 유닛 번호
+            inline constexpr std::uint32_t NO_UNIT = std::numeric_limits<std::uint32_t>::max();
+            inline constexpr std::uint64_t NO_TICK = std::numeric_limits<std::uint64_t>::max();
+
+            enum class SectionId : std::uint32_t {
+                Simulation = 1,  // SimulationRecord 1개
+                Terrain,         // 타일당 1바이트 지형 타입 (행 우선)
+                Buildings,       // BuildingRecord 배열
+                Units,           // UnitRecord 배열 (칸 번호 순서)
+                Positions,       // 경로/경유지/캐시 경로가 공유하는 PositionRecord 배열
+                PathCache,       // PathCacheRecord 배열 (캐시 저장 순서)
+                GroupMoves       // GroupMoveRecord 배열 (명령 순서)
+            };
+
+            struct FileHeader {
+                char magic[4];
+                std::uint16_t version;
+                std::uint16_t sectionCount;
+                std::int32_t width;
+                std::int32_t height;
+                std::uint64_t fileSize;
+            };
+
+            struct SectionEntry {
+                SectionId id;
+                std::uint32_t recordSize;   // 읽는 쪽이 레이아웃을 확인할 수 있도록 레코드 크기를 함께 둡니다.
+                std::uint64_t offset;       // 파일 시작부터의 바이트 위치
+                std::uint64_t count;        // 레코드 수
+            };
+
+            struct PositionRecord {
+                std::int32_t row;
+                std::int32_t column;
+            };
+
+            struct SimulationRecord {
+                std::uint64_t seed;
+                std::uint64_t tickCount;
+                std::int64_t currentTime;       // ms
+                std::uint64_t schedulerNow;     // 깨우기 스케줄러가 아직 처리하지 않은 첫 틱
+                std::int32_t spice;
+                std::int32_t spiceMax;
+                std::int32_t population;
+                std::int32_t populationMax;
+                std::uint64_t random[2][4];     // 용도별 난수 생성기 상태 (utils::RandomStream 순서)
+                std::uint64_t pathCacheClock;   // 경로 캐시의 마지막 사용 순번
+                std::uint32_t unitIdCount;      // 지금까지 부여한 유닛 번호 수
+                std::uint32_t reserved;
+            };
+
+            struct BuildingRecord {
+                std::uint8_t kind;      // types::BuildingType
+                std::uint8_t camp;      // types::Camp
+                std::uint16_t reserved;
+                std::int32_t health;
+                PositionRecord position;
+            };
+
+            enum class AiKind : std::uint8_t {
+                None,
+                Sandworm,
+                Harvester,
+                Combat
+            };
+
+            /**
+             * @brief 유닛 AI와 현재 상태의 기록입니다. 상태마다 쓰는 칸만 의미가 있고 나머지는 0입니다.
+             */
+            struct AiRecord {
+                AiKind kind;
+                std::uint8_t state;             // 종류별 StateKind
+                std::uint8_t moveMode;          // 전투 이동 상태의 MoveMode
+                std::uint8_t commandType;       // 하베스터 명령 종류
+                std::int32_t spiceAmount;       // 하베스터 적재량
+                std::int32_t blockedMoves;      // 전투 이동 상태의 연속 막힘 횟수
+                std::uint32_t targetUnit;       // 전투 AI의 현재 타겟
+                std::uint32_t stateTargetUnit;  // 공격/추적 상태의 타겟
+                std::uint32_t reserved;
+                PositionRecord basePosition;    // 하베스터 본진
+                PositionRecord targetPosition;  // 하베스터 목표 / 전투 AI 이동 목표
+                PositionRecord commandPosition; // 하베스터 명령 목표
+                PositionRecord stateTarget;     // 상태의 목표 위치 (이동/수확 지점/굴파기/순찰 현재 목표)
+                PositionRecord patrolFrom;
+                PositionRecord patrolTo;
+                std::int64_t commandTime;       // 하베스터 명령 시각
+                std::int64_t stateTime;         // 상태의 시각 (시작/마지막 경로 갱신/마지막 공격)
+                std::int64_t lastAttackTime;    // 전투 AI의 마지막 공격 시각
+                std::uint32_t pathOffset;       // Positions 구역에서 경로가 시작하는 위치
+                std::uint32_t pathCount;
+                std::uint32_t waypointOffset;
+                std::uint32_t waypointCount;
+            };
+
+            struct UnitRecord {
+                std::uint32_t id;
+                std::uint8_t type;      // types::UnitType
+                std::uint8_t camp;      // types::Camp
+                std::uint16_t reserved;
+                std::int32_t buildCost;
+                std::int32_t population;
+                std::int32_t speed;
+                std::int32_t attackPower;
+                std::int32_t health;
+                std::int32_t sightRange;
+                std::int32_t length;
+                PositionRecord position;
+                std::uint32_t reserved2;
+                std::int64_t lastMoveTime;  // ms
+                std::uint64_t wakeTick;     // 예약된 깨우기 틱 (없으면 NO_TICK)
+                AiRecord ai;
+            };
+
+            /**
+             * @brief 경로 캐시 항목입니다. 캐시를 다시 채우면 재사용 여부가 달라져 경기가 갈라지므로 함께 저장합니다.
+             */
+            struct PathCacheRecord {
+                std::int32_t region;
+                std::uint8_t movementClass;     // pathfinding::MovementClass
+                std::uint8_t reserved[3];
+                PositionRecord goal;
+                PositionRecord start;
+                std::uint64_t lastUsed;
+                std::uint32_t pathOffset;
+                std::uint32_t pathCount;
+            };
+
+            /**
+             * @brief 무리 이동으로 묶을 수 있는 최근 이동 명령입니다. (Map::orderMove())
+             */
+            struct GroupMoveRecord {
+                std::uint32_t unitId;
+                std::uint32_t reserved;
+                PositionRecord goal;
+                std::uint64_t tick;
+            };
+
+            // 매핑한 메모리를 그대로 읽으려면 레코드가 단순 복사 가능하고 크기가 고정이어야 합니다.
+            static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) == 24);
+            static_assert(std::is_trivially_copyable_v<SectionEntry> && sizeof(SectionEntry) == 24);
+            static_assert(std::is_trivially_copyable_v<SimulationRecord> && sizeof(SimulationRecord) == 128);
+            static_assert(std::is_trivially_copyable_v<BuildingRecord> && sizeof(BuildingRecord) == 16);
+            static_assert(std::is_trivially_copyable_v<AiRecord> && sizeof(AiRecord) == 112);
+            static_assert(std::is_trivially_copyable_v<UnitRecord> && sizeof(UnitRecord) == 176);
+            static_assert(std::is_trivially_copyable_v<PathCacheRecord> && sizeof(PathCacheRecord) == 40);
+            static_assert(std::is_trivially_copyable_v<GroupMoveRecord> && sizeof(GroupMoveRecord) == 24);
+
+            /**
+             * @brief 저장할 때 채우는 구역별 레코드입니다.
+             */
+            struct Sections {
+                SimulationRecord simulation{};
+                std::vector<std::uint8_t> terrain;
+                std::vector<BuildingRecord> buildings;
+                std::vector<UnitRecord> units;
+                std::vector<PositionRecord> positions;
+                std::vector<PathCacheRecord> pathCache;
+                std::vector<GroupMoveRecord> groupMoves;
+            };
+
+            /**
+             * @brief 읽을 때 쓰는 구역별 뷰입니다. 매핑한 파일을 그대로 가리키므로 복사가 없습니다.
+             * 크기와 구역 경계는 파일을 연 쪽이 확인하고, 레코드 값의 범위는 복원하는 쪽이 확인합니다.
+             */
+            struct SectionView {
+                const SimulationRecord* simulation = nullptr;
+                std::span<const std::uint8_t> terrain;
+                std::span<const BuildingRecord> buildings;
+                std::span<const UnitRecord> units;
+                std::span<const PositionRecord> positions;
+                std::span<const PathCacheRecord> pathCache;
+                std::span<const GroupMoveRecord> groupMoves;
+            };
+
+            /**
+             * @brief 저장할 때 AI가 가리키는 유닛의 주소를 고유 번호로 바꾸는 함수입니다.
+             * 유닛이 해제되기 전에 그 유닛을 가리키던 AI는 타겟을 놓으므로(Map::update()) 주소는 항상 살아 있습니다.
+             * 맵에서 사라진 유닛이면 NO_UNIT을 반환합니다.
+             */
+            using UnitIds = std::function<std::uint32_t(const entity::Unit*)>;
+
+            inline std::uint32_t findUnitId(const UnitIds& ids, const entity::Unit* unit) {
+                return unit ? ids(unit) : NO_UNIT;
+            }
+
+            inline PositionRecord toRecord(const types::Position& position) {
+                return { position.row, position.column };
+            }
+
+            inline types::Position toPosition(const PositionRecord& record) {
+                return { record.row, record.column };
+            }
+
+            /**
+             * @brief 경로를 공유 위치 배열 끝에 붙이고 시작 위치와 길이를 기록합니다.
+             */
+            inline void appendPath(std::vector<PositionRecord>& positions, const std::vector<types::Position>& path,
+                std::uint32_t& offset, std::uint32_t& count) {
+                offset = static_cast<std::uint32_t>(positions.size());
+                count = static_cast<std::uint32_t>(path.size());
+                for (const auto& position : path) {
+                    positions.push_back(toRecord(position));
+                }
+            }
+
+            /**
+             * @brief 공유 위치 배열에서 경로를 읽습니다. 범위를 벗어나면 false를 반환하고 path는 비웁니다.
+             */
+            inline bool readPath(std::span<const PositionRecord> positions, std::uint32_t offset, std::uint32_t count,
+                std::vector<types::Position>& path) {
+                path.clear();
+                if (offset > positions.size() || count > positions.size() - offset) {
+                    return false;
+                }
+                path.reserve(count);
+                for (const auto& record : positions.subspan(offset, count)) {
+                    path.push_back(toPosition(record));
+                }
+                return true;
+            }
+
+        } // namespace snapshot
+    } // namespace core
+} // namespace dune
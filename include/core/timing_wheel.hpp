@@ -0,0 +1,228 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        /**
+         * @brief 예약된 항목을 만기 틱에 꺼내 주는 계층형 타이밍 휠입니다.
+         *
+         * 단계마다 64칸을 두고, 가까운 만기는 아래 단계에, 먼 만기는 위 단계에 넣은 뒤
+         * 시간이 흐르면 아래 단계로 내려보냅니다. 예약/취소 없는 꺼내기가 모두 상수 시간이며,
+         * 비어 있는 구간은 칸 점유 비트로 한 번에 건너뜁니다.
+         * 예약을 취소하는 기능은 없으므로 호출자가 꺼낸 항목이 아직 유효한지 확인해야 합니다.
+         * @tparam T 예약할 항목 타입 (복사가 가벼운 값 타입).
+         */
+        template<typename T>
+        class TimingWheel {
+        public:
+            static constexpr std::uint64_t NO_TICK = std::numeric_limits<std::uint64_t>::max();
+
+            /**
+             * @brief 아직 처리하지 않은 가장 이른 틱을 반환합니다.
+             * 이보다 이른 틱으로 예약한 항목은 이 틱에 처리됩니다.
+             */
+            std::uint64_t now() const { return now_; }
+
+            /**
+             * @brief 예약을 모두 버리고 now()를 tick으로 옮깁니다. (스냅샷 복원용)
+             * @param tick 새 현재 틱.
+             */
+            void reset(std::uint64_t tick) {
+                for (auto& level : slots_) {
+                    for (auto& slot : level) {
+                        slot.clear();
+                    }
+                }
+                occupied_.fill(0);
+                overflow_.clear();
+                size_ = 0;
+                now_ = tick;
+            }
+
+            /**
+             * @brief 예약을 그대로 둔 채 now()를 이전 틱으로 되돌립니다. (체크포인트 복원용)
+             * 남은 항목은 모두 tick 이후 만기이므로 버리지 않고, 지나온 시간 동안 아래 단계로 내려와
+             * 새 현재 틱 기준으로 자리가 맞지 않게 된 단계만 다시 넣습니다. (되돌린 시간이 짧으면 0단계만)
+             * @param tick 새 현재 틱 (now() 이하).
+             */
+            void rewind(std::uint64_t tick) {
+                const std::uint64_t previous = now_;
+                now_ = tick;
+                // 한 단계의 항목은 모두 이전 현재 틱과 그 단계 위 자릿수가 같습니다. 새 현재 틱과 그 자릿수가 다르면
+                // 모두 위 단계로 올라가야 하고, 같으면 칸 번호가 새 현재 틱보다 앞이라 그대로 맞습니다.
+                // 올라간 항목이 다시 옮겨지지 않도록 위 단계부터 고칩니다. (overflow_는 그대로 overflow_입니다)
+                for (int level = LEVELS - 1; level >= 0; --level) {
+                    const int shift = (level + 1) * LEVEL_BITS;
+                    if ((previous >> shift) == (tick >> shift)) continue;
+                    for (unsigned index = 0; index < 64; ++index) {
+                        replaceSlot(level, index);
+                    }
+                }
+            }
+
+            /**
+             * @brief 예약된 항목 수를 반환합니다. (이미 무효가 된 항목 포함)
+             */
+            std::size_t size() const { return size_; }
+
+            /**
+             * @brief 항목을 tick에 꺼내지도록 예약합니다.
+             * @param tick 만기 틱 (now()보다 이르면 now()로 당겨집니다).
+             * @param item 예약할 항목.
+             */
+            void schedule(std::uint64_t tick, const T& item) {
+                place({ tick < now_ ? now_ : tick, item });
+                ++size_;
+            }
+
+            /**
+             * @brief target 틱까지 시간을 진행하며 만기가 된 항목을 만기 순서대로 전달합니다.
+             * 콜백 안에서 예약한 항목은 빨라도 다음 틱에 처리됩니다.
+             * @param target 처리할 마지막 틱.
+             * @param onDue 만기 항목을 받을 콜백 (item, 만기 틱).
+             */
+            template<typename Callback>
+            void advance(std::uint64_t target, Callback&& onDue) {
+                while (now_ <= target) {
+                    const std::uint64_t tick = now_;
+                    const unsigned index = static_cast<unsigned>(tick & SLOT_MASK);
+                    if (occupied_[0] & (std::uint64_t{ 1 } << index)) {
+                        // 콜백이 같은 칸에 다시 예약할 수 있으므로 먼저 꺼내고 시간을 진행합니다.
+                        dueBuffer_.swap(slots_[0][index]);
+                        occupied_[0] &= ~(std::uint64_t{ 1 } << index);
+                        size_ -= dueBuffer_.size();
+                        moveTo(tick + 1);
+                        for (const auto& entry : dueBuffer_) {
+                            onDue(entry.item, entry.tick);
+                        }
+                        dueBuffer_.clear();
+                        continue;
+                    }
+                    moveTo(std::min(nextInterestingTick(), target + 1));
+                }
+            }
+
+            /**
+             * @brief 가장 이른 만기 틱을 반환합니다.
+             * @return std::uint64_t 만기 틱 (예약된 항목이 없으면 NO_TICK).
+             */
+            std::uint64_t nextDueTick() const {
+                if (size_ == 0) return NO_TICK;
+                for (int level = 0; level < LEVELS; ++level) {
+                    if (occupied_[level] == 0) continue;
+                    // 아래 단계의 항목은 모두 위 단계 항목보다 만기가 이릅니다.
+                    const unsigned index = static_cast<unsigned>(std::countr_zero(occupied_[level]));
+                    std::uint64_t earliest = NO_TICK;
+                    for (const auto& entry : slots_[level][index]) {
+                        earliest = std::min(earliest, entry.tick);
+                    }
+                    return earliest;
+                }
+                std::uint64_t earliest = NO_TICK;
+                for (const auto& entry : overflow_) {
+                    earliest = std::min(earliest, entry.tick);
+                }
+                return earliest;
+            }
+
+        private:
+            static constexpr int LEVEL_BITS = 6;
+            static constexpr int LEVELS = 4;  // 64^4 틱 이후 만기는 overflow_에 둡니다.
+            static constexpr std::uint64_t SLOT_MASK = (std::uint64_t{ 1 } << LEVEL_BITS) - 1;
+
+            struct Entry {
+                std::uint64_t tick;
+                T item;
+            };
+
+            /**
+             * @brief 만기와 현재 틱이 처음 달라지는 자릿수 단계에 항목을 넣습니다.
+             * 각 단계의 칸 번호는 now_ 기준으로 항상 앞쪽(만기 쪽)에 있습니다.
+             */
+            void place(const Entry& entry) {
+                const std::uint64_t diff = entry.tick ^ now_;
+                const int level = diff == 0 ? 0 : (63 - std::countl_zero(diff)) / LEVEL_BITS;
+                if (level >= LEVELS) {
+                    overflow_.push_back(entry);
+                    return;
+                }
+                const unsigned index = static_cast<unsigned>((entry.tick >> (level * LEVEL_BITS)) & SLOT_MASK);
+                slots_[level][index].push_back(entry);
+                occupied_[level] |= std::uint64_t{ 1 } << index;
+            }
+
+            /**
+             * @brief 항목이 생길 수 있는 다음 틱을 구합니다.
+             * 0단계에 항목이 있으면 그 칸, 없으면 비어 있는 단계들을 건너뛴 다음 경계입니다.
+             */
+            std::uint64_t nextInterestingTick() const {
+                if (occupied_[0] != 0) {
+                    const unsigned index = static_cast<unsigned>(now_ & SLOT_MASK);
+                    const std::uint64_t ahead = occupied_[0] >> index;
+                    return now_ + static_cast<std::uint64_t>(std::countr_zero(ahead));
+                }
+                int level = 1;
+                while (level < LEVELS && occupied_[level] == 0) {
+                    ++level;
+                }
+                const std::uint64_t span = std::uint64_t{ 1 } << (level * LEVEL_BITS);
+                return (now_ | (span - 1)) + 1;
+            }
+
+            /**
+             * @brief now_를 tick으로 옮기고 지나친 단계 경계의 칸을 아래 단계로 내립니다.
+             * tick까지의 사이에는 만기 항목이 없어야 합니다.
+             */
+            void moveTo(std::uint64_t tick) {
+                const std::uint64_t previous = now_;
+                now_ = tick;
+                // 위 단계부터 내려야 내려온 항목이 아래 단계의 올바른 칸에 다시 들어갑니다.
+                for (int level = LEVELS; level >= 1; --level) {
+                    const int shift = level * LEVEL_BITS;
+                    if ((previous >> shift) == (tick >> shift)) continue;
+                    if (level == LEVELS) {
+                        cascade(overflow_);
+                        continue;
+                    }
+                    const unsigned index = static_cast<unsigned>((tick >> shift) & SLOT_MASK);
+                    if (occupied_[level] & (std::uint64_t{ 1 } << index)) {
+                        occupied_[level] &= ~(std::uint64_t{ 1 } << index);
+                        cascade(slots_[level][index]);
+                    }
+                }
+            }
+
+            void replaceSlot(int level, unsigned index) {
+                const std::uint64_t bit = std::uint64_t{ 1 } << index;
+                if (occupied_[level] & bit) {
+                    occupied_[level] &= ~bit;
+                    cascade(slots_[level][index]);
+                }
+            }
+
+            void cascade(std::vector<Entry>& bucket) {
+                cascadeBuffer_.swap(bucket);
+                for (const auto& entry : cascadeBuffer_) {
+                    place(entry);
+                }
+                cascadeBuffer_.clear();
+            }
+
+            std::uint64_t now_ = 0;
+            std::size_t size_ = 0;
+            std::array<std::array<std::vector<Entry>, 64>, LEVELS> slots_;
+            std::array<std::uint64_t, LEVELS> occupied_{};  // 단계별 비어 있지 않은 칸 비트
+            std::vector<Entry> overflow_;
+            std::vector<Entry> dueBuffer_;
+            std::vector<Entry> cascadeBuffer_;
+        };
+
+    } // namespace core
+} // namespace dune
@@ -0,0 +1,128 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        /**
+         * @brief 타임라인에 남기는 사건 하나입니다. 이름과 인자 이름은 파일로 쓸 때 붙입니다.
+         */
+        struct TraceEvent {
+            enum class Kind : std::uint8_t {
+                Zone,           // 구간 시작~끝 (Chrome "X" 사건)
+                StateChange     // AI 상태 전환 (Chrome "i" 사건)
+            };
+
+            static constexpr std::size_t MAX_ARGS = 6;
+
+            std::int64_t start;                         // 기록 시작 후 경과 시간 (ns)
+            std::int64_t duration;                      // 구간 길이 (ns, 상태 전환은 0)
+            std::uint16_t zone;                         // Zone: 프로파일 구간, StateChange: 이전 상태의 유닛 구간
+            std::uint16_t target;                       // StateChange: 새 상태의 유닛 구간
+            Kind kind;
+            std::uint8_t argCount;
+            std::array<std::int32_t, MAX_ARGS> args;    // 구간마다 정해진 순서의 정수 인자
+        };
+
+        /**
+         * @brief 틱 단계, 경로 탐색, AI 상태 전환, 화면 출력을 타임라인으로 기록해
+         * Chrome Trace Event(JSON) 형식으로 쓰는 기록기입니다. Perfetto나 chrome://tracing에서 열 수 있습니다.
+         *
+         * 사건은 스레드마다 따로 둔 버퍼에 잠금 없이 쌓고, stop()에서 모든 버퍼를 한 파일로 씁니다.
+         * 구간 사건은 ProfileScope가 고정 구간(ProfileZone)에 대해 남기므로 Profiler와 같은 자리를 재며,
+         * 유닛 하나하나의 업데이트는 양이 많아 남기지 않습니다. 꺼져 있으면 원자 변수 하나만 읽습니다.
+         */
+        class TraceRecorder {
+        public:
+            static constexpr std::size_t DEFAULT_MAX_EVENTS_PER_THREAD = std::size_t{ 1 } << 20;
+
+            /**
+             * @brief 프로세스 전체가 공유하는 기록기를 반환합니다.
+             */
+            static TraceRecorder& instance();
+
+            /**
+             * @brief 기록 중이면 멈추고 파일을 씁니다.
+             */
+            ~TraceRecorder();
+
+            TraceRecorder(const TraceRecorder&) = delete;
+            TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+            /**
+             * @brief 기록을 시작합니다. 이미 기록 중이면 먼저 멈추고 씁니다. 틱 사이에 불러야 합니다.
+             * @param path stop()에서 쓸 JSON 파일 경로.
+             * @param maxEventsPerThread 스레드 하나가 쌓을 최대 사건 수 (넘는 사건은 버리고 셉니다).
+             */
+            void start(const std::string& path, std::size_t maxEventsPerThread = DEFAULT_MAX_EVENTS_PER_THREAD);
+
+            /**
+             * @brief 기록을 멈추고 쌓인 사건을 파일로 씁니다. 틱 사이에 불러야 합니다.
+             * @return false 기록 중이 아니었거나 파일을 쓸 수 없는 경우.
+             */
+            bool stop();
+
+            bool isRecording() const { return recording_.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief 구간 사건을 지금 스레드의 버퍼에 넣습니다. 보통은 ProfileScope가 부릅니다.
+             * @param zone 고정 구간 번호.
+             * @param begin 구간 시작 시각.
+             * @param end 구간 끝 시각.
+             * @param args 구간의 정수 인자 (개수는 구간마다 정해져 있습니다).
+             * @param argCount 인자 수.
+             */
+            void recordZone(std::size_t zone, std::chrono::steady_clock::time_point begin,
+                std::chrono::steady_clock::time_point end, const std::int32_t* args, std::size_t argCount);
+
+            /**
+             * @brief AI 상태 전환을 지금 스레드의 버퍼에 넣습니다.
+             * @param from 이전 상태의 유닛 구간 번호. (Profiler::unitZone())
+             * @param to 새 상태의 유닛 구간 번호.
+             * @param unitId 유닛 고유 번호 (모르면 -1).
+             */
+            void recordStateChange(std::size_t from, std::size_t to, std::int32_t unitId);
+
+            /**
+             * @brief 버퍼가 가득 차 버려진 사건 수를 반환합니다.
+             */
+            std::uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief 쌓인 사건을 Chrome Trace Event JSON으로 씁니다. 틱 사이에 불러야 합니다.
+             */
+            void write(std::ostream& out) const;
+
+        private:
+            TraceRecorder() = default;
+
+            // 스레드 하나가 쌓는 사건 (그 스레드만 씁니다)
+            struct ThreadBuffer {
+                std::vector<TraceEvent> events;
+            };
+
+            void push(const TraceEvent& event);
+            std::int64_t sinceStart(std::chrono::steady_clock::time_point time) const {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(time - start_).count();
+            }
+
+            std::atomic<bool> recording_{ false };
+            std::atomic<std::uint64_t> dropped_{ 0 };
+            std::mutex threadsMutex_;
+            std::vector<std::unique_ptr<ThreadBuffer>> threads_;  // 등록 순서가 JSON의 tid입니다.
+            std::chrono::steady_clock::time_point start_;
+            std::size_t maxEventsPerThread_ = DEFAULT_MAX_EVENTS_PER_THREAD;
+            std::string path_;
+        };
+
+    } // namespace core
+} // namespace dune
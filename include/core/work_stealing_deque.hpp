@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace dune {
+    namespace core {
+
+        /**
+         * @brief 고정 크기 Chase-Lev 작업 훔치기 덱입니다.
+         *
+         * 소유 스레드만 push()/pop()으로 아래쪽(bottom)을 쓰고, 다른 스레드는 steal()로 위쪽(top)에서 가져갑니다.
+         * 소유자는 최근에 넣은 작업부터 꺼내 캐시를 재사용하고, 훔치는 쪽은 가장 오래된(보통 가장 큰) 작업을 가져갑니다.
+         * 메모리 순서는 Lê 외(2013)의 C11 구현을 따릅니다.
+         * @tparam T 저장할 항목 타입 (포인터처럼 원자적으로 복사할 수 있는 타입).
+         */
+        template<typename T>
+        class WorkStealingDeque {
+        public:
+            /**
+             * @brief WorkStealingDeque 클래스의 생성자입니다.
+             * @param capacity 최대 항목 수 (2의 거듭제곱으로 올림합니다).
+             */
+            explicit WorkStealingDeque(std::size_t capacity = 1024) {
+                std::size_t size = 1;
+                while (size < capacity) size <<= 1;
+                mask_ = static_cast<std::int64_t>(size) - 1;
+                buffer_ = std::make_unique<std::atomic<T>[]>(size);
+            }
+
+            WorkStealingDeque(const WorkStealingDeque&) = delete;
+            WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+            /**
+             * @brief 항목을 아래쪽에 넣습니다. (소유 스레드 전용)
+             * @return false 덱이 가득 찬 경우 (호출자가 직접 처리해야 합니다).
+             */
+            bool push(T item) {
+                const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+                const std::int64_t top = top_.load(std::memory_order_acquire);
+                if (bottom - top > mask_) {
+                    return false;
+                }
+                buffer_[bottom & mask_].store(item, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return true;
+            }
+
+            /**
+             * @brief 가장 최근에 넣은 항목을 꺼냅니다. (소유 스레드 전용)
+             * @return true 항목을 꺼낸 경우.
+             */
+            bool pop(T& item) {
+                const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+                bottom_.store(bottom, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                std::int64_t top = top_.load(std::memory_order_relaxed);
+
+                if (top > bottom) {
+                    // 비어 있음
+                    bottom_.store(bottom + 1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                item = buffer_[bottom & mask_].load(std::memory_order_relaxed);
+                if (top == bottom) {
+                    // 마지막 항목은 훔치는 쪽과 경쟁합니다.
+                    const bool won = top_.compare_exchange_strong(top, top + 1,
+                        std::memory_order_seq_cst, std::memory_order_relaxed);
+                    bottom_.store(bottom + 1, std::memory_order_relaxed);
+                    return won;
+                }
+                return true;
+            }
+
+            /**
+             * @brief 가장 오래된 항목을 가져갑니다. (다른 스레드에서 호출)
+             * @return true 항목을 가져간 경우. 다른 스레드와 경쟁에서 지면 false입니다.
+             */
+            bool steal(T& item) {
+                std::int64_t top = top_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+                if (top >= bottom) {
+                    return false;
+                }
+
+                item = buffer_[top & mask_].load(std::memory_order_relaxed);
+                return top_.compare_exchange_strong(top, top + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 대략적인 항목 수를 반환합니다. (다른 스레드가 동시에 바꿀 수 있습니다)
+             */
+            std::size_t sizeHint() const {
+                const std::int64_t size = bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+                return size > 0 ? static_cast<std::size_t>(size) : 0;
+            }
+
+        private:
+            // 소유자와 훔치는 쪽이 서로 다른 캐시 줄을 쓰도록 떨어뜨립니다.
+            alignas(64) std::atomic<std::int64_t> top_{ 0 };
+            alignas(64) std::atomic<std::int64_t> bottom_{ 0 };
+            std::unique_ptr<std::atomic<T>[]> buffer_;
+            std::int64_t mask_ = 0;
+        };
+
+    } // namespace core
+} // namespace dune
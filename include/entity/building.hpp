@@ -1,6 +1,8 @@
 #pragma once
 #include "../core/entity.hpp"
 #include "../utils/types.hpp"
+#include "../utils/constants.hpp"
+#include "building_descriptor.hpp"
 #include "managers/terrain_manager.hpp"
 #include <memory>
 #include <vector>
@@ -14,20 +16,14 @@ namespace dune {
         class Building : public core::Entity {
         public:
             /**
-             * @brief Building 클래스의 생성자입니다.
+             * @brief Building 클래스의 생성자입니다. 이름, 크기, 생산 유닛은 건물 종류의 정보 표에서 가져옵니다.
+             * @param kind 건물 종류.
              * @param type 건물의 진영 타입.
-             * @param name 건물의 이름.
-             * @param description 건물의 설명.
-             * @param buildCost 건설 비용.
              * @param position 건물의 위치.
-             * @param width 건물의 가로 크기.
-             * @param height 건물의 세로 크기.
-             * @param health 건물의 체력.
-             * @param producedUnit 생산 가능한 유닛 타입.
+             * @param health 체력 (스냅샷에서 되살릴 때 저장된 값을 넘깁니다).
              */
-            Building(types::Camp type, const std::wstring& name, const std::wstring& description,
-                int buildCost, types::Position position, int width, int height, int health,
-                types::UnitType producedUnit);
+            Building(types::BuildingType kind, types::Camp type, types::Position position,
+                int health = constants::DEFAULT_HEALTH);
 
             // Entity 인터페이스 구현
             wchar_t getRepresentation() const override;
@@ -52,29 +48,41 @@ namespace dune {
              */
             types::Camp getType() const { return type_; }
 
+            /**
+             * @brief 건물 종류를 반환합니다.
+             * @return types::BuildingType 건물 종류.
+             */
+            types::BuildingType getKind() const { return descriptor_->type; }
+
+            /**
+             * @brief 건물 종류의 고정 정보를 반환합니다.
+             * @return const BuildingDescriptor& 건물 정보.
+             */
+            const BuildingDescriptor& getDescriptor() const { return *descriptor_; }
+
             /**
              * @brief 건물의 이름을 반환합니다.
-             * @return const std::wstring& 건물의 이름.
+             * @return const wchar_t* 건물의 이름.
              */
-            const std::wstring& getName() const { return name_; }
+            const wchar_t* getName() const { return descriptor_->name; }
 
             /**
              * @brief 건물의 설명을 반환합니다.
-             * @return const std::wstring& 건물의 설명.
+             * @return const wchar_t* 건물의 설명.
              */
-            const std::wstring& getDescription() const { return description_; }
+            const wchar_t* getDescription() const { return descriptor_->description; }
 
             /**
              * @brief 건물의 높이를 반환합니다.
              * @return int 건물의 높이.
              */
-            int getHeight() const { return height_; }
+            int getHeight() const { return descriptor_->height; }
 
             /**
              * @brief 건물의 너비를 반환합니다.
              * @return int 건물의 너비.
              */
-            int getWidth() const { return width_; }
+            int getWidth() const { return descriptor_->width; }
 
             /**
              * @brief 건물의 체력을 반환합니다.
@@ -88,6 +96,12 @@ namespace dune {
              */
             void takeDamage(int damage);
 
+            /**
+             * @brief 체력을 저장된 값으로 되돌립니다. (스냅샷/체크포인트 복원용)
+             * @param health 체력.
+             */
+            void restoreHealth(int health) { health_ = health; }
+
             /**
              * @brief 건물이 파괴되었는지 확인합니다.
              * @return true 체력이 0 이하이면 true.
@@ -99,7 +113,7 @@ namespace dune {
              * @brief 건물이 생산 가능한 유닛 타입을 반환합니다.
              * @return types::UnitType 생산 가능한 유닛 타입.
              */
-            types::UnitType getProducedUnit() const { return producedUnit_; }
+            types::UnitType getProducedUnit() const { return descriptor_->producedUnit; }
 
             using TerrainManager = dune::managers::TerrainManager;
 
@@ -107,20 +121,17 @@ namespace dune {
              * @brief 해당 위치에 건물을 배치할 수 있는지 확인합니다.
              * @param position 배치할 위치.
              * @param terrainManager 지형 관리 객체.
+             * @param occupancy 다른 건물/유닛이 차지한 타일을 확인할 점유 맵.
              * @return true 배치 가능하면 true.
              * @return false 배치 불가능하면 false.
              */
-            bool isPlaceable(const types::Position& position, const TerrainManager& terrainManager) const;
+            bool isPlaceable(const types::Position& position, const TerrainManager& terrainManager,
+                const core::OccupancyGrid& occupancy) const;
 
         private:
+            const BuildingDescriptor* descriptor_;
             types::Camp type_;
-            std::wstring name_;
-            std::wstring description_;
-            int buildingCost_;
             types::Position position_;
-            int width_;
-            int height_;
-            types::UnitType producedUnit_;
             int health_;
         };
     } // namespace managers
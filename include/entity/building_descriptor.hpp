@@ -0,0 +1,92 @@
+#pragma once
+#include "../utils/types.hpp"
+#include <array>
+#include <cstddef>
+
+namespace dune {
+    namespace entity {
+
+        /**
+         * @brief 건물 종류 하나의 고정 정보입니다.
+         * 새 건물은 BUILDING_DESCRIPTORS에 항목을 추가하면 표시, 설치, 생산 처리에 함께 반영됩니다.
+         */
+        struct BuildingDescriptor {
+            types::BuildingType type;
+            const wchar_t* name;
+            const wchar_t* description;
+            wchar_t glyph;                      // 맵에 그릴 문자
+            types::Camp camp;                   // 새로 설치할 때의 진영
+            int cost;                           // 설치 비용 (스파이스)
+            int width;
+            int height;
+            types::UnitType producedUnit;       // 생산 가능한 유닛 (없으면 None)
+            int spiceCapacityBonus;             // 설치 시 스파이스 최대치 증가량
+            int populationCapacityBonus;        // 설치 시 인구 최대치 증가량
+            types::Key placeKey;                // 설치 키 (설치할 수 없으면 None)
+            types::Key produceKey;              // 생산 키 (생산하지 않으면 None)
+            const wchar_t* placeCommand;        // 명령 창에 보일 설치 안내
+            const wchar_t* produceCommand;      // 명령 창에 보일 생산 안내
+        };
+
+        /**
+         * @brief 건물 종류별 고정 정보 표입니다. types::BuildingType 값이 곧 인덱스입니다.
+         */
+        inline constexpr std::array<BuildingDescriptor, 9> BUILDING_DESCRIPTORS = { {
+            { types::BuildingType::None, L"None", L"", L'?', types::Camp::Common,
+              0, 1, 1, types::UnitType::None, 0, 0,
+              types::Key::None, types::Key::None, nullptr, nullptr },
+            { types::BuildingType::Base, L"Base", L"본진", L'B', types::Camp::ArtLadies,
+              0, 2, 2, types::UnitType::Harvester, 0, 0,
+              types::Key::None, types::Key::Build_Harvester, nullptr, L"H: Produce Harvester" },
+            { types::BuildingType::Plate, L"Plate", L"장판 (건물 설치 가능)", L'P', types::Camp::Common,
+              1, 2, 2, types::UnitType::None, 0, 0,
+              types::Key::Build_Plate, types::Key::None, L"Shift + P: Place Plate", nullptr },
+            { types::BuildingType::Dormitory, L"Dormitory", L"숙소 (인구 최대치 증가 +10)", L'D', types::Camp::Common,
+              2, 2, 2, types::UnitType::None, 0, 10,
+              types::Key::Build_Dormitory, types::Key::None, L"Shift + D: Place Dormitory", nullptr },
+            { types::BuildingType::Garage, L"Garage", L"창고 (스파이스 최대치 증가 +10)", L'G', types::Camp::Common,
+              4, 2, 2, types::UnitType::None, 10, 0,
+              types::Key::Build_Garage, types::Key::None, L"Shift + G: Place Garage", nullptr },
+            { types::BuildingType::Barracks, L"Barracks", L"병영 (보병 생산)", L'K', types::Camp::ArtLadies,
+              4, 2, 2, types::UnitType::Soldier, 0, 0,
+              types::Key::Build_Barracks, types::Key::Build_Soldier, L"Shift + K: Place Barracks", L"S: Produce Soldier" },
+            { types::BuildingType::Shelter, L"Shelter", L"은신처 (특수유닛 생산)", L'S', types::Camp::ArtLadies,
+              5, 2, 2, types::UnitType::Fremen, 0, 0,
+              types::Key::Build_Shelter, types::Key::Build_Fremen, L"Shift + S: Place Shelter", L"F: Produce Fremen" },
+            { types::BuildingType::Arena, L"Arena", L"투기장 (투사 생산)", L'A', types::Camp::Harkonnen,
+              3, 2, 2, types::UnitType::Fighter, 0, 0,
+              types::Key::Build_Arena, types::Key::Build_Fighter, L"Shift + A: Place Arena", L"R: Produce Fighter" },
+            { types::BuildingType::Factory, L"Factory", L"공장 (중전차 생산)", L'F', types::Camp::Harkonnen,
+              5, 2, 2, types::UnitType::HeavyTank, 0, 0,
+              types::Key::Build_Factory, types::Key::Build_HeavyTank, L"Shift + F: Place Factory", L"T: Produce heavy Tank" },
+        } };
+
+        /**
+         * @brief 건물 종류의 고정 정보를 반환합니다.
+         */
+        constexpr const BuildingDescriptor& getBuildingDescriptor(types::BuildingType type) {
+            return BUILDING_DESCRIPTORS[static_cast<std::size_t>(type)];
+        }
+
+        /**
+         * @brief 설치 키에 해당하는 건물 정보를 찾습니다.
+         * @return 해당 건물이 없으면 nullptr.
+         */
+        constexpr const BuildingDescriptor* findBuildingByPlaceKey(types::Key key) {
+            if (key == types::Key::None) return nullptr;
+            for (const auto& descriptor : BUILDING_DESCRIPTORS) {
+                if (descriptor.placeKey == key) return &descriptor;
+            }
+            return nullptr;
+        }
+
+        // 표의 순서가 enum과 어긋나면 컴파일 단계에서 잡습니다.
+        static_assert([] {
+            for (std::size_t i = 0; i < BUILDING_DESCRIPTORS.size(); ++i) {
+                if (static_cast<std::size_t>(BUILDING_DESCRIPTORS[i].type) != i) return false;
+            }
+            return true;
+        }(), "BUILDING_DESCRIPTORS must be ordered by types::BuildingType");
+
+    } // namespace entity
+} // namespace dune
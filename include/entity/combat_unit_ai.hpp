@@ -1,8 +1,11 @@
 #pragma once
 #include "combat_unit_state.hpp"
-#include <memory>
+#include "core/trace.hpp"
 #include <chrono>
+#include <span>
 #include <string>
+#include <variant>
+#include <vector>
 
 namespace dune::entity::combat {
     /**
@@ -22,10 +25,23 @@ namespace dune::entity::combat {
          */
         void update(core::Map& map, std::chrono::milliseconds currentTime);
 
+        /**
+         * @brief 업데이트 전 계획 단계를 실행합니다. 대기 중이면 시야 안의 적을 미리 찾아 둡니다.
+         * (CombatUnitState::plan 참고)
+         */
+        void plan(const core::Map& map, core::PlanContext& context, std::chrono::milliseconds currentTime);
+
+        /**
+         * @brief 다음 업데이트가 필요한 시간을 반환합니다. (CombatUnitState::getNextUpdateTime 참고)
+         */
+        std::chrono::milliseconds getNextUpdateTime(std::chrono::milliseconds currentTime) const;
+
         /**
          * @brief 이동 명령을 내립니다.
+         * @param target 목표 위치.
+         * @param mode 경로 계산 방식. 여러 유닛에게 같은 목표를 줄 때는 Map::orderMove()가 골라 줍니다.
          */
-        void moveCommand(const types::Position& target);
+        void moveCommand(const types::Position& target, MoveMode mode = MoveMode::Path);
 
         /**
          * @brief 공격 명령을 내립니다.
@@ -38,20 +54,72 @@ namespace dune::entity::combat {
         void patrolCommand(const types::Position& from, const types::Position& to);
 
         /**
-         * @brief 현재 상태의 이름을 반환합니다.
+         * @brief 현재 상태 종류를 반환합니다.
+         */
+        CombatStateKind getStateKind() const {
+            return std::visit([](const auto& state) { return state.KIND; }, currentState_);
+        }
+
+        /**
+         * @brief 현재 상태의 표시 이름을 반환합니다.
+         */
+        const wchar_t* getCurrentState() const { return getStateName(getStateKind()); }
+
+        /**
+         * @brief 상태를 변경합니다. 새 상태는 이전 상태 자리에 만들어지므로 할당이 없습니다.
+         * 상태의 update() 안에서 부르면 그 상태 객체가 사라지므로, 부른 뒤에는 바로 반환해야 합니다.
+         * 인자는 이전 상태의 멤버를 가리킬 수 있어 값으로 복사해 둡니다.
+         * @tparam State 새 상태 타입.
+         * @param args CombatUnitAI* 뒤에 이어지는 상태 생성자 인자.
+         */
+        template<typename State, typename... Args>
+        void CombatChangeState(Args... args) {
+            if (core::TraceRecorder::instance().isRecording()) {
+                traceStateChange(State::KIND);
+            }
+            path_.clear();
+            waypoints_.clear();
+            currentState_.template emplace<State>(this, std::move(args)...);
+        }
+
+        /**
+         * @brief 현재 상태가 대기 상태인지 확인합니다.
+         */
+        bool isIdle() const { return getStateKind() == CombatStateKind::Idle; }
+
+        /**
+         * @brief 이동 상태들이 함께 쓰는 경로 버퍼입니다. (목표가 back(), 상태 전환 시 비워짐)
          */
-        std::wstring getCurrentState() const;
+        std::vector<types::Position>& getPath() { return path_; }
 
         /**
-         * @brief 상태를 변경합니다.
+         * @brief 먼 거리 이동 시 남은 경유지 버퍼입니다. (상태 전환 시 비워짐)
          */
-        void CombatChangeState(std::unique_ptr<CombatUnitState> newState);
+        std::vector<types::Position>& getWaypoints() { return waypoints_; }
+
+        /**
+         * @brief 맵에서 제거되어 곧 해제될 유닛을 노리고 있었다면 타겟을 놓고 대기 상태로 돌아갑니다.
+         * Map::update()가 틱 끝에서 유닛을 해제하기 전에 부릅니다.
+         * @param removed 제거된 유닛 (std::less 순으로 정렬).
+         */
+        void releaseTargets(std::span<const Unit* const> removed);
+
+        /**
+         * @brief 현재 타겟이나 상태의 목표가 units 안에 있는지 확인합니다. (releaseTargets()가 바꿀지 미리 확인)
+         * @param units 확인할 유닛 (std::less 순으로 정렬).
+         */
+        bool holdsTargetIn(std::span<const Unit* const> units) const;
 
         /**
          * @brief 현재 타겟을 반환합니다.
          */
         Unit* getCurrentTarget() const { return currentTarget_; }
 
+        /**
+         * @brief 마지막 이동 명령의 목표 위치를 반환합니다. (명령이 없었으면 {-1, -1})
+         */
+        const types::Position& getMoveTarget() const { return moveTarget_; }
+
         /**
          * @brief 현재 타겟을 설정합니다.
          */
@@ -64,13 +132,46 @@ namespace dune::entity::combat {
             lastAttackTime_ = time;
         }
 
-        void detectEnemiesInSight(core::Map& map);
+        /**
+         * @brief 시야 안에서 공격할 적을 찾습니다. 하베스터가 있으면 우선하고, 없으면 가장 가까운 적입니다.
+         * @param nearbyUnits 공간 인덱스 검색 결과를 담을 버퍼 (계획 단계에서는 작업자의 PlanContext 버퍼).
+         * @return const Unit* 찾은 적 (없으면 nullptr).
+         */
+        const Unit* findEnemyInSight(const core::Map& map, std::vector<const Unit*>& nearbyUnits) const;
+
+        /**
+         * @brief 타겟, 공격 시각, 현재 상태와 남은 경로를 스냅샷 레코드에 기록합니다.
+         * @param record 채울 레코드.
+         * @param positions 경로를 이어 붙일 공유 위치 배열.
+         * @param ids 타겟 유닛을 고유 번호로 바꿀 표 (맵에 없는 타겟은 NO_UNIT으로 기록).
+         */
+        void save(core::snapshot::AiRecord& record, std::vector<core::snapshot::PositionRecord>& positions,
+            const core::snapshot::UnitIds& ids) const;
+
+        /**
+         * @brief save()로 기록한 AI를 되살립니다. 타겟 번호는 units에서 찾으며, 없으면 타겟이 없는 것으로 둡니다.
+         * @return false 상태 종류나 이동 방식이 범위를 벗어나거나 경로가 위치 배열을 벗어난 경우.
+         */
+        bool restore(const core::snapshot::AiRecord& record, std::span<const core::snapshot::PositionRecord> positions,
+            const managers::UnitManager& units);
 
     private:
+        using State = std::variant<CombatIdleState, CombatMovingState, AttackingState, PatrollingState, PursuingState>;
+
+        // 상태 전환을 타임라인에 남깁니다. (기록 중일 때만 부름)
+        void traceStateChange(CombatStateKind next) const;
+
+        // 상태가 노리는 유닛 (타겟이 없는 상태면 nullptr)
+        const Unit* getStateTarget() const;
+        static bool isTargetIn(const Unit* target, std::span<const Unit* const> units);
+
         Unit* owner_;                                       // AI가 제어하는 유닛
-        std::unique_ptr<CombatUnitState> currentState_;    // 현재 상태
+        State currentState_;                               // 현재 상태
+        std::vector<types::Position> path_;                // 상태 사이에 재사용하는 경로 버퍼
+        std::vector<types::Position> waypoints_;           // 상태 사이에 재사용하는 경유지 버퍼
         Unit* currentTarget_;                              // 현재 타겟
         std::chrono::milliseconds lastAttackTime_;         // 마지막 공격 시간
         types::Position moveTarget_;                       // 이동 목표 위치
+        const Unit* sightedEnemy_ = nullptr;               // plan()에서 찾은 시야 안의 적
     };
 }
\ No newline at end of file
@@ -1,11 +1,18 @@
 #pragma once
 #include "../utils/types.hpp"
+#include "../core/snapshot_format.hpp"
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 
 namespace dune {
-    namespace core { class Map; }
+    namespace core { class Map; struct PlanContext; }
+    namespace pathfinding { class FlowField; }
+    namespace managers { class UnitManager; }
     namespace entity {
         class Unit;
         namespace combat {
@@ -16,51 +23,112 @@ namespace dune {
 
 namespace dune::entity::combat {
     /**
-     * @brief 전투 유닛의 기본 상태 클래스입니다.
+     * @brief 전투 유닛 상태 종류입니다. COMBAT_STATE_NAMES와 순서가 같아야 합니다.
+     */
+    enum class CombatStateKind : std::uint8_t {
+        Idle,
+        Moving,
+        Attacking,
+        Patrolling,
+        Pursuing
+    };
+
+    // 상태 종류별 표시 이름
+    inline constexpr std::array<const wchar_t*, 5> COMBAT_STATE_NAMES = {
+        L"Idle", L"Moving", L"Attacking", L"Patrolling", L"Pursuing"
+    };
+
+    /**
+     * @brief 전투 유닛 상태 종류의 표시 이름을 반환합니다.
+     */
+    constexpr const wchar_t* getStateName(CombatStateKind kind) {
+        return COMBAT_STATE_NAMES[static_cast<std::size_t>(kind)];
+    }
+
+    /**
+     * @brief 이동 명령의 경로 계산 방식입니다.
+     */
+    enum class MoveMode {
+        Path,       // 유닛마다 A* 경로 (먼 거리는 계층적 탐색)
+        FlowField   // 같은 목표로 가는 유닛들이 하나의 흐름장을 공유 (대규모 그룹 이동용)
+    };
+
+    /**
+     * @brief 전투 유닛 상태들의 공통 기반 클래스입니다.
+     *
+     * 상태는 CombatUnitAI 안의 std::variant에 직접 들어가며, std::visit으로 아래 함수를 호출합니다.
+     * 상태마다 종류(KIND)와 update()를 정의하고, 필요하면 plan()과 getNextUpdateTime()을 다시 정의합니다.
+     * 경로 버퍼는 CombatUnitAI가 소유해 상태가 바뀌어도 용량을 재사용합니다.
      */
     class CombatUnitState {
     public:
-        virtual ~CombatUnitState() = default;
+        /**
+         * @brief 같은 틱의 update() 전에 경로 탐색처럼 맵을 읽기만 하는 준비 작업을 합니다.
+         * 여러 유닛의 plan()이 동시에 실행되므로 자기 상태만 바꾸고 맵은 읽기만 해야 합니다.
+         */
+        void plan(const Unit* /*unit*/, const core::Map& /*map*/,
+            core::PlanContext& /*context*/, std::chrono::milliseconds /*currentTime*/) {}
+
+        /**
+         * @brief 이 상태가 다음으로 할 일이 생기는 시간을 반환합니다. update() 직후에 호출됩니다.
+         * 맵은 그 전까지 유닛을 깨우지 않으므로, 매 틱 확인이 필요한 상태는 currentTime을 반환합니다.
+         * @return std::chrono::milliseconds 다음 업데이트 시간 (milliseconds::max()면 명령이 올 때까지 대기).
+         */
+        std::chrono::milliseconds getNextUpdateTime(const Unit* /*unit*/,
+            std::chrono::milliseconds currentTime) const {
+            return currentTime;
+        }
 
         /**
-         * @brief 상태를 업데이트합니다.
+         * @brief 상태의 목표와 시각을 스냅샷 레코드에 기록합니다. 생성자 인자는 CombatUnitAI::restore()가 넘깁니다.
+         * @param ids 타겟 유닛을 고유 번호로 바꿀 표.
          */
-        virtual void update(Unit* unit, core::Map& map,
-            std::chrono::milliseconds currentTime) = 0;
+        void save(core::snapshot::AiRecord& /*record*/, const core::snapshot::UnitIds& /*ids*/) const {}
 
         /**
-         * @brief 현재 상태의 이름을 반환합니다.
+         * @brief 생성자 인자가 아닌 나머지 상태 값을 레코드에서 되살립니다.
          */
-        virtual std::wstring getStateName() const = 0;
+        void restore(const core::snapshot::AiRecord& /*record*/) {}
 
         /**
          * @brief 공격 가능한 범위인지 확인합니다.
          */
-        bool isInAttackRange(const Unit* attacker, const Unit* target) const;
+        static bool isInAttackRange(const Unit* attacker, const Unit* target);
 
         /**
-         * @brief 시야 범위 내에 있는지 확인합니다.
+         * @brief 유닛 타입의 공격 사거리(맨해튼 거리)를 반환합니다.
+         * @return int 사거리 (공격할 수 없는 타입이면 0).
          */
-        bool isInSightRange(const Unit* unit, const types::Position& pos) const;
+        static int getAttackRange(types::UnitType type);
+
+        /**
+         * @brief 공격 한 번을 맞은 뒤의 체력을 반환합니다. 0이면 죽어 맵에서 제거됩니다.
+         * 실제 교전(AttackingState)과 전술 계획기의 롤아웃이 이 규칙과 공격 간격(유닛의 이동 쿨다운)을 함께 씁니다.
+         */
+        static constexpr int getHealthAfterAttack(int health, int attackPower) {
+            return health > attackPower ? health - attackPower : 0;
+        }
 
-    protected:
         /**
-         * @brief 주어진 위치로의 경로를 찾습니다.
+         * @brief 시야 범위 내에 있는지 확인합니다.
          */
-        std::vector<types::Position> findPath(
-            const types::Position& start,
-            const types::Position& goal,
-            const core::Map& map) const;
+        static bool isInSightRange(const Unit* unit, const types::Position& pos);
 
+    protected:
         /**
          * @brief 이동 가능한 위치인지 확인합니다.
          */
         bool isValidMovePosition(const types::Position& pos, const core::Map& map) const;
 
         /**
-         * @brief 공격이 가능한 상태인지 확인합니다.
+         * @brief 공격이 가능한 상태인지 확인합니다. 공격은 이동과 같은 쿨다운을 씁니다.
          */
         bool canAttack(const Unit* unit, std::chrono::milliseconds currentTime) const;
+
+        /**
+         * @brief 시야를 다시 훑을 시간을 반환합니다. 유닛이 한 번 움직이는 주기마다 한 번 훑습니다.
+         */
+        static std::chrono::milliseconds getNextSightScanTime(const Unit* unit, std::chrono::milliseconds currentTime);
     };
 
     /**
@@ -70,8 +138,13 @@ namespace dune::entity::combat {
     public:
         explicit CombatIdleState(CombatUnitAI* ai);
         void update(Unit* unit, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
-        std::wstring getStateName() const override { return L"Idle"; }
+            std::chrono::milliseconds currentTime);
+        static constexpr CombatStateKind KIND = CombatStateKind::Idle;
+        // 명령은 유닛을 깨우므로, 그 사이에는 시야를 훑을 때만 깨어납니다.
+        std::chrono::milliseconds getNextUpdateTime(const Unit* unit,
+            std::chrono::milliseconds currentTime) const {
+            return getNextSightScanTime(unit, currentTime);
+        }
     private:
         CombatUnitAI* ai_;
     };
@@ -81,14 +154,34 @@ namespace dune::entity::combat {
      */
     class CombatMovingState : public CombatUnitState {
     public:
-        CombatMovingState(CombatUnitAI* ai, const types::Position& target);
+        CombatMovingState(CombatUnitAI* ai, const types::Position& target, MoveMode mode = MoveMode::Path);
         void update(Unit* unit, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
-        std::wstring getStateName() const override { return L"Moving"; }
+            std::chrono::milliseconds currentTime);
+        void plan(const Unit* unit, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
+        static constexpr CombatStateKind KIND = CombatStateKind::Moving;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* unit,
+            std::chrono::milliseconds currentTime) const;
+        // 흐름장은 저장하지 않고, 되살린 뒤 첫 update()에서 같은 목표의 흐름장을 다시 받습니다.
+        void save(core::snapshot::AiRecord& record, const core::snapshot::UnitIds& ids) const;
+        void restore(const core::snapshot::AiRecord& record) { blockedMoves_ = record.blockedMoves; }
     private:
         CombatUnitAI* ai_;
         types::Position targetPosition_;
-        std::vector<types::Position> currentPath_;
+        MoveMode mode_;
+        std::shared_ptr<const pathfinding::FlowField> flowField_;  // FlowField 모드에서 공유하는 흐름장
+        int blockedMoves_ = 0;  // FlowField 모드에서 연속으로 막힌 이동 횟수
+
+        // 움직이는 유닛에 막혀 기다리는 최대 이동 주기 수 (넘으면 그 자리에서 멈춥니다)
+        static constexpr int MAX_BLOCKED_MOVES = 50;
+
+        void updateFlowField(Unit* unit, core::Map& map, std::chrono::milliseconds currentTime);
+
+        /**
+         * @brief 목표 쪽 칸이 모두 멈춰 있는 유닛으로 막혔는지 확인합니다.
+         * 먼저 도착한 유닛들 뒤에 차례로 멈추며 목표 주변에 모이게 됩니다.
+         */
+        bool isBlockedBySettledUnits(const Unit* unit, const core::Map& map) const;
     };
 
     /**
@@ -98,11 +191,11 @@ namespace dune::entity::combat {
     public:
         AttackingState(CombatUnitAI* ai, Unit* target);
         void update(Unit* unit, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
-        std::wstring getStateName() const override {
-            return L"Attacking";
-        }
-        std::wstring getUnitTypeName(types::UnitType type) const;
+            std::chrono::milliseconds currentTime);
+        static constexpr CombatStateKind KIND = CombatStateKind::Attacking;
+        const Unit* getTarget() const { return target_; }
+        void save(core::snapshot::AiRecord& record, const core::snapshot::UnitIds& ids) const;
+        void restore(const core::snapshot::AiRecord& record) { lastAttackTime_ = std::chrono::milliseconds(record.stateTime); }
     private:
         CombatUnitAI* ai_;
         Unit* target_;
@@ -118,14 +211,22 @@ namespace dune::entity::combat {
             const types::Position& from,
             const types::Position& to);
         void update(Unit* unit, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
-        std::wstring getStateName() const override { return L"Patrolling"; }
+            std::chrono::milliseconds currentTime);
+        void plan(const Unit* unit, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
+        static constexpr CombatStateKind KIND = CombatStateKind::Patrolling;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* unit,
+            std::chrono::milliseconds currentTime) const;
+        void save(core::snapshot::AiRecord& record, const core::snapshot::UnitIds& ids) const;
+        void restore(const core::snapshot::AiRecord& record) {
+            currentTarget_ = core::snapshot::toPosition(record.stateTarget);
+        }
     private:
         CombatUnitAI* ai_;
         types::Position fromPosition_;
         types::Position toPosition_;
         types::Position currentTarget_;
-        std::vector<types::Position> currentPath_;
+        const Unit* sightedEnemy_ = nullptr;  // plan()에서 시야 안에서 찾은 적
     };
 
     /**
@@ -135,12 +236,18 @@ namespace dune::entity::combat {
     public:
         PursuingState(CombatUnitAI* ai, Unit* target);
         void update(Unit* unit, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
-        std::wstring getStateName() const override { return L"Pursuing"; }
+            std::chrono::milliseconds currentTime);
+        void plan(const Unit* unit, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
+        static constexpr CombatStateKind KIND = CombatStateKind::Pursuing;
+        const Unit* getTarget() const { return target_; }
+        void save(core::snapshot::AiRecord& record, const core::snapshot::UnitIds& ids) const;
+        void restore(const core::snapshot::AiRecord& record) {
+            lastPathUpdateTime_ = std::chrono::milliseconds(record.stateTime);
+        }
     private:
         CombatUnitAI* ai_;
         Unit* target_;
-        std::vector<types::Position> currentPath_;
         std::chrono::milliseconds lastPathUpdateTime_;
     };
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
-#include <memory>
 #include <string>
 #include <chrono>
+#include <span>
+#include <variant>
+#include <vector>
 #include "harvester_state.hpp"
+#include "core/trace.hpp"
 #include "utils/harvester_command.hpp"
 
 namespace dune::entity {
@@ -22,6 +25,17 @@ namespace dune::entity {
          */
         void update(Unit* harvester, core::Map& map, std::chrono::milliseconds currentTime);
 
+        /**
+         * @brief 업데이트 전 계획 단계를 실행합니다. (HarvesterState::plan 참고)
+         */
+        void plan(const Unit* harvester, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
+
+        /**
+         * @brief 다음 업데이트가 필요한 시간을 반환합니다. (HarvesterState::getNextUpdateTime 참고)
+         */
+        std::chrono::milliseconds getNextUpdateTime(const Unit* harvester, std::chrono::milliseconds currentTime) const;
+
         /**
          * @brief 수확 명령을 내립니다.
          */
@@ -37,11 +51,44 @@ namespace dune::entity {
             std::chrono::milliseconds currentTime);
 
         // 이전과 동일한 접근자 메서드들
-        inline std::wstring getCurrentState() const {
-            return currentState_ ? currentState_->getStateName() : L"Unknown";
+        /**
+         * @brief 현재 상태 종류를 반환합니다.
+         */
+        HarvesterStateKind getStateKind() const {
+            return std::visit([](const auto& state) { return state.KIND; }, currentState_);
+        }
+
+        /**
+         * @brief 현재 상태의 표시 이름을 반환합니다.
+         */
+        const wchar_t* getCurrentState() const { return getStateName(getStateKind()); }
+
+        /**
+         * @brief 상태를 바꿉니다. 새 상태는 이전 상태 자리에 만들어지므로 할당이 없습니다.
+         * 상태의 update() 안에서 부르면 그 상태 객체가 사라지므로, 부른 뒤에는 바로 반환해야 합니다.
+         * 인자는 이전 상태의 멤버를 가리킬 수 있어 값으로 복사해 둡니다.
+         * @tparam State 새 상태 타입.
+         * @param args HarvesterAI* 뒤에 이어지는 상태 생성자 인자.
+         */
+        template<typename State, typename... Args>
+        void changeState(Args... args) {
+            if (core::TraceRecorder::instance().isRecording()) {
+                traceStateChange(State::KIND);
+            }
+            path_.clear();
+            waypoints_.clear();
+            currentState_.template emplace<State>(this, std::move(args)...);
         }
 
-        void changeState(std::unique_ptr<HarvesterState> newState);
+        /**
+         * @brief 이동 상태들이 함께 쓰는 경로 버퍼입니다. (목표가 back(), 상태 전환 시 비워짐)
+         */
+        std::vector<types::Position>& getPath() { return path_; }
+
+        /**
+         * @brief 먼 거리 이동 시 남은 경유지 버퍼입니다. (상태 전환 시 비워짐)
+         */
+        std::vector<types::Position>& getWaypoints() { return waypoints_; }
 
         inline const HarvesterCommand& getCurrentCommand() const {
             return commandQueue_.getCurrentCommand();
@@ -52,7 +99,23 @@ namespace dune::entity {
         inline int getSpiceAmount() const { return spiceAmount_; }
         inline void setSpiceAmount(int amount) { spiceAmount_ = amount; }
 
+        /**
+         * @brief 본진, 명령, 적재량, 현재 상태와 남은 경로를 스냅샷 레코드에 기록합니다.
+         * @param record 채울 레코드.
+         * @param positions 경로를 이어 붙일 공유 위치 배열.
+         */
+        void save(core::snapshot::AiRecord& record, std::vector<core::snapshot::PositionRecord>& positions) const;
+
+        /**
+         * @brief save()로 기록한 AI를 되살립니다.
+         * @return false 상태 종류나 명령 종류가 범위를 벗어나거나 경로가 위치 배열을 벗어난 경우.
+         */
+        bool restore(const core::snapshot::AiRecord& record, std::span<const core::snapshot::PositionRecord> positions);
+
     private:
+        // 상태 전환을 타임라인에 남깁니다. (기록 중일 때만 부름)
+        void traceStateChange(HarvesterStateKind next) const;
+
         /**
          * @brief 마지막 명령을 다시 실행합니다.
          */
@@ -69,9 +132,13 @@ namespace dune::entity {
          */
         bool isValidMovePosition(const core::Map& map, const types::Position& pos) const;
 
+        using State = std::variant<IdleState, MovingState, MovingToHarvestState, HarvestingState, ReturningState>;
+
         types::Position basePosition_;      // 본진 위치
         types::Position targetPosition_;    // 목표 위치
-        std::unique_ptr<HarvesterState> currentState_;  // 현재 상태
+        State currentState_;                // 현재 상태
+        std::vector<types::Position> path_;       // 상태 사이에 재사용하는 경로 버퍼
+        std::vector<types::Position> waypoints_;  // 상태 사이에 재사용하는 경유지 버퍼
         HarvesterCommandQueue commandQueue_; // 명령 큐
         int spiceAmount_;                   // 현재 보유 스파이스량
     };
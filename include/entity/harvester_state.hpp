@@ -1,13 +1,16 @@
 #pragma once
 #include "../utils/types.hpp"
+#include "../core/snapshot_format.hpp"
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <random>
 
 // 전방 선언
 namespace dune {
-    namespace core { class Map; }
+    namespace core { class Map; struct PlanContext; }
     namespace entity {
         class HarvesterAI;
         class Unit;
@@ -17,32 +20,65 @@ namespace dune {
 
 namespace dune::entity {
     /**
-     * @brief 하베스터의 기본 상태 클래스입니다.
+     * @brief 하베스터 상태 종류입니다. HARVESTER_STATE_NAMES와 순서가 같아야 합니다.
+     */
+    enum class HarvesterStateKind : std::uint8_t {
+        Idle,
+        Moving,
+        MovingToHarvest,
+        Harvesting,
+        Returning
+    };
+
+    // 상태 종류별 표시 이름
+    inline constexpr std::array<const wchar_t*, 5> HARVESTER_STATE_NAMES = {
+        L"Idle", L"Moving", L"MovingToHarvest", L"Harvesting", L"Returning"
+    };
+
+    /**
+     * @brief 하베스터 상태 종류의 표시 이름을 반환합니다.
+     */
+    constexpr const wchar_t* getStateName(HarvesterStateKind kind) {
+        return HARVESTER_STATE_NAMES[static_cast<std::size_t>(kind)];
+    }
+
+    /**
+     * @brief 하베스터 상태들의 공통 기반 클래스입니다.
+     *
+     * 상태는 HarvesterAI 안의 std::variant에 직접 들어가며, std::visit으로 아래 함수를 호출합니다.
+     * 상태마다 종류(KIND)와 update()를 정의하고, 필요하면 plan()과 getNextUpdateTime()을 다시 정의합니다.
+     * 경로 버퍼는 HarvesterAI가 소유해 상태가 바뀌어도 용량을 재사용합니다.
      */
     class HarvesterState {
     public:
-        virtual ~HarvesterState() = default;
+        /**
+         * @brief 같은 틱의 update() 전에 경로 탐색처럼 맵을 읽기만 하는 준비 작업을 합니다.
+         * 여러 유닛의 plan()이 동시에 실행되므로 자기 상태만 바꾸고 맵은 읽기만 해야 합니다.
+         */
+        void plan(const Unit* /*harvester*/, const core::Map& /*map*/,
+            core::PlanContext& /*context*/, std::chrono::milliseconds /*currentTime*/) {}
 
         /**
-         * @brief 상태 업데이트를 처리합니다.
+         * @brief 이 상태가 다음으로 할 일이 생기는 시간을 반환합니다. update() 직후에 호출됩니다.
+         * 맵은 그 전까지 유닛을 깨우지 않으므로, 매 틱 확인이 필요한 상태는 currentTime을 반환합니다.
+         * @return std::chrono::milliseconds 다음 업데이트 시간 (milliseconds::max()면 명령이 올 때까지 대기).
          */
-        virtual void update(Unit* harvester, core::Map& map,
-            std::chrono::milliseconds currentTime) = 0;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* /*harvester*/,
+            std::chrono::milliseconds currentTime) const {
+            return currentTime;
+        }
 
         /**
-         * @brief 현재 상태의 이름을 반환합니다.
+         * @brief 상태의 목표와 시각을 스냅샷 레코드에 기록합니다. 생성자 인자는 HarvesterAI::restore()가 넘깁니다.
          */
-        virtual std::wstring getStateName() const = 0;
+        void save(core::snapshot::AiRecord& /*record*/) const {}
 
-    protected:
         /**
-         * @brief A* 알고리즘을 사용하여 경로를 찾습니다.
+         * @brief 생성자 인자가 아닌 나머지 상태 값을 레코드에서 되살립니다.
          */
-        std::vector<types::Position> findPath(
-            const types::Position& start,
-            const types::Position& goal,
-            const core::Map& map) const;
+        void restore(const core::snapshot::AiRecord& /*record*/) {}
 
+    protected:
         /**
          * @brief 해당 위치로 이동 가능한지 확인합니다.
          */
@@ -57,9 +93,11 @@ namespace dune::entity {
         explicit IdleState(HarvesterAI* ai);
 
         void update(Unit* harvester, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
+            std::chrono::milliseconds currentTime);
 
-        std::wstring getStateName() const override { return L"Idle"; }
+        static constexpr HarvesterStateKind KIND = HarvesterStateKind::Idle;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* harvester,
+            std::chrono::milliseconds currentTime) const;
 
     private:
         HarvesterAI* ai_;
@@ -73,14 +111,20 @@ namespace dune::entity {
         MovingState(HarvesterAI* ai, const types::Position& target);
 
         void update(Unit* harvester, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
+            std::chrono::milliseconds currentTime);
+        void plan(const Unit* harvester, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
 
-        std::wstring getStateName() const override { return L"Moving"; }
+        static constexpr HarvesterStateKind KIND = HarvesterStateKind::Moving;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* harvester,
+            std::chrono::milliseconds currentTime) const;
+        void save(core::snapshot::AiRecord& record) const {
+            record.stateTarget = core::snapshot::toRecord(targetPosition_);
+        }
 
     private:
         HarvesterAI* ai_;
         types::Position targetPosition_;
-        std::vector<types::Position> currentPath_;
     };
 
     /**
@@ -91,14 +135,20 @@ namespace dune::entity {
         MovingToHarvestState(HarvesterAI* ai, const types::Position& spicePos);
 
         void update(Unit* harvester, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
+            std::chrono::milliseconds currentTime);
+        void plan(const Unit* harvester, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
 
-        std::wstring getStateName() const override { return L"MovingToHarvest"; }
+        static constexpr HarvesterStateKind KIND = HarvesterStateKind::MovingToHarvest;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* harvester,
+            std::chrono::milliseconds currentTime) const;
+        void save(core::snapshot::AiRecord& record) const {
+            record.stateTarget = core::snapshot::toRecord(spicePosition_);
+        }
 
     private:
         HarvesterAI* ai_;
         types::Position spicePosition_;
-        std::vector<types::Position> currentPath_;
     };
 
     /**
@@ -109,9 +159,15 @@ namespace dune::entity {
         explicit HarvestingState(HarvesterAI* ai);
 
         void update(Unit* harvester, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
+            std::chrono::milliseconds currentTime);
 
-        std::wstring getStateName() const override { return L"Harvesting"; }
+        static constexpr HarvesterStateKind KIND = HarvesterStateKind::Harvesting;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* harvester,
+            std::chrono::milliseconds currentTime) const;
+        void save(core::snapshot::AiRecord& record) const { record.stateTime = harvestStartTime_.count(); }
+        void restore(const core::snapshot::AiRecord& record) {
+            harvestStartTime_ = std::chrono::milliseconds(record.stateTime);
+        }
 
     private:
         static constexpr auto HARVEST_TIME = std::chrono::seconds(4);
@@ -130,13 +186,16 @@ namespace dune::entity {
         explicit ReturningState(HarvesterAI* ai);
 
         void update(Unit* harvester, core::Map& map,
-            std::chrono::milliseconds currentTime) override;
+            std::chrono::milliseconds currentTime);
+        void plan(const Unit* harvester, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
 
-        std::wstring getStateName() const override { return L"Returning"; }
+        static constexpr HarvesterStateKind KIND = HarvesterStateKind::Returning;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* harvester,
+            std::chrono::milliseconds currentTime) const;
 
     private:
         HarvesterAI* ai_;
-        std::vector<types::Position> currentPath_;
     };
 
 } // namespace dune::entity
\ No newline at end of file
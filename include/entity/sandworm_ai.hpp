@@ -1,12 +1,15 @@
 #pragma once
-#include <memory>
 #include <string>
 #include <chrono>
+#include <span>
+#include <variant>
+#include <vector>
 #include "sandworm_state.hpp"
+#include "core/trace.hpp"
 
 // 전방 선언
 namespace dune {
-    namespace core { class Map; }
+    namespace core { class Map; struct PlanContext; }
     namespace entity {
         class Unit;
         class SandwormState;
@@ -20,11 +23,39 @@ namespace dune::entity {
         SandwormAI();
         ~SandwormAI();
         void update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime);
-        std::wstring getCurrentState() const;
-        void changeState(std::unique_ptr<SandwormState> newState);
+        void plan(const Unit* sandworm, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
+        std::chrono::milliseconds getNextUpdateTime(const Unit* sandworm, std::chrono::milliseconds currentTime) const;
+        SandwormStateKind getStateKind() const {
+            return std::visit([](const auto& state) { return state.KIND; }, currentState_);
+        }
+        const wchar_t* getCurrentState() const { return getStateName(getStateKind()); }
+
+        // 새 상태를 이전 상태 자리에 만듭니다 (할당 없음). 상태의 update() 안에서 불렀다면 바로 반환해야 하며,
+        // 인자는 이전 상태의 멤버를 가리킬 수 있어 값으로 복사해 둡니다.
+        template<typename State, typename... Args>
+        void changeState(Args... args) {
+            if (core::TraceRecorder::instance().isRecording()) {
+                traceStateChange(State::KIND);
+            }
+            path_.clear();
+            currentState_.template emplace<State>(this, std::move(args)...);
+        }
+
+        // 사냥 경로 버퍼 (목표가 back(), 상태 전환 시 비워짐)
+        std::vector<types::Position>& getPath() { return path_; }
+        const std::vector<types::Position>& getPath() const { return path_; }
+
+        // 현재 상태와 사냥 경로를 스냅샷 레코드에 기록하고 되살립니다.
+        void save(core::snapshot::AiRecord& record, std::vector<core::snapshot::PositionRecord>& positions) const;
+        bool restore(const core::snapshot::AiRecord& record, std::span<const core::snapshot::PositionRecord> positions);
 
     private:
-        std::unique_ptr<SandwormState> currentState_;
+        // 상태 전환을 타임라인에 남깁니다. (기록 중일 때만 부름)
+        void traceStateChange(SandwormStateKind next) const;
+
+        std::variant<HuntingState, DigestingState, BurrowingState> currentState_;
+        std::vector<types::Position> path_;  // 상태 사이에 재사용하는 경로 버퍼
     };
 
 } // namespace dune::entity
@@ -1,46 +1,75 @@
 #pragma once
 #include "utils/types.hpp"
+#include "core/snapshot_format.hpp"
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 
 // 전방 선언
 namespace dune {
-    namespace core { class Map; }
+    namespace core { class Map; struct PlanContext; }
     namespace entity { class SandwormAI; class Unit; }
 }
 
 namespace dune::entity {
 
+    // 샌드웜 상태 종류입니다. SANDWORM_STATE_NAMES와 순서가 같아야 합니다.
+    enum class SandwormStateKind : std::uint8_t {
+        Hunting,
+        Digesting,
+        Burrowing
+    };
+
+    inline constexpr std::array<const wchar_t*, 3> SANDWORM_STATE_NAMES = {
+        L"Hunting", L"Digesting", L"Burrowing"
+    };
+
+    constexpr const wchar_t* getStateName(SandwormStateKind kind) {
+        return SANDWORM_STATE_NAMES[static_cast<std::size_t>(kind)];
+    }
+
+    // 샌드웜 상태들의 공통 기반입니다. 상태는 SandwormAI 안의 std::variant에 직접 들어가며 std::visit으로 호출됩니다.
     class SandwormState {
     public:
-        virtual ~SandwormState() = default;
-        virtual void update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime) = 0;
-        virtual std::wstring getStateName() const = 0;
+        // 같은 틱의 update() 전에 호출되며, 다른 유닛과 동시에 실행되므로 맵은 읽기만 합니다.
+        void plan(const Unit* /*sandworm*/, const core::Map& /*map*/,
+            core::PlanContext& /*context*/, std::chrono::milliseconds /*currentTime*/) {}
+
+        // update() 직후 호출되며, 맵은 반환한 시간까지 이 유닛을 깨우지 않습니다.
+        std::chrono::milliseconds getNextUpdateTime(const Unit* /*sandworm*/,
+            std::chrono::milliseconds currentTime) const {
+            return currentTime;
+        }
+
+        // 스냅샷에 상태의 시각과 목표를 기록하고 되살립니다. 기록할 값이 없는 상태는 그대로 씁니다.
+        void save(core::snapshot::AiRecord& /*record*/) const {}
+        void restore(const core::snapshot::AiRecord& /*record*/) {}
 
     protected:
         bool isValidTarget(const Unit* target) const;
-        types::Position findNearestPrey(const Unit* sandworm, const core::Map& map) const;
-        types::Position findSuitableExcretionSpot(const types::Position& currentPos, const core::Map& map) const;
-        std::vector<types::Position> findPath(
-            const types::Position& start,
-            const types::Position& goal,
-            const dune::core::Map& map
-        ) const;
-
-        void changeState(SandwormAI* ai, std::unique_ptr<SandwormState> newState);
+        // nearbyUnits는 공간 인덱스 검색 결과를 담을 버퍼입니다. (계획 단계에서는 작업자의 PlanContext 버퍼)
+        types::Position findNearestPrey(const Unit* sandworm, const core::Map& map,
+            std::vector<const Unit*>& nearbyUnits) const;
+        types::Position findSuitableExcretionSpot(const types::Position& currentPos, core::Map& map) const;
     };
 
     class HuntingState : public SandwormState {
     public:
         explicit HuntingState(SandwormAI* ai) : ai_(ai) {}
-        void update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime) override;
-        std::wstring getStateName() const override { return L"Hunting"; }
+        void update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime);
+        void plan(const Unit* sandworm, const core::Map& map,
+            core::PlanContext& context, std::chrono::milliseconds currentTime);
+        static constexpr SandwormStateKind KIND = SandwormStateKind::Hunting;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* sandworm, std::chrono::milliseconds currentTime) const;
+        void save(core::snapshot::AiRecord& record) const { record.stateTime = lastPathUpdate_.count(); }
+        void restore(const core::snapshot::AiRecord& record) { lastPathUpdate_ = std::chrono::milliseconds(record.stateTime); }
 
     private:
         SandwormAI* ai_;
-        std::vector<types::Position> currentPath_;
-        std::chrono::milliseconds lastPathUpdate_{ 0 };
+        std::chrono::milliseconds lastPathUpdate_{ 0 };  // 마지막으로 먹이를 찾은 시각 (찾지 못했어도 기록)
         static constexpr auto PATH_UPDATE_INTERVAL = std::chrono::seconds(3);
         bool isValidMovePosition(const types::Position& pos, const core::Map& map) const;
     };
@@ -48,8 +77,11 @@ namespace dune::entity {
     class DigestingState : public SandwormState {
     public:
         explicit DigestingState(SandwormAI* ai) : ai_(ai), digestStartTime_(std::chrono::milliseconds(0)) {}
-        void update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime) override;
-        std::wstring getStateName() const override { return L"Digesting"; }
+        void update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime);
+        static constexpr SandwormStateKind KIND = SandwormStateKind::Digesting;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* sandworm, std::chrono::milliseconds currentTime) const;
+        void save(core::snapshot::AiRecord& record) const { record.stateTime = digestStartTime_.count(); }
+        void restore(const core::snapshot::AiRecord& record) { digestStartTime_ = std::chrono::milliseconds(record.stateTime); }
 
     private:
         SandwormAI* ai_;
@@ -60,8 +92,17 @@ namespace dune::entity {
     class BurrowingState : public SandwormState {
     public:
         explicit BurrowingState(SandwormAI* ai) : ai_(ai), burrowStartTime_(std::chrono::milliseconds(0)) {}
-        void update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime) override;
-        std::wstring getStateName() const override { return L"Burrowing"; }
+        void update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime);
+        static constexpr SandwormStateKind KIND = SandwormStateKind::Burrowing;
+        std::chrono::milliseconds getNextUpdateTime(const Unit* sandworm, std::chrono::milliseconds currentTime) const;
+        void save(core::snapshot::AiRecord& record) const {
+            record.stateTime = burrowStartTime_.count();
+            record.stateTarget = core::snapshot::toRecord(burrowTarget_);
+        }
+        void restore(const core::snapshot::AiRecord& record) {
+            burrowStartTime_ = std::chrono::milliseconds(record.stateTime);
+            burrowTarget_ = core::snapshot::toPosition(record.stateTarget);
+        }
 
     private:
         SandwormAI* ai_;
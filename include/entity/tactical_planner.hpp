@@ -0,0 +1,74 @@
+#pragma once
+#include "utils/types.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace dune::core {
+    class Map;
+    class JobSystem;
+}
+
+namespace dune::entity::combat {
+    /**
+     * @brief 전술 계획기 설정입니다.
+     */
+    struct TacticalPlannerConfig {
+        types::Camp camp = types::Camp::Harkonnen;      // 계획기가 지휘할 진영
+        std::uint32_t interval = 50;                    // 계획 주기 (틱)
+        std::uint32_t rollouts = 1024;                  // 한 번의 계획에서 돌릴 롤아웃 수
+        bool deterministic = true;                      // true면 롤아웃 수만 제한해 같은 시드와 입력이면 같은 결정
+        std::chrono::microseconds timeBudget{ 4000 };   // deterministic이 false일 때 한 번의 계획에 쓸 실제 시간 상한
+        std::uint32_t horizon = 4000;                   // 롤아웃이 내다보는 게임 시간 (ms)
+        std::uint32_t trees = 8;                        // 병렬로 키우는 독립 탐색 트리 수
+    };
+
+    /**
+     * @brief 전술 계획기의 누적 통계입니다.
+     */
+    struct TacticalPlannerStats {
+        std::uint64_t decisions = 0;     // 계획한 횟수 (지휘할 유닛과 적이 모두 있었던 경우)
+        std::uint64_t rollouts = 0;      // 돌린 롤아웃 수
+        std::uint64_t commands = 0;      // 유닛에게 내린 명령 수
+        std::uint64_t budgetStops = 0;   // 시간 예산에 걸려 롤아웃을 덜 돌린 계획 수
+    };
+
+    /**
+     * @brief 한 진영의 전투 유닛을 몬테카를로 트리 탐색(MCTS)으로 지휘하는 계획기입니다.
+     *
+     * 계획할 때마다 전투에 필요한 상태(유닛 위치/체력/공격력/쿨다운, 지형과 건물의 점유)만
+     * 작은 배열로 떠 와서, 유닛마다 "그대로 두기 / 가까운 적 공격 / 본진으로 후퇴" 중 하나를 고르는
+     * 트리를 키우고 고정 길이의 롤아웃으로 교전 결과를 평가합니다. 트리는 서로 다른 난수열로
+     * 작업 풀에서 병렬로 키운 뒤 방문 수를 합쳐 결정하며, 고른 행동은 CombatUnitAI::attackCommand()와
+     * Map::orderMove()로 내립니다. (같은 본진으로 후퇴하는 유닛들은 흐름장을 공유합니다)
+     *
+     * 기본은 롤아웃 수(1024)만 제한하므로 결정이 시드와 틱으로 정해지고 스레드 수와 무관해, 계획기를 켠 경기도
+     * 같은 시드와 입력이면 다시 재현됩니다. (전투 유닛 십여 기에서 한 번의 계획이 단일 코어 약 8 ms)
+     * deterministic을 끄면 timeBudget으로 실제 시간을 제한하는 대신 기계 속도에 따라 결정이 달라져 재현되지 않습니다.
+     * 롤아웃은 실제 교전과 같은 사거리, 피해(CombatUnitState::getHealthAfterAttack()), 공격 간격(이동 쿨다운)을 씁니다.
+     */
+    class TacticalPlanner {
+    public:
+        explicit TacticalPlanner(const TacticalPlannerConfig& config);
+
+        const TacticalPlannerConfig& getConfig() const { return config_; }
+        const TacticalPlannerStats& getStats() const { return stats_; }
+
+        /**
+         * @brief 이번 틱이 계획할 틱인지 확인합니다.
+         */
+        bool isDue(std::uint64_t tick) const { return tick % config_.interval == 0; }
+
+        /**
+         * @brief 진영의 전투 유닛에게 다음 행동을 정해 명령을 내립니다. step() 사이에 불러야 합니다.
+         * @param map 유닛과 지형을 읽고 명령한 유닛을 깨울 맵.
+         * @param jobs 롤아웃을 나눠 돌릴 작업 풀.
+         * @param currentTime 현재 게임 시간 (쿨다운 계산과 탐색 난수 시드에 씁니다).
+         */
+        void plan(core::Map& map, core::JobSystem& jobs, std::chrono::milliseconds currentTime);
+
+    private:
+        TacticalPlannerConfig config_;
+        TacticalPlannerStats stats_;
+    };
+}
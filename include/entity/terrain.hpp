@@ -5,8 +5,24 @@
 
 namespace dune {
     namespace entity {
+        /**
+         * @brief 지형 타입 위에 건물을 건설할 수 있는지 확인합니다.
+         */
+        bool isBuildableTerrain(types::TerrainType type);
+
+        /**
+         * @brief 지형 타입을 유닛이 통과할 수 있는지 확인합니다.
+         */
+        bool isWalkableTerrain(types::TerrainType type);
+
+        /**
+         * @brief 지형 타입에서 스파이스를 채취할 수 있는지 확인합니다.
+         */
+        bool isHarvestableTerrain(types::TerrainType type);
+
         /**
          * @brief 지형을 나타내는 클래스입니다.
+         * 맵은 지형을 타입 배열로 저장하며, 이 클래스는 한 타일을 들여다보는 뷰로 사용됩니다.
          */
         class Terrain : public core::Entity {
         public:
@@ -1,16 +1,23 @@
 #pragma once
 #include "core/entity.hpp"
+#include "core/snapshot_format.hpp"
 #include "utils/types.hpp"
+#include "utils/random.hpp"
 #include "sandworm_ai.hpp"
 #include "harvester_ai.hpp"
 #include "combat_unit_ai.hpp"
 #include <memory>
 #include <chrono>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <variant>
+#include <vector>
 
 namespace dune {
     namespace core { class Map; }
     namespace entity { class SandwormAI; }
+    namespace managers { class UnitManager; }
 }
 
 namespace dune {
@@ -41,6 +48,20 @@ namespace dune {
              */
             Unit(types::UnitType type, types::Position position);
 
+            /**
+             * @brief 스냅샷 레코드로 유닛을 만듭니다. AI는 만들지 않으므로 모든 유닛을 맵에 넣은 뒤
+             * restoreAI()로 되살립니다. (다른 유닛을 가리키는 상태가 있기 때문입니다)
+             * @param record 저장된 유닛 레코드.
+             */
+            explicit Unit(const core::snapshot::UnitRecord& record);
+
+            /**
+             * @brief 능력치, 위치, 이동 시각을 레코드 값으로 되돌립니다. AI와 고유 번호는 그대로입니다.
+             * 맵 위의 유닛은 위치 인덱스도 함께 고쳐야 하므로 UnitManager::restoreUnits()를 거칩니다.
+             * @param record 저장된 유닛 레코드.
+             */
+            void restoreStats(const core::snapshot::UnitRecord& record);
+
             // Entity 인터페이스 구현
             wchar_t getRepresentation() const override;
             int getColor() const override;
@@ -62,6 +83,13 @@ namespace dune {
              */
             int getHealth() const { return health_; }
 
+            /**
+             * @brief 체력을 정합니다. 공격으로 깎이는 양은 CombatUnitState::getHealthAfterAttack()이 정합니다.
+             * 맵에 있는 유닛은 체크포인트에 기록되도록 Map::setUnitHealth()를 거쳐 바꿉니다.
+             * @param health 새 체력 값.
+             */
+            void setHealth(int health) { health_ = health; }
+
             /**
              * @brief 유닛의 공격력을 반환합니다.
              * @return int 공격력 값.
@@ -94,8 +122,23 @@ namespace dune {
              */
             void updateLastMoveTime(std::chrono::milliseconds currentTime);
 
+            /**
+             * @brief 이동 쿨다운이 끝나는 시간을 반환합니다.
+             * @return std::chrono::milliseconds 다음으로 이동할 수 있는 시간.
+             */
+            std::chrono::milliseconds getNextMoveTime() const {
+                return lastMoveTime_ + std::chrono::milliseconds(speed_);
+            }
+
+            /**
+             * @brief 맵에 추가될 때 UnitManager가 부여한 고유 번호를 반환합니다.
+             * 칸 번호와 달리 유닛이 제거되어도 다른 유닛에 재사용되지 않습니다.
+             */
+            std::uint32_t getId() const { return id_; }
+
             /**
              * @brief 유닛을 지정한 위치로 이동시킵니다.
+             * 위치 인덱스는 갱신하지 않으므로 맵 위의 유닛은 core::Map::moveUnit()으로 이동해야 합니다.
              * @param newPosition 이동할 위치.
              */
             void moveTo(const types::Position& newPosition) { position_ = newPosition; }
@@ -129,33 +172,57 @@ namespace dune {
 
             /**
              * @brief 샌드웜이 스파이스를 배출해야 하는지 확인합니다.
+             * @param random 배설 판정에 쓸 난수 생성기.
              * @return true 배출해야 하면 true.
              * @return false 그렇지 않으면 false.
              */
-            bool shouldExcrete() const;
+            bool shouldExcrete(utils::Xoshiro256& random) const;
 
             void initializeHarvesterAttributes();
 
+            /**
+             * @brief 유닛 타입에 맞는 AI를 (다시) 생성합니다. 기존 AI와 그 상태는 버려집니다.
+             */
             void initializeAI() {
                 if (type_ == types::UnitType::Sandworm) {
-                    sandworm_ai_ = std::make_unique<SandwormAI>();
+                    ai_.emplace<SandwormAI>();
                 }
                 else if (type_ == types::UnitType::Harvester) {
-                    harvester_ai_ = std::make_unique<HarvesterAI>(position_);
+                    ai_.emplace<HarvesterAI>(position_);
                 }
                 else if (
                     type_ == types::UnitType::Soldier ||
                     type_ == types::UnitType::Fremen ||
                     type_ == types::UnitType::Fighter ||
                     type_ == types::UnitType::HeavyTank) {
-                    combat_unit_ai_ = std::make_unique<combat::CombatUnitAI>(this);
+                    ai_.emplace<combat::CombatUnitAI>(this);
                 }
             }
-            SandwormAI* getSandwormAI() { return sandworm_ai_.get(); }
-            HarvesterAI* getHarvesterAI() { return harvester_ai_.get(); }
-            combat::CombatUnitAI* getCombatUnitAI() { return combat_unit_ai_.get(); }
+            SandwormAI* getSandwormAI() { return std::get_if<SandwormAI>(&ai_); }
+            HarvesterAI* getHarvesterAI() { return std::get_if<HarvesterAI>(&ai_); }
+            combat::CombatUnitAI* getCombatUnitAI() { return std::get_if<combat::CombatUnitAI>(&ai_); }
+            const combat::CombatUnitAI* getCombatUnitAI() const { return std::get_if<combat::CombatUnitAI>(&ai_); }
             void update(core::Map& map, std::chrono::milliseconds currentTime);
 
+            /**
+             * @brief 능력치, 위치, AI와 현재 상태를 스냅샷 레코드에 기록합니다.
+             * @param record 채울 레코드 (예약된 깨우기 틱은 맵이 채웁니다).
+             * @param positions 경로를 이어 붙일 공유 위치 배열.
+             * @param ids 맵에 있는 유닛의 고유 번호 (타겟을 번호로 바꿀 때 사용).
+             */
+            void save(core::snapshot::UnitRecord& record, std::vector<core::snapshot::PositionRecord>& positions,
+                const core::snapshot::UnitIds& ids) const;
+
+            /**
+             * @brief 레코드의 AI와 현재 상태를 되살립니다.
+             * @param record 저장된 AI 레코드.
+             * @param positions 공유 위치 배열.
+             * @param units 타겟 번호를 유닛으로 바꿀 때 쓰는 유닛 관리자.
+             * @return false AI나 상태 종류가 유닛 타입과 맞지 않거나 경로가 위치 배열을 벗어난 경우.
+             */
+            bool restoreAI(const core::snapshot::AiRecord& record, std::span<const core::snapshot::PositionRecord> positions,
+                const managers::UnitManager& units);
+
         private:
             types::Camp camp_;
             types::UnitType type_;
@@ -168,9 +235,15 @@ namespace dune {
             types::Position position_;
             int length_ = 1;  // 샌드웜 길이
             std::chrono::milliseconds lastMoveTime_{ 0 };
-            std::unique_ptr<SandwormAI> sandworm_ai_;
-            std::unique_ptr<HarvesterAI> harvester_ai_;
-            std::unique_ptr<combat::CombatUnitAI> combat_unit_ai_;
+
+            // 유닛 종류별로 하나만 쓰이므로 별도 할당 없이 유닛 안에 직접 둡니다.
+            // 상태 객체가 AI 주소를 보관하므로 유닛은 생성된 뒤 이동하지 않아야 합니다.
+            std::variant<std::monostate, SandwormAI, HarvesterAI, combat::CombatUnitAI> ai_;
+
+            // UnitManager의 유닛 리스트에서 이 유닛이 차지하는 칸 (UnitManager가 관리)
+            std::size_t slot_ = 0;
+            std::uint32_t id_ = 0;
+            friend class managers::UnitManager;
         };
     } // namespace entity
 } // namespace dune
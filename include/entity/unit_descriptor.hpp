@@ -0,0 +1,54 @@
+#pragma once
+#include "../utils/types.hpp"
+#include <array>
+#include <cstddef>
+
+namespace dune {
+    namespace entity {
+
+        /**
+         * @brief 유닛 종류 하나의 고정 정보입니다.
+         * 생산 조건(비용, 인구, 배치 거리)은 Simulation::produceUnit()이, 이름은 메시지가 이 표에서 읽습니다.
+         */
+        struct UnitDescriptor {
+            types::UnitType type;
+            const wchar_t* name;
+            int cost;               // 생산 비용 (스파이스)
+            int population;         // 차지하는 인구
+            int maxDistance;        // 생산 건물에서 배치 위치까지 최대 맨해튼 거리 (생산할 수 없으면 0)
+        };
+
+        /**
+         * @brief 유닛 종류별 고정 정보 표입니다. types::UnitType 값이 곧 인덱스입니다.
+         */
+        inline constexpr std::array<UnitDescriptor, 9> UNIT_DESCRIPTORS = { {
+            { types::UnitType::None,        L"Unit",         0, 0,  0 },
+            { types::UnitType::Harvester,   L"Harvester",    5, 5, 10 },
+            { types::UnitType::Fremen,      L"Fremen",       5, 2, 20 },
+            { types::UnitType::Soldier,     L"Soldier",      1, 1, 20 },
+            { types::UnitType::Fighter,     L"Fighter",      1, 1, 20 },
+            { types::UnitType::HeavyTank,   L"Heavy Tank",  12, 5, 10 },
+            { types::UnitType::Sandworm,    L"Sandworm",     0, 0,  0 },
+            { types::UnitType::DesertEagle, L"Desert Eagle", 0, 0,  0 },
+            { types::UnitType::Sandstorm,   L"Sandstorm",    0, 0,  0 },
+        } };
+
+        /**
+         * @brief 유닛 종류의 고정 정보를 반환합니다.
+         */
+        constexpr const UnitDescriptor& getUnitDescriptor(types::UnitType type) {
+            return UNIT_DESCRIPTORS[static_cast<std::size_t>(type)];
+        }
+
+        // 표의 순서가 enum과 어긋나거나 enum에 새 값이 생겼는데 표에 없으면 컴파일 단계에서 잡습니다.
+        static_assert([] {
+            for (std::size_t i = 0; i < UNIT_DESCRIPTORS.size(); ++i) {
+                if (static_cast<std::size_t>(UNIT_DESCRIPTORS[i].type) != i) return false;
+            }
+            return true;
+        }(), "UNIT_DESCRIPTORS must be ordered by types::UnitType");
+        static_assert(static_cast<std::size_t>(types::UnitType::Sandstorm) + 1 == UNIT_DESCRIPTORS.size(),
+            "UNIT_DESCRIPTORS must cover every types::UnitType");
+
+    } // namespace entity
+} // namespace dune
@@ -3,21 +3,41 @@
 #include "../utils/types.hpp"
 #include "terrain_manager.hpp"
 #include "entity/building.hpp"
+#include "core/occupancy_grid.hpp"
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
+#include <functional>
 
 namespace dune {
     namespace managers {
 
         /**
          * @brief 게임 내 건물을 관리하는 클래스입니다.
+         *
+         * 타일마다 그 위에 있는 건물의 id를 기록하는 격자를 유지하므로
+         * getBuildingAt()은 건물 수와 무관하게 상수 시간에 동작합니다.
          */
         class BuildingManager {
         public:
 
             using Building = dune::entity::Building;
 
+            /**
+             * @brief 건물이 추가되거나 제거될 때 해당 건물을 전달받는 콜백 타입입니다.
+             * 콜백은 변경이 목록에 반영된 뒤 호출됩니다.
+             */
+            using ChangeHandler = std::function<void(const Building&)>;
+
+            /**
+             * @brief BuildingManager 클래스의 생성자입니다.
+             * @param width 맵의 가로 크기.
+             * @param height 맵의 세로 크기.
+             */
+            BuildingManager(int width, int height);
+
             /**
              * @brief 건물을 추가합니다.
              * @param building 추가할 건물의 unique_ptr.
@@ -55,8 +75,53 @@ namespace dune {
              */
             void removeDestroyedBuildings();
 
+            /**
+             * @brief 건물이 추가되거나 제거될 때 호출할 콜백을 설정합니다.
+             * @param handler 추가/제거되는 건물을 전달받는 콜백.
+             */
+            void setChangeHandler(ChangeHandler handler);
+
+            /**
+             * @brief 건물 영역을 기록할 점유 맵을 연결하고 현재 건물을 반영합니다.
+             * @param occupancy 갱신할 점유 맵 (nullptr이면 연결 해제).
+             */
+            void attachOccupancy(core::OccupancyGrid* occupancy);
+
         private:
+            static constexpr std::uint32_t NO_BUILDING = 0;
+
             std::vector<std::unique_ptr<Building>> buildings_;
+            ChangeHandler changeHandler_;
+
+            int width_;
+            int height_;
+            std::vector<std::uint32_t> tileIds_;     // 타일별 건물 id (NO_BUILDING이면 비어 있음)
+            std::vector<Building*> slots_;           // id - 1 → 건물 (제거된 id는 nullptr)
+            std::vector<std::uint32_t> freeIds_;     // 재사용할 id
+            std::unordered_map<const Building*, std::uint32_t> ids_;  // 건물 → id
+            core::OccupancyGrid* occupancy_ = nullptr;  // 건물 영역을 기록하는 점유 맵 (Map이 소유)
+
+            /**
+             * @brief 건물 영역을 점유 맵에 표시하거나 지웁니다.
+             */
+            void markOccupancy(const Building& building, bool occupied);
+
+            /**
+             * @brief 건물 영역 중 비어 있는 타일에 id를 기록합니다.
+             * 겹친 타일은 먼저 추가된 건물이 유지됩니다.
+             */
+            void stampTiles(const Building& building, std::uint32_t id);
+
+            /**
+             * @brief 제거되는 건물의 id를 격자에서 지우고 반납합니다.
+             */
+            void releaseTiles(const Building& building);
+
+            /**
+             * @brief 조건에 맞는 건물을 순서를 유지한 채 제거하고 콜백으로 알립니다.
+             */
+            template<typename Predicate>
+            void removeIf(Predicate predicate);
         };
 
     } // namespace managers
@@ -2,19 +2,33 @@
 #include "../core/entity.hpp"
 #include "../utils/types.hpp"
 #include "entity/terrain.hpp"
+#include "core/occupancy_grid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
+#include <functional>
 
 namespace dune {
     namespace managers {
 
         /**
          * @brief 게임 맵 전체의 지형 정보를 관리하는 클래스입니다.
+         *
+         * 지형 타입은 행 우선 순서의 연속된 바이트 배열에 저장하고,
+         * 통과/건설/채취 가능 여부는 타일당 1비트의 비트셋으로 따로 유지합니다.
+         * Terrain 객체는 getTerrain() 호출 시 만들어지는 뷰입니다.
          */
         class TerrainManager {
         public:
 
             using Terrain = dune::entity::Terrain;
 
+            /**
+             * @brief 지형이 바뀐 위치를 전달받는 콜백 타입입니다.
+             */
+            using ChangeHandler = std::function<void(const types::Position&)>;
+
             /**
              * @brief TerrainManager 클래스의 생성자입니다.
              * @param width 맵의 가로 크기.
@@ -25,9 +39,51 @@ namespace dune {
             /**
              * @brief 특정 위치의 지형 정보를 반환합니다.
              * @param position 확인할 위치.
-             * @return const Terrain& 해당 위치의 지형 객체.
+             * @return Terrain 해당 위치의 지형 뷰 (범위 밖이면 Empty).
+             */
+            Terrain getTerrain(const types::Position& position) const;
+
+            /**
+             * @brief 특정 위치의 지형 타입을 반환합니다.
+             * @param position 확인할 위치.
+             * @return types::TerrainType 지형 타입 (범위 밖이면 Empty).
+             */
+            types::TerrainType getType(const types::Position& position) const;
+
+            /**
+             * @brief 특정 위치를 유닛이 통과할 수 있는지 확인합니다.
+             * @param position 확인할 위치.
+             * @return true 통과 가능하면 true (범위 밖이면 false).
+             */
+            bool isWalkable(const types::Position& position) const;
+
+            /**
+             * @brief 특정 위치에 건물을 건설할 수 있는지 확인합니다.
+             * @param position 확인할 위치.
+             * @return true 건설 가능하면 true (범위 밖이면 false).
              */
-            const Terrain& getTerrain(const types::Position& position) const;
+            bool isBuildable(const types::Position& position) const;
+
+            /**
+             * @brief 특정 위치에서 스파이스를 채취할 수 있는지 확인합니다.
+             * @param position 확인할 위치.
+             * @return true 채취 가능하면 true (범위 밖이면 false).
+             */
+            bool canHarvestSpice(const types::Position& position) const;
+
+            /**
+             * @brief 행 우선 인덱스(row * width + column)로 통과 가능 여부를 확인합니다.
+             * 범위 검사를 하지 않으므로 호출자가 인덱스를 보장해야 합니다.
+             * @param index 타일 인덱스.
+             * @return true 통과 가능하면 true.
+             */
+            bool isWalkableAt(std::size_t index) const { return testBit(walkable_, index); }
+
+            /**
+             * @brief 행 우선 순서의 지형 타입 배열을 반환합니다.
+             * @return const std::vector<std::uint8_t>& width * height 크기의 타입 배열.
+             */
+            const std::vector<std::uint8_t>& getTiles() const { return tiles_; }
 
             /**
              * @brief 특정 위치의 지형 타입을 설정합니다.
@@ -36,6 +92,27 @@ namespace dune {
              */
             void setTerrain(const types::Position& position, types::TerrainType type);
 
+            /**
+             * @brief setTerrain()으로 지형이 바뀔 때 호출할 콜백을 설정합니다.
+             * @param handler 바뀐 위치를 전달받는 콜백.
+             */
+            void setChangeHandler(ChangeHandler handler);
+
+            /**
+             * @brief 행 우선 지형 타입 배열로 지형을 되돌립니다. (스냅샷/체크포인트 복원용)
+             * 값이 다른 타일만 setTerrain()과 같이 고치고 변경 콜백을 부르므로,
+             * 지형에 의존하는 캐시는 바뀐 타일만큼만 폐기됩니다.
+             * @param tiles width * height개의 지형 타입.
+             * @return false 타입 값이 범위를 벗어난 타일이 있는 경우 (지형은 바뀌지 않습니다).
+             */
+            bool loadTiles(std::span<const std::uint8_t> tiles);
+
+            /**
+             * @brief 통과할 수 없는 지형을 기록할 점유 맵을 연결하고 현재 지형을 반영합니다.
+             * @param occupancy 갱신할 점유 맵 (nullptr이면 연결 해제).
+             */
+            void attachOccupancy(core::OccupancyGrid* occupancy);
+
             /**
              * @brief 위치가 맵 범위 내의 유효한 위치인지 확인합니다.
              * @param position 확인할 위치.
@@ -44,10 +121,32 @@ namespace dune {
              */
             bool isValidPosition(const types::Position& position) const;
 
+            int getWidth() const { return width_; }
+            int getHeight() const { return height_; }
+
         private:
+            using Bitset = std::vector<std::uint64_t>;
+
+            static bool testBit(const Bitset& bits, std::size_t index) {
+                return (bits[index >> 6] >> (index & 63)) & 1u;
+            }
+            static void assignBit(Bitset& bits, std::size_t index, bool value);
+
+            std::size_t indexOf(const types::Position& position) const {
+                return static_cast<std::size_t>(position.row) * width_ + position.column;
+            }
+
+            // 타입 배열과 속성 비트셋을 함께 갱신합니다.
+            void storeTile(std::size_t index, types::TerrainType type);
+
             int width_;
             int height_;
-            std::vector<std::vector<Terrain>> terrainMap_;
+            std::vector<std::uint8_t> tiles_;   // 행 우선 지형 타입
+            Bitset walkable_;                   // 통과 가능 타일
+            Bitset buildable_;                  // 건설 가능 타일
+            Bitset harvestable_;                // 스파이스 채취 가능 타일
+            ChangeHandler changeHandler_;
+            core::OccupancyGrid* occupancy_ = nullptr;
         };
 
     } // namespace managers
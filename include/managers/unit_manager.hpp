@@ -2,21 +2,37 @@
 #include "../core/entity.hpp"
 #include "../utils/types.hpp"
 #include "entity/unit.hpp"
-#include "spatial/quad_tree.hpp"
+#include "spatial/spatial_index.hpp"
+#include "core/occupancy_grid.hpp"
 #include <memory>
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
 #include <chrono>
 
 namespace dune {
     namespace managers {
         /**
          * @brief 게임 내 모든 유닛을 관리하는 클래스입니다.
+         *
+         * 유닛은 추가된 순서대로 칸(slot)에 두고, 제거된 유닛은 생존 표시만 내린 뒤 collectRemovedUnits()에서
+         * 칸을 당겨 해제합니다. 유닛 정보는 Unit 객체 한 곳에만 있고, 고유 번호로는 칸을 바로 찾습니다.
+         * 위치로 유닛을 찾는 인덱스는 타일마다 유닛 포인터를 두는 격자입니다.
          */
         class UnitManager {
         public:
             using Unit = dune::entity::Unit;
 
-            UnitManager();
+            /**
+             * @brief UnitManager 클래스의 생성자입니다.
+             * @param width 맵의 가로 크기.
+             * @param height 맵의 세로 크기.
+             * @param indexType 이웃 검색에 사용할 공간 인덱스 구현.
+             */
+            UnitManager(int width, int height,
+                spatial::SpatialIndexType indexType = spatial::SpatialIndexType::UniformGrid);
+
             /**
              * @brief 유닛을 추가합니다.
              * @param unit 추가할 유닛의 unique_ptr.
@@ -31,28 +47,134 @@ namespace dune {
             Unit* getUnitAt(const types::Position& position);
             const Unit* getUnitAt(const types::Position& position) const;
 
+            /**
+             * @brief 유닛을 새 위치로 옮기고 위치 인덱스와 공간 인덱스를 함께 갱신합니다.
+             * @param unit 이동할 유닛의 포인터.
+             * @param newPosition 이동할 위치.
+             * @return true 이동 성공, false 관리되지 않는 유닛이거나 대상 위치에 다른 유닛이 있는 경우.
+             */
+            bool relocate(Unit* unit, const types::Position& newPosition);
+
             /**
              * @brief 특정 유닛을 제거합니다.
+             * 위치 인덱스와 공간 인덱스에서는 즉시 제거되며, 유닛 객체는 collectRemovedUnits()에서 해제됩니다.
              * @param unit 제거할 유닛의 포인터.
              */
             void removeUnit(Unit* unit);
 
+            /**
+             * @brief 유닛이 아직 맵에 존재하는지(제거되지 않았는지) 확인합니다.
+             * @param unit 확인할 유닛의 포인터.
+             * @return true 존재하면 true.
+             */
+            bool isActive(const Unit* unit) const;
+
+            /**
+             * @brief removeUnit()으로 제거된 유닛 객체를 실제로 해제합니다.
+             */
+            void collectRemovedUnits();
+
+            /**
+             * @brief removeUnit()으로 제거했지만 아직 해제하지 않은 유닛이 있는지 확인합니다.
+             */
+            bool hasRemovedUnits() const { return hasRemovedUnits_; }
 
-            using UnitMap = std::unordered_map<types::Position, std::unique_ptr<Unit>>;
             /**
              * @brief 현재 존재하는 모든 유닛을 반환합니다.
-             * @return unitsByPosition_에 대한 const 참조.
+             * @return const std::vector<std::unique_ptr<Unit>>& 유닛 리스트 (추가된 순서).
+             */
+            const std::vector<std::unique_ptr<Unit>>& getUnits() const;
+
+            // 칸 접근자 (칸 번호는 getUnits()의 인덱스와 같고 collectRemovedUnits() 후 다시 채워집니다)
+
+            std::size_t getSlotCount() const { return units_.size(); }
+            Unit* getUnitInSlot(std::size_t slot) const { return units_[slot].get(); }
+            bool isSlotActive(std::size_t slot) const { return active_[slot] != 0; }
+
+            static constexpr std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
+            /**
+             * @brief 유닛 고유 번호(Unit::getId())로 현재 칸 번호를 찾습니다.
+             * @param id 유닛 고유 번호.
+             * @return std::size_t 칸 번호 (해제된 유닛이면 NO_SLOT).
              */
-            const UnitMap& getUnits() const;
+            std::size_t getSlotOfId(std::uint32_t id) const {
+                return id < slotById_.size() ? slotById_[id] : NO_SLOT;
+            }
 
-            const dune::spatial::QuadTree& getQuadTree() const { return quadTree_; }
+            /**
+             * @brief 지금까지 부여한 고유 번호 수를 반환합니다. (번호는 0부터 연속)
+             */
+            std::uint32_t getIdCount() const { return static_cast<std::uint32_t>(slotById_.size()); }
+
+            /**
+             * @brief 고유 번호로 맵에 있는 유닛을 찾습니다.
+             * @param id 유닛 고유 번호.
+             * @return Unit* 유닛 (해제되었거나 제거된 유닛이면 nullptr).
+             */
+            Unit* findUnitById(std::uint32_t id) const {
+                const std::size_t slot = getSlotOfId(id);
+                return slot != NO_SLOT && active_[slot] ? units_[slot].get() : nullptr;
+            }
+
+            /**
+             * @brief 유닛을 레코드의 상태로 되돌립니다. (스냅샷 읽기와 체크포인트 복원용)
+             * 번호가 idCount 이상인 유닛은 제거하고, 레코드의 유닛은 같은 객체에 능력치와 위치를 다시 쓰거나
+             * 이미 해제되었으면 새로 만들어 번호 순 칸에 끼워 넣습니다. 레코드에 없는 유닛은 건드리지 않으므로
+             * 비용은 레코드 수에 비례합니다. (해제된 유닛을 끼워 넣을 때만 칸 번호를 한 번 다시 매깁니다)
+             * AI는 되살리지 않으므로 이어서 restored의 유닛마다 Unit::restoreAI()를 불러야 합니다.
+             * @param records 고유 번호 오름차순의 유닛 레코드.
+             * @param idCount 되돌릴 시점까지 부여한 고유 번호 수.
+             * @param restored records와 같은 순서로 되돌린 유닛을 채웁니다.
+             * @return false 번호가 오름차순이 아니거나 idCount를 넘는 경우 (아무것도 바꾸지 않습니다).
+             */
+            bool restoreUnits(std::span<const core::snapshot::UnitRecord> records, std::uint32_t idCount,
+                std::vector<Unit*>& restored);
+
+            const dune::spatial::SpatialIndex& getSpatialIndex() const { return *spatialIndex_; }
+
+            /**
+             * @brief 유닛 위치를 기록할 점유 맵을 연결하고 현재 유닛 위치를 반영합니다.
+             * @param occupancy 갱신할 점유 맵 (nullptr이면 연결 해제).
+             */
+            void attachOccupancy(core::OccupancyGrid* occupancy);
 
         private:
-            // 위치를 키로 하여 유닛을 관리합니다.
-            UnitMap unitsByPosition_;
+            // 위치 인덱스, 공간 인덱스, 점유 맵에서 유닛을 떼거나 현재 위치로 다시 붙입니다.
+            void detach(Unit* unit);
+            void attach(Unit* unit);
+
+            bool isInside(const types::Position& position) const {
+                return position.row >= 0 && position.row < height_ &&
+                    position.column >= 0 && position.column < width_;
+            }
+            std::size_t tileOf(const types::Position& position) const {
+                return static_cast<std::size_t>(position.row) * width_ + position.column;
+            }
+
+            int width_;
+            int height_;
+
+            // 유닛 소유 리스트 (추가된 순서를 유지합니다)
+            std::vector<std::unique_ptr<Unit>> units_;
+
+            // units_와 같은 칸 번호를 쓰는 생존 표시
+            std::vector<std::uint8_t> active_;  // removeUnit() 후 0 (해제는 collectRemovedUnits()에서)
+
+            // 고유 번호 → 칸 번호 (해제된 유닛은 NO_SLOT)
+            std::vector<std::size_t> slotById_;
+
+            // 타일별 유닛 (행 우선, 비어 있으면 nullptr)
+            std::vector<Unit*> tileUnits_;
+
+            // 제거 예정인 유닛이 있는지 (업데이트 중 반복자 무효화를 피하기 위해 지연 해제)
+            bool hasRemovedUnits_ = false;
+
+            // 맵 전체를 커버하는 공간 인덱스 (쿼드트리 또는 균일 격자)
+            std::unique_ptr<dune::spatial::SpatialIndex> spatialIndex_;
 
-            // 맵 전체를 커버하는 루트 노드
-            dune::spatial::QuadTree quadTree_;
+            // 유닛이 서 있는 타일을 기록하는 점유 맵 (Map이 소유)
+            core::OccupancyGrid* occupancy_ = nullptr;
         };
 
     } // namespace managers
@@ -0,0 +1,113 @@
+#pragma once
+#include "utils/types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace dune {
+    namespace core { class Map; }
+
+    namespace pathfinding {
+
+        /**
+         * @brief 계층적 경로 탐색(HPA*)용 클러스터 추상 그래프입니다.
+         * 맵을 고정 크기 클러스터로 나누고, 이웃 클러스터 경계의 통행 가능한 구간마다 입구(entrance) 노드를 두며,
+         * 같은 클러스터 안의 입구 사이 이동 비용을 미리 계산해 둡니다.
+         * 통행 여부는 지형(바위)과 건물만 반영하고, 계속 움직이는 유닛은 구체화 단계의 A*에 맡깁니다.
+         * 지형/건물이 바뀌면 해당 클러스터만 더럽게 표시했다가 다음 탐색 때 그 클러스터와 이웃만 다시 만듭니다.
+         */
+        class ClusterGraph {
+        public:
+            /**
+             * @brief 생성자
+             * @param clusterSize 클러스터 한 변의 길이 (타일 단위)
+             */
+            explicit ClusterGraph(int clusterSize = DEFAULT_CLUSTER_SIZE);
+
+            /**
+             * @brief 추상 그래프에서 start에서 goal까지의 경유지 목록을 찾습니다.
+             * 경유지는 goal이 맨 앞, 다음 경유지가 맨 뒤에 오며, 각 구간은 호출자가 필요할 때 A*로 구체화합니다.
+             * @param map 탐색할 맵.
+             * @param start 시작 위치.
+             * @param goal 목표 위치.
+             * @param waypoints 결과 경유지를 담을 버퍼 (기존 내용은 지워집니다).
+             * @return true 경로가 있는 경우.
+             */
+            bool findRoute(
+                const core::Map& map,
+                const types::Position& start,
+                const types::Position& goal,
+                std::vector<types::Position>& waypoints);
+
+            /**
+             * @brief 지정한 영역과 겹치는 클러스터를 다시 만들도록 표시합니다.
+             * @param origin 영역의 왼쪽 위 위치.
+             * @param width 영역의 너비.
+             * @param height 영역의 높이.
+             */
+            void markDirty(const types::Position& origin, int width, int height);
+
+            static constexpr int DEFAULT_CLUSTER_SIZE = 16;
+
+        private:
+            struct Cluster {
+                int minRow, minColumn, maxRow, maxColumn;  // 클러스터가 덮는 타일 범위 (양 끝 포함)
+                std::vector<int> entrances;                 // 입구 타일 인덱스
+                std::vector<int> costs;                     // 입구 사이 이동 비용 (entrances.size()^2, 도달 불가 -1)
+                bool dirty = false;
+            };
+
+            struct OpenEntry {
+                int fCost;
+                int index;
+            };
+
+            int clusterSize_;
+            int width_ = 0;
+            int height_ = 0;
+            int clusterColumns_ = 0;
+            int clusterRows_ = 0;
+            bool built_ = false;
+            bool anyDirty_ = false;
+
+            std::vector<Cluster> clusters_;
+            // 세로 경계 (cx, cy)|(cx + 1, cy) 의 입구: 왼쪽 타일 인덱스 (짝은 +1)
+            std::vector<std::vector<int>> verticalBorders_;
+            // 가로 경계 (cx, cy)/(cx, cy + 1) 의 입구: 위쪽 타일 인덱스 (짝은 +width)
+            std::vector<std::vector<int>> horizontalBorders_;
+
+            std::vector<std::uint8_t> blocked_;  // 지형/건물로 막힌 타일
+            std::vector<int> localIndex_;        // 타일이 속한 클러스터의 입구 번호 (입구가 아니면 -1)
+
+            // 탐색 버퍼 (세대 번호로 유효성 표시)
+            std::uint32_t generation_ = 0;
+            std::vector<std::uint32_t> bfsStamp_;
+            std::vector<int> bfsDistance_;
+            std::vector<int> bfsQueue_;
+            std::vector<std::uint32_t> openStamp_;
+            std::vector<std::uint32_t> closedStamp_;
+            std::vector<int> gCost_;
+            std::vector<int> parent_;
+            std::vector<OpenEntry> openHeap_;
+            std::vector<int> startDistance_;
+            std::vector<int> goalDistance_;
+
+            void build(const core::Map& map);
+            void rebuildDirty(const core::Map& map);
+            void refreshBlocked(const core::Map& map, const Cluster& cluster);
+            void buildVerticalBorder(int cx, int cy);
+            void buildHorizontalBorder(int cx, int cy);
+            void rebuildCluster(int clusterIndex);
+
+            /**
+             * @brief 클러스터 안에서 source로부터의 최단 거리를 bfsDistance_에 기록합니다.
+             * 결과는 bfsStamp_ == generation_ 인 타일에서만 유효합니다.
+             */
+            void searchCluster(const Cluster& cluster, int source);
+            void nextGeneration();
+
+            int clusterOf(int index) const;
+            void relax(int index, int gCost, int parent, int goalIndex);
+        };
+
+    } // namespace pathfinding
+} // namespace dune
@@ -0,0 +1,124 @@
+#pragma once
+#include "utils/types.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace dune {
+    namespace core { class Map; }
+
+    namespace pathfinding {
+
+        /**
+         * @brief 하나의 목표를 향한 흐름장(flow field)입니다.
+         * 목표에서 시작하는 한 번의 BFS로 모든 타일의 목표까지 거리와 다음 이동 방향을 구해 두므로,
+         * 같은 목표로 가는 유닛은 틱마다 자기 타일의 방향만 읽어 O(1)로 이동합니다.
+         * 통행 여부는 지형(바위)과 건물만 반영하고, 유닛은 이동할 때 확인합니다.
+         */
+        class FlowField {
+        public:
+            /**
+             * @brief 맵의 현재 지형/건물로 흐름장을 계산합니다.
+             * @param map 대상 맵.
+             * @param goal 목표 위치.
+             */
+            FlowField(const core::Map& map, const types::Position& goal);
+
+            const types::Position& getGoal() const { return goal_; }
+
+            /**
+             * @brief 목표까지의 거리를 반환합니다.
+             * @return int 거리 (맵 밖이거나 도달할 수 없으면 -1).
+             */
+            int getDistance(const types::Position& position) const;
+
+            /**
+             * @brief 해당 위치에서 목표에 도달할 수 있는지 확인합니다.
+             */
+            bool isReachable(const types::Position& position) const { return getDistance(position) >= 0; }
+
+            /**
+             * @brief from에서 목표에 한 칸 가까워지는 다음 위치를 구합니다.
+             * 기본 방향이 유닛으로 막혀 있으면 거리가 같이 줄어드는 다른 방향을 시도합니다.
+             * @param map 유닛 점유를 확인할 맵.
+             * @param from 현재 위치.
+             * @param next 다음 위치를 받을 변수.
+             * @return true 이동할 수 있는 칸이 있는 경우.
+             */
+            bool nextStep(const core::Map& map, const types::Position& from, types::Position& next) const;
+
+            /**
+             * @brief from에서 목표에 한 칸 가까워지는 이웃 타일들을 구합니다. (유닛 점유와 무관)
+             * @param from 현재 위치.
+             * @param neighbors 결과를 담을 배열.
+             * @return int 결과 개수.
+             */
+            int getCloserNeighbors(const types::Position& from, std::array<types::Position, 4>& neighbors) const;
+
+            /**
+             * @brief 지형/건물 변경으로 다시 계산해야 하는지 확인합니다.
+             */
+            bool isStale() const { return stale_; }
+
+            /**
+             * @brief 해당 타일의 통행 여부가 바뀌었을 때 이 흐름장이 영향을 받는지 확인합니다.
+             * @param blockedNow 타일이 지금 막혀 있는지 여부.
+             */
+            bool isAffectedBy(const types::Position& position, bool blockedNow) const;
+
+            void markStale() { stale_ = true; }
+
+            static constexpr std::uint8_t NO_DIRECTION = 0xFF;
+
+        private:
+            int width_;
+            int height_;
+            types::Position goal_;
+            bool stale_ = false;
+            std::vector<int> distance_;            // 목표까지의 거리 (도달 불가 -1)
+            std::vector<std::uint8_t> direction_;  // 거리를 줄이는 방향 (없으면 NO_DIRECTION)
+        };
+
+        /**
+         * @brief 목표별 흐름장 캐시입니다.
+         * 흐름장은 shared_ptr로 나눠 주고 캐시는 weak_ptr만 보관하므로, 참조하는 유닛이 없어지면 즉시 해제됩니다.
+         */
+        class FlowFieldCache {
+        public:
+            /**
+             * @brief 목표에 대한 흐름장을 반환합니다. 살아 있는 최신 흐름장이 없으면 새로 계산합니다.
+             */
+            std::shared_ptr<const FlowField> acquire(const core::Map& map, const types::Position& goal);
+
+            /**
+             * @brief 통행 여부가 바뀔 수 있는 타일을 알립니다. 영향을 받는 흐름장은 오래된 것으로 표시됩니다.
+             * @param map 변경이 반영된 맵.
+             * @param origin 영역의 왼쪽 위 위치.
+             * @param width 영역의 너비.
+             * @param height 영역의 높이.
+             */
+            void invalidateArea(const core::Map& map, const types::Position& origin, int width, int height);
+
+            /**
+             * @brief 현재 유닛이 참조하고 있는 흐름장 수를 반환합니다.
+             */
+            size_t getLiveFieldCount() const;
+
+            std::uint64_t getBuildCount() const { return buildCount_; }
+
+        private:
+            std::unordered_map<types::Position, std::weak_ptr<FlowField>> fields_;
+            std::uint64_t buildCount_ = 0;
+
+            void pruneExpired();
+        };
+
+        /**
+         * @brief 지형과 건물만 고려했을 때 타일이 막혀 있는지 확인합니다.
+         */
+        bool isStaticallyBlocked(const core::Map& map, const types::Position& position);
+
+    } // namespace pathfinding
+} // namespace dune
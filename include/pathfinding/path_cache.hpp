@@ -0,0 +1,171 @@
+#pragma once
+#include "pathfinder.hpp"
+#include "utils/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dune {
+    namespace core { class Map; }
+
+    namespace pathfinding {
+
+        /**
+         * @brief 경로 캐시를 나누는 이동 종류입니다.
+         * 지금은 모든 종류가 같은 통행 규칙을 쓰지만, 규칙이 달라져도 서로의 경로를 재사용하지 않도록 키에 포함합니다.
+         */
+        enum class MovementClass {
+            Ground,
+            Sandworm
+        };
+
+        /**
+         * @brief 유닛 타입에 해당하는 이동 종류를 반환합니다.
+         */
+        MovementClass movementClassOf(types::UnitType type);
+
+        /**
+         * @brief 경로 캐시 통계입니다.
+         */
+        struct PathCacheStats {
+            std::uint64_t hits = 0;          // 캐시된 경로를 그대로(또는 짧게 이어 붙여) 사용한 횟수
+            std::uint64_t misses = 0;        // 전체 A* 탐색을 수행한 횟수
+            std::uint64_t invalidations = 0; // 지형/건물 변경으로 폐기된 항목 수
+        };
+
+        /**
+         * @brief PathCache::lookup()이 미뤄 둔 캐시 갱신 내용입니다. PathCache::apply()로 반영합니다.
+         */
+        struct PathCacheUpdate {
+            std::size_t order = 0;          // 적용 순서 (계획 단계의 유닛 순번)
+            int region = -1;                // 시작 영역 (-1이면 캐시를 거치지 않은 탐색)
+            types::Position goal;
+            MovementClass movementClass = MovementClass::Ground;
+            types::Position start;
+            bool hit = false;               // true면 기존 항목 사용, false면 새 탐색 결과(path) 저장
+            std::vector<types::Position> path;
+        };
+
+        /**
+         * @brief (시작 영역, 목표, 이동 종류)를 키로 하는 경로 캐시입니다.
+         * 같은 영역에서 출발하는 경로는 캐시된 경로에 영역 안의 짧은 국소 탐색을 이어 붙여 재사용합니다.
+         * 항목은 지형 변경이나 건물 추가/제거가 경로 위의 타일에 닿을 때만 폐기됩니다.
+         * 유닛은 계속 움직이므로 캐시에 반영하지 않고, 꺼낼 때 경로 위에 유닛이 있으면 다시 탐색합니다.
+         */
+        class PathCache {
+        public:
+            /**
+             * @brief 캐시에서 경로를 찾고, 없으면 pathfinder로 탐색한 뒤 저장합니다.
+             * 경로 형식은 Pathfinder::findPath()와 같습니다 (다음 이동 위치가 맨 뒤).
+             * @return true 경로를 찾은 경우.
+             */
+            bool findPath(
+                Pathfinder& pathfinder,
+                const core::Map& map,
+                const types::Position& start,
+                const types::Position& goal,
+                MovementClass movementClass,
+                std::vector<types::Position>& path);
+
+            /**
+             * @brief findPath()와 같지만 캐시를 바꾸지 않고, 반영할 내용을 update에 담습니다.
+             * 캐시가 바뀌지 않는 동안에는 여러 스레드에서 각자의 pathfinder/stitch로 동시에 호출할 수 있습니다.
+             * @param stitch 국소 탐색 결과 버퍼.
+             * @param update 나중에 apply()로 반영할 갱신 내용 (order는 호출자가 채웁니다).
+             * @return true 경로를 찾은 경우.
+             */
+            bool lookup(
+                Pathfinder& pathfinder,
+                const core::Map& map,
+                const types::Position& start,
+                const types::Position& goal,
+                MovementClass movementClass,
+                std::vector<types::Position>& path,
+                std::vector<types::Position>& stitch,
+                PathCacheUpdate& update) const;
+
+            /**
+             * @brief lookup()이 미뤄 둔 사용 기록과 새 경로를 캐시에 반영합니다.
+             * 같은 캐시 상태에서 같은 순서로 적용하면 항상 같은 결과가 됩니다.
+             */
+            void apply(const PathCacheUpdate& update);
+
+            /**
+             * @brief 지정한 사각형 영역의 타일을 지나는 캐시 항목을 폐기합니다.
+             * @param origin 영역의 왼쪽 위 위치.
+             * @param width 영역의 너비.
+             * @param height 영역의 높이.
+             */
+            void invalidateArea(const types::Position& origin, int width, int height);
+
+            const PathCacheStats& getStats() const { return stats_; }
+
+            /**
+             * @brief 캐시 항목을 저장 순서대로 전달합니다. (스냅샷 저장용)
+             * 순서와 사용 순번까지 같아야 되살린 캐시가 같은 항목을 재사용하고 같은 항목을 밀어냅니다.
+             * @param callback (시작 영역, 목표, 이동 종류, 시작 위치, 경로, 마지막 사용 순번)을 받는 함수.
+             */
+            template<typename Callback>
+            void forEachEntry(Callback&& callback) const {
+                for (const auto& entry : entries_) {
+                    callback(entry.region, entry.goal, entry.movementClass, entry.start, entry.path, entry.lastUsed);
+                }
+            }
+
+            /**
+             * @brief 마지막으로 부여한 사용 순번을 반환합니다.
+             */
+            std::uint64_t getClock() const { return useCounter_; }
+
+            /**
+             * @brief 캐시 항목 수를 반환합니다.
+             */
+            std::size_t size() const { return entries_.size(); }
+
+            /**
+             * @brief 캐시를 비우고 사용 순번을 되돌립니다. 이어서 restoreEntry()로 항목을 저장 순서대로 채웁니다.
+             * @param clock 저장 시점의 사용 순번.
+             */
+            void restore(std::uint64_t clock);
+
+            /**
+             * @brief 저장된 항목 하나를 끝에 추가합니다.
+             * @return false 캐시가 이미 가득 찬 경우.
+             */
+            bool restoreEntry(int region, const types::Position& goal, MovementClass movementClass,
+                const types::Position& start, const std::vector<types::Position>& path, std::uint64_t lastUsed);
+
+            static constexpr int REGION_SIZE = 4;  // 시작 영역 한 변의 길이 (타일)
+            static constexpr size_t MAX_ENTRIES = 128;
+
+        private:
+            struct Entry {
+                int region;
+                types::Position goal;
+                MovementClass movementClass;
+                types::Position start;
+                std::vector<types::Position> path;  // goal이 맨 앞, start 다음 위치가 맨 뒤
+                types::Position minCorner;          // 경로를 감싸는 사각형 (빠른 폐기 판정용)
+                types::Position maxCorner;
+                std::uint64_t lastUsed;
+            };
+
+            std::vector<Entry> entries_;
+            std::vector<types::Position> stitch_;  // 국소 탐색 결과 버퍼
+            PathCacheUpdate pendingUpdate_;        // findPath()가 바로 반영하는 갱신 버퍼
+            std::uint64_t useCounter_ = 0;
+            PathCacheStats stats_;
+
+            Entry* findEntry(int region, const types::Position& goal, MovementClass movementClass);
+            const Entry* findEntry(int region, const types::Position& goal, MovementClass movementClass) const;
+            static void assign(Entry& entry, int region, const types::Position& goal, MovementClass movementClass,
+                const types::Position& start, const std::vector<types::Position>& path);
+            void store(int region, const types::Position& goal, MovementClass movementClass,
+                const types::Position& start, const std::vector<types::Position>& path);
+            bool reuse(Pathfinder& pathfinder, const core::Map& map, const Entry& entry,
+                const types::Position& start, std::vector<types::Position>& path,
+                std::vector<types::Position>& stitch) const;
+        };
+
+    } // namespace pathfinding
+} // namespace dune
@@ -0,0 +1,89 @@
+#pragma once
+#include "utils/types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace dune {
+    namespace core { class Map; }
+
+    namespace pathfinding {
+
+        /**
+         * @brief 탐색을 제한할 사각형 영역입니다. (양 끝 포함)
+         */
+        struct SearchBounds {
+            int minRow;
+            int minColumn;
+            int maxRow;
+            int maxColumn;
+        };
+
+        /**
+         * @brief 모든 유닛 상태가 공유하는 A* 경로 탐색기입니다.
+         * 타일별 데이터(g 비용, 부모, 방문 표시)는 row * width + column 으로 인덱싱하는 평면 배열에 두고,
+         * 탐색 세대(generation) 번호로 유효성을 표시하므로 탐색마다 배열을 초기화하거나 새로 할당하지 않습니다.
+         */
+        class Pathfinder {
+        public:
+            /**
+             * @brief start에서 goal까지의 4방향 최단 경로를 찾습니다.
+             * 경로는 goal이 맨 앞, 다음 이동 위치가 맨 뒤에 오도록 저장되므로 back()/pop_back()으로 소비합니다.
+             * start는 경로에 포함하지 않습니다. 목표 위치의 유닛은 추적/사냥 대상이므로 장애물로 보지 않습니다.
+             * @param map 탐색할 맵.
+             * @param start 시작 위치.
+             * @param goal 목표 위치.
+             * @param path 결과 경로를 담을 버퍼 (기존 내용은 지워지며 용량은 재사용됩니다).
+             * @return true 경로를 찾은 경우, false 경로가 없거나 start == goal 인 경우.
+             */
+            bool findPath(
+                const core::Map& map,
+                const types::Position& start,
+                const types::Position& goal,
+                std::vector<types::Position>& path);
+
+            /**
+             * @brief findPath()와 같지만 bounds 안의 타일만 탐색합니다.
+             * 캐시된 경로에 새 시작 위치를 잇는 짧은 국소 탐색에 사용합니다.
+             */
+            bool findPathWithin(
+                const core::Map& map,
+                const types::Position& start,
+                const types::Position& goal,
+                const SearchBounds& bounds,
+                std::vector<types::Position>& path);
+
+        private:
+            // 열린 목록 항목 (이진 힙에 저장)
+            struct OpenEntry {
+                int fCost;
+                int hCost;
+                int index;
+            };
+
+            int width_ = 0;
+            int height_ = 0;
+            std::uint32_t generation_ = 0;
+
+            std::vector<int> gCost_;                 // 시작점에서의 비용 (openStamp_ == generation_ 일 때만 유효)
+            std::vector<int> parent_;                // 부모 타일 인덱스
+            std::vector<std::uint32_t> openStamp_;   // 이번 탐색에서 비용이 기록된 타일
+            std::vector<std::uint32_t> closedStamp_; // 이번 탐색에서 확정된 타일
+            std::vector<OpenEntry> openHeap_;
+
+            /**
+             * @brief 맵 크기에 맞게 배열을 준비하고 새 탐색 세대를 시작합니다.
+             */
+            void beginSearch(int width, int height);
+
+            bool isPassable(const core::Map& map, int index, int goalIndex) const;
+
+            bool search(
+                const core::Map& map,
+                const types::Position& start,
+                const types::Position& goal,
+                const SearchBounds& bounds,
+                std::vector<types::Position>& path);
+        };
+
+    } // namespace pathfinding
+} // namespace dune
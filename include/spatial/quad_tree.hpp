@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include "spatial_index.hpp"
 #include "utils/types.hpp"
 #include "entity/unit.hpp"
 
@@ -11,7 +12,7 @@ namespace dune {
          * @brief 쿼드트리 노드 클래스
          * 각 노드는 사각형 영역을 대표하며, 해당 영역 내의 객체(유닛)을 관리합니다.
          */
-        class QuadTree {
+        class QuadTree : public SpatialIndex {
         public:
             /**
              * @brief 생성자
@@ -29,7 +30,7 @@ namespace dune {
              * @brief 객체(유닛)을 삽입합니다.
              * @param unit 삽입할 유닛의 포인터
              */
-            void insert(const entity::Unit* unit);
+            void insert(const entity::Unit* unit) override;
 
             /**
              * @brief 특정 사각형 범위에 해당하는 객체 목록을 가져옵니다.
@@ -39,14 +40,14 @@ namespace dune {
              * @param qh 쿼리 영역의 높이
              * @param results 결과를 담을 벡터(범위 내 객체의 포인터)
              */
-            void queryRange(int qx, int qy, int qw, int qh, std::vector<const entity::Unit*>& results) const;
+            void queryRange(int qx, int qy, int qw, int qh, std::vector<const entity::Unit*>& results) const override;
 
             /**
              * @brief 쿼드트리에서 특정 유닛을 제거합니다.
              * @param unit 제거할 유닛 포인터
              * @return true 제거 성공, false 해당 유닛 미존재
              */
-            bool remove(const entity::Unit* unit);
+            bool remove(const entity::Unit* unit) override;
 
         private:
             int x_, y_, width_, height_;
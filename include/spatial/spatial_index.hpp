@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include "utils/types.hpp"
+
+namespace dune {
+    namespace entity { class Unit; }
+
+    namespace spatial {
+
+        /**
+         * @brief 유닛 위치 기반 공간 인덱스의 공통 인터페이스입니다.
+         * 위치가 바뀌는 유닛은 이동 전에 remove(), 이동 후에 insert() 해야 합니다.
+         */
+        class SpatialIndex {
+        public:
+            virtual ~SpatialIndex() = default;
+
+            /**
+             * @brief 객체(유닛)을 삽입합니다.
+             * @param unit 삽입할 유닛의 포인터
+             */
+            virtual void insert(const entity::Unit* unit) = 0;
+
+            /**
+             * @brief 특정 유닛을 제거합니다. 유닛의 현재 위치로 저장 위치를 찾습니다.
+             * @param unit 제거할 유닛 포인터
+             * @return true 제거 성공, false 해당 유닛 미존재
+             */
+            virtual bool remove(const entity::Unit* unit) = 0;
+
+            /**
+             * @brief 특정 사각형 범위에 해당하는 객체 목록을 가져옵니다.
+             * 범위는 [qx, qx + qw] x [qy, qy + qh] (양 끝 포함) 입니다.
+             * @param qx 쿼리 영역의 왼쪽 상단 x (column)
+             * @param qy 쿼리 영역의 왼쪽 상단 y (row)
+             * @param qw 쿼리 영역의 너비
+             * @param qh 쿼리 영역의 높이
+             * @param results 결과를 담을 벡터(범위 내 객체의 포인터)
+             */
+            virtual void queryRange(int qx, int qy, int qw, int qh, std::vector<const entity::Unit*>& results) const = 0;
+        };
+
+        /**
+         * @brief 공간 인덱스 구현 종류입니다.
+         */
+        enum class SpatialIndexType {
+            QuadTree,
+            UniformGrid
+        };
+
+        /**
+         * @brief 지정한 종류의 공간 인덱스를 생성합니다.
+         * @param type 구현 종류.
+         * @param width 인덱스가 덮는 영역의 너비 (맵 너비).
+         * @param height 인덱스가 덮는 영역의 높이 (맵 높이).
+         * @return std::unique_ptr<SpatialIndex> 생성된 인덱스.
+         */
+        std::unique_ptr<SpatialIndex> createSpatialIndex(SpatialIndexType type, int width, int height);
+
+    } // namespace spatial
+} // namespace dune
@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include "spatial_index.hpp"
+#include "utils/types.hpp"
+
+namespace dune {
+    namespace spatial {
+
+        /**
+         * @brief 고정 크기 셀로 맵을 나눈 균일 격자 공간 인덱스입니다.
+         * 각 셀은 유닛 포인터를 고유 번호 순의 연속된 배열로 보관하므로, 범위 쿼리가 트리 노드를
+         * 따라가지 않고 겹치는 셀 배열만 순차적으로 훑으며 결과 순서는 유닛의 위치와 번호로만 정해집니다.
+         */
+        class UniformGrid : public SpatialIndex {
+        public:
+            /**
+             * @brief 생성자
+             * @param width 격자가 덮는 영역의 너비 (column 수)
+             * @param height 격자가 덮는 영역의 높이 (row 수)
+             * @param cellSize 한 셀의 한 변 길이 (타일 단위)
+             */
+            UniformGrid(int width, int height, int cellSize = DEFAULT_CELL_SIZE);
+
+            void insert(const entity::Unit* unit) override;
+            bool remove(const entity::Unit* unit) override;
+            void queryRange(int qx, int qy, int qw, int qh, std::vector<const entity::Unit*>& results) const override;
+
+            static constexpr int DEFAULT_CELL_SIZE = 8;
+
+        private:
+            int width_, height_;
+            int cellSize_;
+            int columns_, rows_;   // 셀 단위 격자 크기
+
+            std::vector<std::vector<const entity::Unit*>> cells_;  // row-major 셀 배열
+
+            /**
+             * @brief 타일 좌표를 셀 좌표로 변환합니다. 영역 밖 좌표는 가장자리 셀로 고정합니다.
+             */
+            int cellColumn(int column) const;
+            int cellRow(int row) const;
+
+            /**
+             * @brief 위치가 속한 셀의 인덱스를 반환합니다.
+             */
+            int cellIndex(const types::Position& position) const;
+        };
+
+    } // namespace spatial
+} // namespace dune
@@ -8,6 +8,7 @@
 #include "cursor.hpp"
 #include "../utils/types.hpp"
 #include "../core/map.hpp"
+#include "../core/jobs.hpp"
 
 namespace dune {
     namespace ui {
@@ -33,12 +34,24 @@ namespace dune {
              */
             void update(const types::Resource& resource, const core::Map& map, const Cursor& cursor);
 
+            /**
+             * @brief 화면 구성을 나눠 실행할 작업 풀을 설정합니다. 없으면 한 스레드에서 그립니다.
+             * @param jobs 작업 풀 (Display보다 오래 살아 있어야 합니다).
+             */
+            void setJobSystem(core::JobSystem* jobs) { jobs_ = jobs; }
+
             /**
              * @brief 시스템 메시지를 추가합니다.
              * @param message 추가할 메시지.
              */
             void addSystemMessage(const std::wstring& message);
 
+            /**
+             * @brief 게임 사건을 메시지 창에 표시합니다. (EventBus 구독자)
+             * @param event 표시할 사건.
+             */
+            void addGameEvent(const core::GameEvent& event);
+
             /**
              * @brief 상태 메시지를 업데이트합니다.
              * @param status 업데이트할 상태 메시지.
@@ -64,6 +77,7 @@ namespace dune {
             CommandWindow commandWindow_;
             StatusWindow statusWindow_;
             MapRenderer mapRenderer_;
+            core::JobSystem* jobs_ = nullptr;  // 화면 구성 작업 풀 (없으면 직렬)
             int totalWidth_;
             int totalHeight_;
 
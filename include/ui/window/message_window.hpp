@@ -1,5 +1,6 @@
 #pragma once
 #include "base_window.hpp"
+#include "../../core/game_event.hpp"
 #include <deque>
 #include <string>
 #include <chrono>
@@ -27,6 +28,12 @@ namespace dune {
              */
             void addMessage(const std::wstring& message);
 
+            /**
+             * @brief 게임 사건을 읽을 수 있는 문장으로 바꿔 추가합니다. (EventBus 구독자)
+             * @param event 표시할 사건.
+             */
+            void addEvent(const core::GameEvent& event);
+
             /**
              * @brief 윈도우를 그립니다.
              * @param renderer 렌더러 객체.
@@ -40,31 +47,17 @@ namespace dune {
                 std::wstring message;
                 std::chrono::steady_clock::time_point timestamp;
                 bool isImportant;
-                bool isProcessed;  // 메시지 처리 여부
 
                 TimedMessage(const std::wstring& msg, bool important = false)
                     : message(msg)
                     , timestamp(std::chrono::steady_clock::now())
-                    , isImportant(important)
-                    , isProcessed(false) {}
+                    , isImportant(important) {}
             };
 
             const std::deque<TimedMessage>& getMessages() const {
                 return messages_;
             }
 
-            /**
-             * @brief 특정 메시지를 처리 완료로 표시합니다.
-             */
-            void markMessageProcessed(const std::wstring& message) {
-                for (auto& timedMessage : messages_) {
-                    if (timedMessage.message == message && !timedMessage.isProcessed) {
-                        timedMessage.isProcessed = true;
-                        break;
-                    }
-                }
-            }
-
         private:
 
             static constexpr size_t MAX_MESSAGES = 8;
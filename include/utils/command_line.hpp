@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dune {
+    namespace utils {
+
+        /**
+         * @brief 명령줄 옵션 하나의 이름과 값 종류입니다.
+         */
+        struct OptionSpec {
+            const char* name;       // "--seed"처럼 "--"를 붙인 이름
+            bool numeric;           // true면 값이 부호 없는 정수여야 합니다.
+        };
+
+        /**
+         * @brief 헤드리스 도구(headless, replay_player)가 함께 쓰는 명령줄 해석기입니다.
+         * 옵션은 "--이름 값" 꼴로 값을 하나씩 받고, "--"로 시작하지 않는 인자는 위치 인자로 모읍니다.
+         * 모르는 옵션, 값이 없는 옵션, 숫자가 아닌 숫자 옵션은 parse()가 거절합니다.
+         */
+        class CommandLine {
+        public:
+            /**
+             * @brief 명령줄을 읽습니다.
+             * @param specs 받을 옵션 목록.
+             * @return false 잘못된 인자가 있는 경우 (getError()로 이유를 얻습니다).
+             */
+            bool parse(int argc, char* argv[], std::initializer_list<OptionSpec> specs);
+
+            const std::string& getError() const { return error_; }
+            const std::vector<std::string>& getPositionals() const { return positionals_; }
+
+            bool has(const std::string& name) const { return values_.count(name) != 0; }
+
+            /**
+             * @brief 옵션 값을 반환합니다. 주지 않았으면 fallback을 반환합니다.
+             */
+            std::string getString(const std::string& name, const std::string& fallback = {}) const;
+
+            /**
+             * @brief 숫자 옵션 값을 반환합니다. 주지 않았으면 fallback을 반환합니다.
+             * "--seed"처럼 0x 접두사를 받을 옵션도 있어 10진수, 16진수(0x), 8진수(0) 표기를 모두 받습니다.
+             */
+            std::uint64_t getNumber(const std::string& name, std::uint64_t fallback) const;
+
+        private:
+            std::map<std::string, std::string> values_;
+            std::vector<std::string> positionals_;
+            std::string error_;
+        };
+
+    } // namespace utils
+} // namespace dune
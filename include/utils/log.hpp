@@ -0,0 +1,149 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief 컴파일에 포함할 가장 낮은 로그 수준입니다. (0: Debug, 1: Info, 2: Warning, 3: Error)
+ * 이보다 낮은 수준의 log<>() 호출은 코드에서 사라집니다. 빌드 설정에서 정의합니다.
+ */
+#ifndef DUNE_LOG_COMPILE_LEVEL
+#define DUNE_LOG_COMPILE_LEVEL 0
+#endif
+
+namespace dune {
+    namespace utils {
+
+        /**
+         * @brief 로그 수준입니다. Off는 실행 중 모든 로그를 끌 때만 씁니다.
+         */
+        enum class LogLevel : std::uint8_t {
+            Debug,
+            Info,
+            Warning,
+            Error,
+            Off
+        };
+
+        /**
+         * @brief 고정 크기 링 버퍼에 로그를 쌓고 백그라운드 스레드가 파일로 내보내는 로거입니다.
+         *
+         * 기록하는 쪽은 잠금 없이 빈 칸을 예약해 복사만 하고, 버퍼가 가득 차면 기다리지 않고 버립니다.
+         * 파일을 열기 전에는 수준이 Off라 모든 로그가 무시됩니다.
+         * 보통은 Logger를 직접 쓰지 않고 utils::log<수준>(포맷 함수)를 호출합니다.
+         */
+        class Logger {
+        public:
+            /**
+             * @brief 프로세스 전체가 공유하는 로거를 반환합니다.
+             */
+            static Logger& instance();
+
+            ~Logger();
+
+            Logger(const Logger&) = delete;
+            Logger& operator=(const Logger&) = delete;
+
+            /**
+             * @brief 로그 파일을 열고 백그라운드 기록 스레드를 시작합니다. 이미 열려 있으면 먼저 닫습니다.
+             * @param path 로그 파일 경로.
+             * @param level 기록할 가장 낮은 수준.
+             * @return false 파일을 열 수 없는 경우.
+             */
+            bool open(const std::string& path, LogLevel level = LogLevel::Info);
+
+            /**
+             * @brief 남은 로그를 모두 기록하고 파일을 닫습니다.
+             */
+            void close();
+
+            /**
+             * @brief 실행 중 기록할 가장 낮은 수준을 바꿉니다. 파일이 열려 있을 때만 의미가 있습니다.
+             */
+            void setLevel(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+
+            /**
+             * @brief 해당 수준의 로그가 기록되는지 확인합니다. 포맷하기 전에 확인해 비용을 아낍니다.
+             */
+            bool isEnabled(LogLevel level) const {
+                return level >= level_.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 로그 한 줄을 링 버퍼에 넣습니다. 여러 스레드에서 동시에 불러도 됩니다.
+             * 긴 메시지는 잘리고, 버퍼가 가득 차면 버려집니다.
+             */
+            void write(LogLevel level, const std::wstring& message);
+
+            /**
+             * @brief 버퍼가 가득 차 버려진 로그 수를 반환합니다.
+             */
+            std::uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+        private:
+            Logger();
+
+            static constexpr std::size_t CAPACITY = 1024;        // 링 버퍼 칸 수 (2의 거듭제곱)
+            static constexpr std::size_t MAX_TEXT = 160;         // 한 줄 최대 글자 수
+            static constexpr std::chrono::milliseconds FLUSH_INTERVAL{ 20 };  // 기록 스레드가 버퍼를 확인하는 주기
+
+            struct Record {
+                LogLevel level;
+                std::uint16_t length;
+                std::int64_t micros;  // 로거 생성 후 경과 시간
+                wchar_t text[MAX_TEXT];
+            };
+
+            // sequence가 칸 번호와 같으면 비어 있고, 번호 + 1이면 기록이 끝난 칸입니다.
+            struct Slot {
+                std::atomic<std::size_t> sequence;
+                Record record;
+            };
+
+            void sinkLoop();
+
+            /**
+             * @brief 쌓인 로그를 모두 파일에 씁니다. (기록 스레드 전용)
+             * @return 쓴 줄 수.
+             */
+            std::size_t drain();
+
+            std::unique_ptr<Slot[]> slots_;
+            alignas(64) std::atomic<std::size_t> enqueuePos_{ 0 };
+            alignas(64) std::size_t dequeuePos_ = 0;
+            std::atomic<std::uint64_t> dropped_{ 0 };
+            std::atomic<LogLevel> level_{ LogLevel::Off };
+
+            std::chrono::steady_clock::time_point start_;
+            std::ofstream file_;
+            std::thread sinkThread_;
+            std::mutex sinkMutex_;
+            std::condition_variable sinkCondition_;
+            bool stopping_ = false;
+        };
+
+        /**
+         * @brief 로그를 남깁니다. 포맷 함수는 해당 수준이 켜져 있을 때만 호출됩니다.
+         * 컴파일 수준보다 낮은 호출은 아무 코드도 만들지 않고, 실행 중 꺼진 수준은 원자 변수 하나만 읽습니다.
+         * @tparam Level 로그 수준.
+         * @param format std::wstring을 반환하는 함수.
+         */
+        template<LogLevel Level, typename Format>
+        inline void log(Format&& format) {
+            if constexpr (static_cast<int>(Level) >= DUNE_LOG_COMPILE_LEVEL) {
+                Logger& logger = Logger::instance();
+                if (logger.isEnabled(Level)) {
+                    logger.write(Level, format());
+                }
+            }
+        }
+
+    } // namespace utils
+} // namespace dune
@@ -0,0 +1,110 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace dune {
+    namespace utils {
+
+        /**
+         * @brief xoshiro256** 난수 생성기입니다.
+         * 상태가 64비트 4개뿐이라 복사와 저장이 싸고, 할당이나 시스템 호출 없이 같은 시드에서 같은 수열을 냅니다.
+         */
+        class Xoshiro256 {
+        public:
+            /**
+             * @brief 시드로 상태를 채웁니다. 시드가 비슷해도 상태가 고르게 퍼지도록 splitmix64를 거칩니다.
+             * @param seed 시드.
+             */
+            explicit Xoshiro256(std::uint64_t seed = 0) { reseed(seed); }
+
+            void reseed(std::uint64_t seed);
+
+            /**
+             * @brief 다음 64비트 난수를 반환합니다.
+             */
+            std::uint64_t next() {
+                const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+                const std::uint64_t t = state_[1] << 17;
+                state_[2] ^= state_[0];
+                state_[3] ^= state_[1];
+                state_[1] ^= state_[2];
+                state_[0] ^= state_[3];
+                state_[2] ^= t;
+                state_[3] = rotl(state_[3], 45);
+                return result;
+            }
+
+            /**
+             * @brief [min, max] 범위의 정수를 치우침 없이 반환합니다.
+             */
+            int nextInt(int min, int max);
+
+            /**
+             * @brief 0 이상 100 미만의 수가 percent보다 작을 확률로 true를 반환합니다.
+             */
+            bool chance(int percent) { return nextInt(0, 99) < percent; }
+
+            /**
+             * @brief 수열을 2^128 단계 건너뜁니다. 한 시드에서 겹치지 않는 하위 수열을 나눌 때 씁니다.
+             */
+            void jump();
+
+            /**
+             * @brief 생성기 상태를 반환합니다. 같은 상태를 setState()로 넣으면 같은 수열이 이어집니다.
+             */
+            const std::array<std::uint64_t, 4>& getState() const { return state_; }
+            void setState(const std::array<std::uint64_t, 4>& state) { state_ = state; }
+
+        private:
+            static constexpr std::uint64_t rotl(std::uint64_t x, int k) {
+                return (x << k) | (x >> (64 - k));
+            }
+
+            std::array<std::uint64_t, 4> state_;
+        };
+
+        /**
+         * @brief 난수를 쓰는 곳별 하위 수열입니다.
+         * 용도마다 수열이 나뉘어 있어 한쪽에서 뽑는 횟수가 바뀌어도 다른 쪽 결과는 그대로입니다.
+         */
+        enum class RandomStream : std::uint8_t {
+            HarvestYield,   // 하베스터 수확량
+            Excretion,      // 샌드웜 배설 여부와 위치
+            Count
+        };
+
+        /**
+         * @brief 경기 시드 하나에서 용도별 하위 수열을 만드는 난수 묶음입니다. 맵이 하나씩 소유합니다.
+         * 같은 시드로 시작한 경기는 스레드 수와 관계없이 같은 결과를 냅니다.
+         * 난수는 틱의 직렬 단계(update)에서만 뽑아야 합니다.
+         */
+        class RandomStreams {
+        public:
+            static constexpr std::uint64_t DEFAULT_SEED = 0x5EED0D0E5EED0D0Eull;
+
+            explicit RandomStreams(std::uint64_t seed = DEFAULT_SEED) { reseed(seed); }
+
+            /**
+             * @brief 모든 하위 수열을 새 시드로 다시 시작합니다.
+             */
+            void reseed(std::uint64_t seed);
+
+            /**
+             * @brief 용도에 해당하는 생성기를 반환합니다.
+             */
+            Xoshiro256& get(RandomStream stream) { return streams_[static_cast<std::size_t>(stream)]; }
+            const Xoshiro256& get(RandomStream stream) const { return streams_[static_cast<std::size_t>(stream)]; }
+
+            /**
+             * @brief 경기 시드를 반환합니다.
+             */
+            std::uint64_t getSeed() const { return seed_; }
+
+        private:
+            std::uint64_t seed_ = 0;
+            std::array<Xoshiro256, static_cast<std::size_t>(RandomStream::Count)> streams_;
+        };
+
+    } // namespace utils
+} // namespace dune
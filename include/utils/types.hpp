@@ -91,6 +91,8 @@ namespace dune {
             Build_Factory,
             Build_HeavyTank,
             ShowUnitList,
+            ToggleProfiler,
+            ToggleTrace,
             Undefined
         };
 
@@ -131,7 +133,7 @@ namespace dune {
         /**
          * @brief 지형의 종류를 나타내는 열거형입니다.
          */
-        enum class TerrainType {
+        enum class TerrainType : std::uint8_t {
             Desert,
             Plate,
             Rock,
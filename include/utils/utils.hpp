@@ -2,7 +2,6 @@
 #include "types.hpp"
 #include "constants.hpp"
 #include <chrono>
-#include <random>
 
 namespace dune {
 	namespace utils {
@@ -48,14 +47,6 @@ namespace dune {
          */
         int manhattanDistance(const types::Position& a, const types::Position& b);
 
-        // 난수 생성
-        inline int random_int(int min, int max) {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dis(min, max);
-            return dis(gen);
-        }
-
         // 시간 관련 유틸리티
         using GameClock = std::chrono::steady_clock;
         using TimePoint = GameClock::time_point;
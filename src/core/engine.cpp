@@ -1,4 +1,6 @@
 #include "../include/core/game.hpp"
+#include "../include/core/profiler.hpp"
+#include "../include/utils/log.hpp"
 #include <locale>
 
 using namespace dune::core;
@@ -16,6 +18,12 @@ int main() {
     // 유니코드 출력 시 BOM(Byte Order Mark) 방지를 위해 널 문자 설정
     std::wcout.imbue(std::locale(""));
 
+    // 시스템 메시지와 경고를 파일에도 남깁니다.
+    dune::utils::Logger::instance().open("dune.log");
+
+    // P 키로 켠 동안 모은 틱별 구간 시간을 종료할 때 파일로 남깁니다.
+    dune::core::Profiler::instance().setReportPath("dune_profile.txt");
+
     // 프로그램 실행 코드
     Game game;
     game.run();
@@ -1,24 +1,34 @@
 #include "core/game.hpp"
 #include "core/io.hpp"
+#include "core/profiler.hpp"
 #include "utils/utils.hpp"
+#include "utils/log.hpp"
 #include <thread>
+#include <algorithm>
 #include <array>
 #include <map>
+#include <random>
 #include <iostream>
-#include <regex>
 
 namespace dune {
     namespace core {
+        namespace {
+            // 경기마다 덮어쓰는 리플레이 파일 (replay_player로 재생)
+            constexpr const char* REPLAY_PATH = "last_match.replay";
+        }
+
         /**
         * PDF 1. 준비
         */
         Game::Game()
-            : sys_clock(0)
-            , game_state(types::GameState::Initial)
-            , cursor({ 1, 1 })
-            , resource{ 100, 1000, 10, 100 }
+            : game_state(types::GameState::Initial)
             , display(constants::MAP_WIDTH, constants::MAP_HEIGHT, constants::DEFAULT_STATUS_WIDTH)
-            , map(constants::MAP_WIDTH, constants::MAP_HEIGHT, &display.getMessageWindow())
+            , simulation([this](const std::wstring& message) { display.addSystemMessage(message); },
+                // 게임마다 다른 경기가 되도록 시작할 때 한 번만 시드를 뽑습니다.
+                (std::uint64_t{ std::random_device{}() } << 32) | std::random_device{}())
+            , map(simulation.getMap())
+            , resource(simulation.getResource())
+            , cursor({ 1, 1 })
         {
             init();
         }
@@ -27,206 +37,26 @@ namespace dune {
         * PDF 1. 준비
         */
         void Game::init() {
-            initResources();
-            initTerrain();
-            initBuildings();
-            initSandworms();
-            initHarvesters();
+            // 지형, 건물, 초기 유닛 배치는 Simulation 생성 시 완료됩니다.
             //init_air_units();
-            initDisplay();
-
-            display.addSystemMessage(L"Game initialization complete");
-        }
-
-        /**
-        * PDF 1. 준비
-        */
-        void Game::initResources() {
-            resource = types::Resource{
-                100,    // spice
-                1000,   // spice_max
-                10,     // population
-                100     // population_max
-            };
-        }
+            // 계획 단계와 화면 구성이 함께 쓰는 작업 풀을 코어 수만큼 키운 뒤 화면에 넘깁니다. (결과는 스레드 수와 무관)
+            simulation.setThreadCount(std::max(1u, std::thread::hardware_concurrency()));
+            display.setJobSystem(&simulation.getJobSystem());
+            utils::log<utils::LogLevel::Info>([this] {
+                return L"Match seed: " + std::to_wstring(simulation.getSeed());
+            });
 
-        /**
-        * PDF 1. 준비
-        */
-        void Game::initTerrain() {
-            // 바위(Rock) 배치
-            const std::vector<types::Position> rock_positions = {
-                {5, 20}, {8, 30}, {12, 40}, {3, 50}, {15, 45}
-            };
-
-            for (const auto& pos : rock_positions) {
-                map.setTerrain(pos, types::TerrainType::Rock);
+            // 현장 성능 문제를 그대로 재현할 수 있도록 경기의 모든 명령을 기록합니다.
+            if (replay.open(REPLAY_PATH, simulation.getSeed())) {
+                simulation.setRecorder(&replay);
             }
-
-            // 스파이스 매장지 배치
-            const std::vector<types::Position> spice_positions = {
-                {15, 4}, {2, 55}
-            };
-
-            for (const auto& pos : spice_positions) {
-                map.setTerrain(pos, types::TerrainType::Spice);
-            }
-
-            // 장판(Plate) 배치
-            const std::vector<types::Position> plate_positions = {
-                {constants::MAP_HEIGHT - 3, 0}, {0, constants::MAP_WIDTH - 3}
-            };
-
-            for (const auto& pos : plate_positions) {
-                map.setTerrain(pos, types::TerrainType::Plate);
+            else {
+                utils::log<utils::LogLevel::Warning>([] { return std::wstring(L"Cannot open replay file"); });
             }
-        }
-
-        /**
-        * PDF 1. 준비
-        */
-        void Game::initBuildings() {
-            // Base(B)와 Plate(P) - 좌하단
-            map.addBuilding(std::make_unique<managers::BuildingManager::Building>(
-                types::Camp::ArtLadies,
-                std::wstring(L"Base"),
-                std::wstring(L"본진"),
-                0,
-                types::Position{ constants::MAP_HEIGHT - 4, 0 },
-                2, 2,
-                50,
-                types::UnitType::Harvester
-            ));
-
-            // Base(B)와 Plate(P) - 우상단
-            map.addBuilding(std::make_unique<managers::BuildingManager::Building>(
-                types::Camp::Harkonnen,
-                std::wstring(L"Base"),
-                std::wstring(L"적진"),
-                0,
-                types::Position{ 0, constants::MAP_WIDTH - 4 },
-                2, 2,
-                50,
-                types::UnitType::Harvester
-            ));
-        }
-
-        /**
-        * PDF 3. 샌드웜
-        */
-        void Game::initSandworms() {
-            auto sandworm1 = std::make_unique<managers::UnitManager::Unit>(
-                types::UnitType::Sandworm,
-                types::Position{ constants::MAP_HEIGHT - 6, 5 }
-            );
-            sandworm1->initializeAI(); // AI 초기화
-
-            map.addUnit(std::move(sandworm1));
-
-            auto sandworm2 = std::make_unique<managers::UnitManager::Unit>(
-                types::UnitType::Sandworm,
-                types::Position{ 5, constants::MAP_WIDTH - 6 }
-            );
-            sandworm2->initializeAI(); // AI 초기화
-
-            map.addUnit(std::move(sandworm2));
-
-            display.addSystemMessage(L"Sandworm AI successfully initialized.");
-        }
-
-        void Game::addHarvester(const types::Position& pos, types::Camp camp) {
-            auto harvester = std::make_unique<managers::UnitManager::Unit>(
-                types::UnitType::Harvester,
-                5,
-                5,
-                pos,
-                70,
-                constants::HARVESTER_SPEED,
-                0, 0,
-                camp
-            );
-            harvester->initializeAI();
-            map.addUnit(std::move(harvester));
-
-            std::wstring campName = (camp == types::Camp::ArtLadies) ? L"ArtLadies" : L"Harkonnen";
-            display.addSystemMessage(campName + L" Harvester AI successfully initialized.");
-        }
-
-        void Game::addSoldier(const types::Position& pos, types::Camp camp) {
-            auto soldier = std::make_unique<managers::UnitManager::Unit>(
-                types::UnitType::Soldier,
-                1,
-                1,
-                pos,
-                15,
-                constants::SOLDIER_SPEED,
-                5, 1,
-                camp
-            );
-            soldier->initializeAI();
-            map.addUnit(std::move(soldier));
-
-            display.addSystemMessage(L"Camp ArtLadies`s Soldier AI successfully initialized.");
-        }
-
-        void Game::addFremen(const types::Position& pos, types::Camp camp) {
-            auto fremen = std::make_unique<managers::UnitManager::Unit>(
-                types::UnitType::Fremen,
-                5,
-                2,
-                pos,
-                25,
-                constants::FREMEN_SPEED,
-                15, 8,
-                camp
-            );
-            fremen->initializeAI();
-            map.addUnit(std::move(fremen));
-
-            display.addSystemMessage(L"Camp ArtLadies`s Fremen AI successfully initialized.");
-        }
-
-        void Game::addFighter(const types::Position& pos, types::Camp camp) {
-            auto fighter = std::make_unique<managers::UnitManager::Unit>(
-                types::UnitType::Fighter,
-                1,
-                1,
-                pos,
-                6,
-                constants::FIGHTER_SPEED,
-                10, 1,
-                camp
-            );
-            fighter->initializeAI();
-            map.addUnit(std::move(fighter));
-
-            display.addSystemMessage(L"Camp Harkonnen`s Fighter AI successfully initialized.");
-        }
-
-        void Game::addHeavyTank(const types::Position& pos, types::Camp camp) {
-            auto heavyTank = std::make_unique<managers::UnitManager::Unit>(
-                types::UnitType::HeavyTank,
-                12,
-                5,
-                pos,
-                60,
-                constants::HEAVY_TANK_SPEED,
-                40, 4,
-                camp
-            );
-            heavyTank->initializeAI();
-            map.addUnit(std::move(heavyTank));
-
-            std::wstring campName = (camp == types::Camp::ArtLadies) ? L"ArtLadies" : L"Harkonnen";
-            display.addSystemMessage(L"Camp Harkonnen`s heavyTank AI successfully initialized.");
-        }
+            simulation.getEvents().subscribe([this](const GameEvent& event) { display.addGameEvent(event); });
+            initDisplay();
 
-        /**
-        * PDF 1. 준비
-        */
-        void Game::initHarvesters() {
-            addHarvester({ constants::MAP_HEIGHT - 5, 0 }, types::Camp::ArtLadies);
-            addHarvester({ 2, constants::MAP_WIDTH - 3 }, types::Camp::Harkonnen);
+            display.addSystemMessage(L"Game initialization complete");
         }
 
         /**
@@ -257,6 +87,9 @@ namespace dune {
         * PDF 1. 준비
         */
         void Game::outro() {
+            // std::exit()는 Game을 소멸시키지 않으므로 리플레이 끝 표시를 여기서 씁니다.
+            replay.close(simulation.getTickCount());
+
             IO::clearScreen();
             IO::setColor(constants::color::DEFAULT);
 
@@ -276,13 +109,14 @@ namespace dune {
                 processInput();
                 updateGameState();
                 render();
+                Profiler::instance().endTick();
 
                 std::this_thread::sleep_for(std::chrono::milliseconds(constants::TICK));
-                sys_clock += std::chrono::milliseconds(constants::TICK);
             }
         }
 
         void Game::processInput() {
+            ProfileScope scope(ProfileZone::ProcessInput);
             types::Key key = IO::getKey();
 
             if (utils::is_arrow_key(key)) {
@@ -291,42 +125,18 @@ namespace dune {
 
             if (current_selection.type_ == types::SelectionType::Building) {
                 if (auto* building = current_selection.getSelected<Building>()) {
-                    if (building->getName() == L"Base" && key == types::Key::Build_Harvester) {
-                        handleBuildHarvester(building);
+                    const auto& descriptor = building->getDescriptor();
+                    if (descriptor.produceKey != types::Key::None && key == descriptor.produceKey) {
+                        handleProduceUnit(building);
                         return;
                     }
-                    else if (key == types::Key::Build_Plate) {
-                        handleBuildPlate();
-                    }
-                    else if (key == types::Key::Build_Dormitory) {
-                        handleBuildDormitory();
-                    }
-                    else if (key == types::Key::Build_Garage) {
-                        handleBuildGarage();
-                    }
-                    else if (key == types::Key::Build_Barracks) {
-                        handleBuildBarracks();
-                    }
-                    else if (key == types::Key::Build_Shelter) {
-                        handleBuildShelter();
-                    }
-                    else if (building->getName() == L"Barracks" && key == types::Key::Build_Soldier) {
-                        handleBuildSoldier(building);
-                    }
-                    else if (building->getName() == L"Shelter" && key == types::Key::Build_Fremen) {
-                        handleBuildFremen(building);
-                    }
-                    else if (building->getName() == L"Arena" && key == types::Key::Build_Fighter) {
-                        handleBuildFighter(building);
-                    }
-                    else if (building->getName() == L"Factory" && key == types::Key::Build_HeavyTank) {
-                        handleBuildH_Tank(building);
-                    }
                 }
             }
             if (current_selection.type_ == types::SelectionType::Unit) {
                 if (auto* units = current_selection.getSelected<Unit>()) {
-                    if (units->getRepresentation() == L'H' && key == types::Key::Harvest || key == types::Key::Move) {
+                    const bool harvesterCommand = units->getType() == types::UnitType::Harvester && key == types::Key::Harvest;
+                    const bool combatCommand = units->getCombatUnitAI() && (key == types::Key::Attack || key == types::Key::Patrol);
+                    if (harvesterCommand || combatCommand || key == types::Key::Move) {
                         handleUnitCommands(key);
                         return;
                     }
@@ -346,43 +156,36 @@ namespace dune {
             else if (key == types::Key::ShowUnitList) {
                 showUnitList();
             }
-            else if (key == types::Key::Build_Arena) {
-                handleBuildArena();
+            else if (key == types::Key::ToggleProfiler) {
+                Profiler& profiler = Profiler::instance();
+                profiler.setEnabled(!profiler.isEnabled());
+                display.addSystemMessage(profiler.isEnabled() ? L"Profiler on" : L"Profiler off");
             }
-            else if (key == types::Key::Build_Factory) {
-                handleBuildFactory();
+            else if (key == types::Key::ToggleTrace) {
+                TraceRecorder& trace = TraceRecorder::instance();
+                if (trace.isRecording()) {
+                    display.addSystemMessage(trace.stop() ? L"Trace saved: dune_trace.json" : L"Cannot write trace");
+                }
+                else {
+                    trace.start("dune_trace.json");
+                    display.addSystemMessage(L"Trace recording");
+                }
+            }
+            else if (const auto* descriptor = entity::findBuildingByPlaceKey(key)) {
+                // 장판은 건물이 아니라 지형이므로 따로 설치합니다.
+                if (descriptor->type == types::BuildingType::Plate) {
+                    handleBuildPlate();
+                }
+                else {
+                    handlePlaceBuilding(*descriptor);
+                }
             }
         }
 
         void Game::updateGameState() {
-            map.update(sys_clock);
-            map.removeDestroyedBuildings();
-
-            // 하베스터의 스파이스 배달 처리
-            const auto& messages = display.getMessageWindow().getMessages();
-            for (const auto& message : messages) {
-                // "Harvester returned with X spice." 메시지 확인
-                static const std::wregex harvesterPattern(L"Harvester returned with (\\d+) spice\\.");
-                std::wsmatch matches;
-                if (std::regex_search(message.message, matches, harvesterPattern)) {
-                    // 스파이스 양 추출
-                    int spiceAmount = std::stoi(matches[1].str());
-
-                    // 창고 용량 확인 및 자원 추가
-                    int addedSpice = (spiceAmount < (resource.spice_max - resource.spice))
-                        ? spiceAmount
-                        : (resource.spice_max - resource.spice);
-                    resource.spice += addedSpice;
-
-                    // 창고가 가득 찼을 경우 메시지 표시
-                    if (addedSpice < spiceAmount) {
-                        display.addSystemMessage(
-                            L"Storage full! Excess spice discarded: " +
-                            std::to_wstring(spiceAmount - addedSpice)
-                        );
-                    }
-                }
-            }
+            ProfileScope scope(ProfileZone::UpdateGameState);
+            // 스파이스 정산과 사건 메시지는 step()이 틱 끝에 사건을 전달하며 처리합니다.
+            simulation.step();
 
             updateSelectionDisplay();
         }
@@ -408,220 +211,26 @@ namespace dune {
         }
 
         void Game::handleBuildPlate() {
-            types::Position pos = cursor.getCurrentPosition();
-
-            // 설치 가능 여부 확인
-            auto& terrainManager = map.getTerrainManager();
-            bool canPlace = true;
-
-            // 2x2 크기의 장판을 설치할 수 있는지 확인
-            for (int row = pos.row; row < pos.row + 2; ++row) {
-                for (int col = pos.column; col < pos.column + 2; ++col) {
-                    types::Position tilePos{ row, col };
-
-                    // 맵 범위 및 지형 체크
-                    if (!tilePos.is_valid() ||
-                        terrainManager.getTerrain(tilePos).getType() != types::TerrainType::Desert) {
-                        display.addSystemMessage(L"Cannot place Plate here.");
-                        canPlace = false;
-                        break;
-                    }
-                }
-                if (!canPlace) break;
-            }
-
-            if (canPlace) {
-                if (resource.spice < 1) {
-                    display.addSystemMessage(L"Not enough spice to build Plate.");
-                    return;
-                }
-
-                // Plate 설치
-                for (int row = pos.row; row < pos.row + 2; ++row) {
-                    for (int col = pos.column; col < pos.column + 2; ++col) {
-                        terrainManager.setTerrain({ row, col }, types::TerrainType::Plate);
-                    }
-                }
-
-                resource.spice -= 1;
-                display.addSystemMessage(L"The Plate has been installed.");
-            }
-        }
-
-        void Game::handleBuildDormitory() {
-            types::Position pos = cursor.getCurrentPosition();
-
-            auto Dormitory = std::make_unique<managers::BuildingManager::Building>(
-                types::Camp::Common,
-                L"Dormitory",
-                L"숙소 (인구 최대치 증가 +10)",
-                2,
-                pos,
-                2,
-                2,
-                10,
-                types::UnitType::None
-            );
-
-            if (placeBuilding(std::move(Dormitory))) {
-                if (resource.spice < 2) {
-                    display.addSystemMessage(L"Not enough spice to build Dormitory");
-                }
-                else {
-                    display.addSystemMessage(L"The Dormitory has been installed.");
-                    resource.spice -= 2;
-                    resource.population_max += 10;
-                }
-            }
-            else {
-                display.addSystemMessage(L"The Dormitory cannot be installed in this location.");
-            }
+            Command command;
+            command.type = CommandType::PlacePlate;
+            command.target = cursor.getCurrentPosition();
+            simulation.execute(command);
         }
 
-        void Game::handleBuildGarage() {
-            types::Position pos = cursor.getCurrentPosition();
-
-            auto garage = std::make_unique<managers::BuildingManager::Building>(
-                types::Camp::Common,
-                L"Garage",
-                L"창고 (스파이스 최대치 증가 +10)",
-                4,
-                pos,
-                2,
-                2,
-                10,
-                types::UnitType::None
-            );
-
-            if (placeBuilding(std::move(garage))) {
-                if (resource.spice < 4) {
-                    display.addSystemMessage(L"Not enough spice to build garage");
-                }
-                else {
-                    display.addSystemMessage(L"The garage has been installed.");
-                    resource.spice -= 4;
-                    resource.spice_max += 10;
-                }
-            }
-            else {
-                display.addSystemMessage(L"The garage cannot be installed in this location.");
-            }
-        }
-
-        void Game::handleBuildBarracks() {
-            types::Position pos = cursor.getCurrentPosition();
-
-            auto barracks = std::make_unique<managers::BuildingManager::Building>(
-                types::Camp::ArtLadies,
-                L"Barracks",
-                L"병영 (보병 생산)",
-                4,
-                pos,
-                2,
-                2,
-                20,
-                types::UnitType::Soldier
-            );
-
-            if (placeBuilding(std::move(barracks))) {
-                if (resource.spice < 4) {
-                    display.addSystemMessage(L"Not enough spice to build barracks");
-                }
-                else {
-                    display.addSystemMessage(L"The barracks has been installed.");
-                    resource.spice -= 4;
-                }
-            }
-            else {
-                display.addSystemMessage(L"The barracks cannot be installed in this location.");
-            }
+        void Game::handlePlaceBuilding(const entity::BuildingDescriptor& descriptor) {
+            Command command;
+            command.type = CommandType::PlaceBuilding;
+            command.building = descriptor.type;
+            command.target = cursor.getCurrentPosition();
+            simulation.execute(command);
         }
 
-        void Game::handleBuildShelter() {
-            types::Position pos = cursor.getCurrentPosition();
-
-            auto shelter = std::make_unique<managers::BuildingManager::Building>(
-                types::Camp::ArtLadies,
-                L"Shelter",
-                L"은신처 (특수유닛 생산)",
-                5,
-                pos,
-                2,
-                2,
-                30,
-                types::UnitType::Fremen
-            );
-
-            if (placeBuilding(std::move(shelter))) {
-                if (resource.spice < 5) {
-                    display.addSystemMessage(L"Not enough spice to build shelter");
-                }
-                else {
-                    display.addSystemMessage(L"The shelter has been installed.");
-                    resource.spice -= 5;
-                }
-            }
-            else {
-                display.addSystemMessage(L"The shelter cannot be installed in this location.");
-            }
-        }
-
-        void Game::handleBuildArena() {
-            types::Position pos = cursor.getCurrentPosition();
-
-            auto arena = std::make_unique<managers::BuildingManager::Building>(
-                types::Camp::Harkonnen,
-                L"Arena",
-                L"투기장 (투사 생산)",
-                4,
-                pos,
-                2,
-                2,
-                15,
-                types::UnitType::Fighter
-            );
-
-            if (placeBuilding(std::move(arena))) {
-                if (resource.spice < 3) {
-                    display.addSystemMessage(L"Not enough spice to build arena");
-                }
-                else {
-                    display.addSystemMessage(L"The arena has been installed.");
-                    resource.spice -= 3;
-                }
-            }
-            else {
-                display.addSystemMessage(L"The arena cannot be installed in this location.");
-            }
-        }
-
-        void Game::handleBuildFactory() {
-            types::Position pos = cursor.getCurrentPosition();
-
-            auto factory = std::make_unique<managers::BuildingManager::Building>(
-                types::Camp::Harkonnen,
-                L"Factory",
-                L"공장 (중전차 생산)",
-                5,
-                pos,
-                2,
-                2,
-                30,
-                types::UnitType::HeavyTank
-            );
-
-            if (placeBuilding(std::move(factory))) {
-                if (resource.spice < 5) {
-                    display.addSystemMessage(L"Not enough spice to build factory");
-                }
-                else {
-                    display.addSystemMessage(L"The factory has been installed.");
-                    resource.spice -= 5;
-                }
-            }
-            else {
-                display.addSystemMessage(L"The factory cannot be installed in this location.");
-            }
+        void Game::handleProduceUnit(const Building* building) {
+            Command command;
+            command.type = CommandType::ProduceUnit;
+            command.source = building->getPosition();
+            command.target = cursor.getCurrentPosition();
+            simulation.execute(command);
         }
 
         types::Position Game::findEmptySpaceNearBuilding(const Building* building) {
@@ -637,223 +246,13 @@ namespace dune {
                     base_pos.column + dir.column
                 };
 
-                if (!map.getEntityAt<Unit>(check_pos) &&
-                    !map.getEntityAt<Building>(check_pos) &&
-                    map.getTerrainManager().getTerrain(check_pos).isWalkable()) {
+                if (!map.getOccupancy().isBlocked(check_pos)) {
                     return check_pos;
                 }
             }
             return { -1, -1 };  // 유효하지 않은 위치
         }
 
-        void Game::handleBuildHarvester(const Building* building) {
-            // 자원 체크
-            if (resource.spice < 5) {
-                display.addSystemMessage(L"Not enough spice");
-                return;
-            }
-            if (resource.population + 5 > resource.population_max) {
-                display.addSystemMessage(L"Not enough population capacity");
-                return;
-            }
-
-            // 커서 위치 가져오기
-            types::Position cursor_pos = cursor.getCurrentPosition();
-            types::Position base_pos = building->getPosition();
-
-            // 본진과 커서 사이의 거리 계산
-            int distance = utils::manhattanDistance(cursor_pos, base_pos);
-
-            // 거리가 10 이상이면 설치 불가
-            if (distance > 10) {
-                display.addSystemMessage(L"Too far from the base");
-                return;
-            }
-
-            // 설치 위치 유효성 검사
-            if (!map.getTerrainManager().getTerrain(cursor_pos).isWalkable() ||
-                map.getEntityAt<Unit>(cursor_pos) ||
-                map.getEntityAt<Building>(cursor_pos)) {
-                display.addSystemMessage(L"Cannot place harvester here");
-                return;
-            }
-
-           addHarvester(cursor_pos,
-                building->getType() == types::Camp::ArtLadies ?
-                types::Camp::ArtLadies : types::Camp::Harkonnen
-            );
-
-            // 자원 소비
-            resource.spice -= 5;
-            resource.population += 5;
-            display.addSystemMessage(L"A new harvester ready");
-        }
-
-        void Game::handleBuildSoldier(const Building* building) {
-            // 자원 체크
-            if (resource.spice < 1) {
-                display.addSystemMessage(L"Not enough spice");
-                return;
-            }
-            if (resource.population + 1 > resource.population_max) {
-                display.addSystemMessage(L"Not enough population capacity");
-                return;
-            }
-
-            // 커서 위치 가져오기
-            types::Position cursor_pos = cursor.getCurrentPosition();
-            types::Position base_pos = building->getPosition();
-
-            // 본진과 커서 사이의 거리 계산
-            int distance = utils::manhattanDistance(cursor_pos, base_pos);
-
-            // 거리가 20 이상이면 설치 불가
-            if (distance > 20) {
-                display.addSystemMessage(L"Too far from the base");
-                return;
-            }
-
-            // 설치 위치 유효성 검사
-            if (!map.getTerrainManager().getTerrain(cursor_pos).isWalkable() ||
-                map.getEntityAt<Unit>(cursor_pos) ||
-                map.getEntityAt<Building>(cursor_pos)) {
-                display.addSystemMessage(L"Cannot place Soldier here");
-                return;
-            }
-
-            // 보병 생성
-            addSoldier(cursor_pos, types::Camp::ArtLadies);
-
-            // 자원 소비
-            resource.spice -= 1;
-            resource.population += 1;
-            display.addSystemMessage(L"A new Soldier ready");
-        }
-
-        void Game::handleBuildFremen(const Building* building) {
-            // 자원 체크
-            if (resource.spice < 5) {
-                display.addSystemMessage(L"Not enough spice");
-                return;
-            }
-            if (resource.population + 2 > resource.population_max) {
-                display.addSystemMessage(L"Not enough population capacity");
-                return;
-            }
-
-            // 커서 위치 가져오기
-            types::Position cursor_pos = cursor.getCurrentPosition();
-            types::Position base_pos = building->getPosition();
-
-            // 본진과 커서 사이의 거리 계산
-            int distance = utils::manhattanDistance(cursor_pos, base_pos);
-
-            // 거리가 20 이상이면 설치 불가
-            if (distance > 20) {
-                display.addSystemMessage(L"Too far from the base");
-                return;
-            }
-
-            // 설치 위치 유효성 검사
-            if (!map.getTerrainManager().getTerrain(cursor_pos).isWalkable() ||
-                map.getEntityAt<Unit>(cursor_pos) ||
-                map.getEntityAt<Building>(cursor_pos)) {
-                display.addSystemMessage(L"Cannot place Fremen here");
-                return;
-            }
-
-            // 프레멘 생성
-            addFremen(cursor_pos, types::Camp::ArtLadies);
-
-            // 자원 소비
-            resource.spice -= 5;
-            resource.population += 2;
-            display.addSystemMessage(L"A new Fremen ready");
-        }
-
-        void Game::handleBuildFighter(const Building* building) {
-            // 자원 체크
-            if (resource.spice < 1) {
-                display.addSystemMessage(L"Not enough spice");
-                return;
-            }
-            if (resource.population + 1 > resource.population_max) {
-                display.addSystemMessage(L"Not enough population capacity");
-                return;
-            }
-
-            // 커서 위치 가져오기
-            types::Position cursor_pos = cursor.getCurrentPosition();
-            types::Position base_pos = building->getPosition();
-
-            // 본진과 커서 사이의 거리 계산
-            int distance = utils::manhattanDistance(cursor_pos, base_pos);
-
-            // 거리가 20 이상이면 설치 불가
-            if (distance > 20) {
-                display.addSystemMessage(L"Too far from the base");
-                return;
-            }
-
-            // 설치 위치 유효성 검사
-            if (!map.getTerrainManager().getTerrain(cursor_pos).isWalkable() ||
-                map.getEntityAt<Unit>(cursor_pos) ||
-                map.getEntityAt<Building>(cursor_pos)) {
-                display.addSystemMessage(L"Cannot place Soldier here");
-                return;
-            }
-
-            // 투사 생성
-            addFighter(cursor_pos, types::Camp::Harkonnen);
-
-            // 자원 소비
-            resource.spice -= 1;
-            resource.population += 1;
-            display.addSystemMessage(L"A new Fighter ready");
-        }
-
-        void Game::handleBuildH_Tank(const Building* building) {
-            // 자원 체크
-            if (resource.spice < 12) {
-                display.addSystemMessage(L"Not enough spice");
-                return;
-            }
-            if (resource.population + 5 > resource.population_max) {
-                display.addSystemMessage(L"Not enough population capacity");
-                return;
-            }
-
-            // 커서 위치 가져오기
-            types::Position cursor_pos = cursor.getCurrentPosition();
-            types::Position base_pos = building->getPosition();
-
-            // 본진과 커서 사이의 거리 계산
-            int distance = utils::manhattanDistance(cursor_pos, base_pos);
-
-            // 거리가 10 이상이면 설치 불가
-            if (distance > 10) {
-                display.addSystemMessage(L"Too far from the base");
-                return;
-            }
-
-            // 설치 위치 유효성 검사
-            if (!map.getTerrainManager().getTerrain(cursor_pos).isWalkable() ||
-                map.getEntityAt<Unit>(cursor_pos) ||
-                map.getEntityAt<Building>(cursor_pos)) {
-                display.addSystemMessage(L"Cannot place Heavy Tank here");
-                return;
-            }
-
-            // 중전차 생성
-            addHeavyTank(cursor_pos, types::Camp::Harkonnen);
-
-            // 자원 소비
-            resource.spice -= 12;
-            resource.population += 5;
-            display.addSystemMessage(L"A new Heavy Tank ready");
-        }
-
-
         void Game::handleSelection() {
             types::Position pos = cursor.getCurrentPosition();
             current_selection.position_ = pos;
@@ -866,8 +265,7 @@ namespace dune {
                 current_selection.selectedPtr_ = building; // const Building*
             } else {
                 current_selection.type_ = types::SelectionType::Terrain;
-                const Terrain& terrain = map.getTerrainManager().getTerrain(pos);
-                current_selection.selectedPtr_ = &terrain; // const Terrain*
+                current_selection.selectedPtr_ = map.getTerrainManager().getTerrain(pos); // Terrain 뷰
             }
         }
 
@@ -906,32 +304,24 @@ namespace dune {
                 break;
             case types::SelectionType::Building:
                 if (auto* building = current_selection.getSelected<Building>()) {
-                    status_text = L"Selected Building: " + building->getName();
-                    if (building->getName() == L"Base") {
-                        command_text = { 
-                            L"H: Produce Harvester", 
-                            L"Shift + P: Place Plate",
-                            L"Shift + D: Place Dormitory",
-                            L"Shift + G: Place Garage",
-                            L"Shift + K: Place Barracks",
-                            L"Shift + S: Place Shelter",
-                            L"ESC: Cancel"
-                        };
-                    }
-                    else if (building->getName() == L"Barracks") {
-                        command_text = { L"S: Produce Soldier", L"ESC: Cancel" };
+                    status_text = std::wstring(L"Selected Building: ") + building->getName();
+                    const auto& descriptor = building->getDescriptor();
+                    if (descriptor.produceCommand) {
+                        command_text.push_back(descriptor.produceCommand);
                     }
-                    else  if (building->getName() == L"Shelter") {
-                        command_text = { L"F: Produce Fremen", L"ESC: Cancel" };
+                    // 본진에서는 아군이 지을 수 있는 건물의 설치 키를 안내합니다.
+                    if (descriptor.type == types::BuildingType::Base) {
+                        for (const auto& placeable : entity::BUILDING_DESCRIPTORS) {
+                            if (placeable.placeCommand && placeable.camp != types::Camp::Harkonnen) {
+                                command_text.push_back(placeable.placeCommand);
+                            }
+                        }
                     }
-                    else if (building->getName() == L"Arena") {
-                        command_text = { L"R: Produce Fighter", L"ESC: Cancel" };
-                    }
-                    else if (building->getName() == L"Factory") {
-                        command_text = { L"T: Produce heavy Tank", L"ESC: Cancel" };
+                    if (command_text.empty()) {
+                        command_text = { L"No Actions Available" };
                     }
                     else {
-                        command_text = { L"No Actions Available" };
+                        command_text.push_back(L"ESC: Cancel");
                     }
                 }
                 break;
@@ -972,43 +362,12 @@ namespace dune {
             display.updateCommands(command_text);
         }
 
-        bool Game::placeBuilding(std::unique_ptr<managers::BuildingManager::Building> building) {
-            if (building->getName() == L"Plate") {
-                map.addBuilding(std::move(building));
-                return true; 
-            };
-            auto pos = building->getPosition();
-            const auto& terrainManager = map.getTerrainManager();
-
-            // 설치 위치 확인 (건물이 설치 가능한 위치인지 확인)
-            if (!building->isPlaceable(pos, terrainManager)) {
-                return false;
-            }
-
-            // **장판 확인 로직 추가**
-            for (int row = pos.row; row < pos.row + building->getHeight(); ++row) {
-                for (int col = pos.column; col < pos.column + building->getWidth(); ++col) {
-                    types::Position tilePos{ row, col };
-
-                    // 장판이 없는 경우 설치 불가
-                    if (terrainManager.getTerrain(tilePos).getType() != types::TerrainType::Plate) {
-                        display.addSystemMessage(L"A Plate is required to build here.");
-                        return false;
-                    }
-                }
-            }
-            // 건물을 맵에 추가
-            map.addBuilding(std::move(building));
-            return true;
-        }
-
         void Game::showUnitList() {
             std::map<wchar_t, int> unitCounts;
             std::wstring status_text = L"Unit List:\n";
 
             const auto& units = map.getUnitManager().getUnits();
-            for (const auto& entry : units) {
-                const auto& unit = entry.second;
+            for (const auto& unit : units) {
                 wchar_t representation = unit->getRepresentation();
                 unitCounts[representation]++;
             }
@@ -1023,87 +382,20 @@ namespace dune {
         void Game::handleUnitCommands(types::Key key) {
             if (current_selection.type_ != types::SelectionType::Unit) return;
 
-            const auto* const_unit = current_selection.getSelected<core::Selection::Unit>();
-            if (!const_unit) return;
-
-            auto* unit = const_cast<Unit*>(const_unit);
-
-            // 선택된 유닛의 위치와 커서 위치
-            types::Position unitPos = unit->getPosition();
-            types::Position targetPos = cursor.getCurrentPosition();
-
-            switch (unit->getType()) {
-            case types::UnitType::Harvester:
-                handleHarvesterCommands(unit, key, targetPos);
-                break;
-
-            case types::UnitType::Soldier:
-            case types::UnitType::Fremen:
-            case types::UnitType::Fighter:
-            case types::UnitType::HeavyTank:
-                handleCombatUnitCommands(unit, key, targetPos);
-                break;
-
-            default:
-                break;
-            }
-        }
-
-        void Game::handleHarvesterCommands(Unit* unit, types::Key key, const types::Position& targetPos) {
-            auto* harvesterAI = unit->getHarvesterAI();
-            if (!harvesterAI) {
-                display.addSystemMessage(L"[DEBUG] No harvester AI found in handleHarvesterCommands");
-                return;
-            }
-
-            if (key == types::Key::Move) {
-                display.addSystemMessage(L"[DEBUG] Processing Move command");
-                harvesterAI->giveMoveCommand(unit, map, targetPos, sys_clock);
-            }
-            else if (key == types::Key::Harvest) {
-                display.addSystemMessage(L"[DEBUG] Processing Harvest command");
-                const auto& terrain = map.getTerrainManager().getTerrain(targetPos);
-                if (terrain.getType() == types::TerrainType::Spice) {
-                    display.addSystemMessage(L"[DEBUG] Found spice at target location");
-                    harvesterAI->giveHarvestCommand(unit, map, targetPos, sys_clock);
-                }
-                else {
-                    display.addSystemMessage(L"Cannot harvest here: No spice found.");
-                }
-            }
-
-            display.addSystemMessage(L"[DEBUG] Command processing completed");
-        }
-
-        void Game::handleCombatUnitCommands(Unit* unit, types::Key key, const types::Position& targetPos) {
-            auto* combatAI = unit->getCombatUnitAI();
-            if (!combatAI) return;
+            const auto* unit = current_selection.getSelected<core::Selection::Unit>();
+            if (!unit) return;
 
+            Command command;
             switch (key) {
-            case types::Key::Move:
-                combatAI->moveCommand(targetPos);
-                break;
-
-            case types::Key::Patrol:
-                combatAI->patrolCommand(unit->getPosition(), targetPos);
-                break;
-
-            case types::Key::Attack:
-                if (auto* targetUnit = map.getEntityAt<Unit>(targetPos)) {
-                    if (targetUnit->getCamp() != unit->getCamp()) {
-                        combatAI->attackCommand(targetUnit);
-                    }
-                    else {
-                        display.addSystemMessage(L"Cannot attack friendly units.");
-                    }
-                }
-                else {
-                    display.addSystemMessage(L"No target found at selected position.");
-                }
-                break;
-            default:
-                break;
-            }
+            case types::Key::Move:    command.type = CommandType::Move;    break;
+            case types::Key::Harvest: command.type = CommandType::Harvest; break;
+            case types::Key::Attack:  command.type = CommandType::Attack;  break;
+            case types::Key::Patrol:  command.type = CommandType::Patrol;  break;
+            default: return;
+            }
+            command.source = unit->getPosition();
+            command.target = cursor.getCurrentPosition();
+            simulation.execute(command);
         }
 
     } // namespace core
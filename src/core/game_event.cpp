@@ -0,0 +1,22 @@
+#include "core/game_event.hpp"
+
+namespace dune {
+    namespace core {
+
+        void EventBus::subscribe(Handler handler) {
+            handlers_.push_back(std::move(handler));
+        }
+
+        void EventBus::dispatch() {
+            // 구독자가 사건을 더 발행하면 벡터가 재할당될 수 있으므로 인덱스로 돌고 사건은 복사해 전달합니다.
+            for (std::size_t i = 0; i < pending_.size(); ++i) {
+                const GameEvent event = pending_[i];
+                for (const auto& handler : handlers_) {
+                    handler(event);
+                }
+            }
+            pending_.clear();
+        }
+
+    } // namespace core
+} // namespace dune
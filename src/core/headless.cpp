@@ -0,0 +1,148 @@
+#include "core/profiler.hpp"
+#include "core/simulation.hpp"
+#include "core/snapshot.hpp"
+#include "utils/command_line.hpp"
+#include "utils/log.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace dune::core;
+
+namespace {
+    const char* const USAGE =
+        "usage: headless [--games N] [--ticks N] [--threads N] [--log FILE] [--seed N]\n"
+        "                [--load FILE] [--save FILE] [--planner-rollouts N] [--planner-budget-us N]\n"
+        "                [--profile FILE] [--trace FILE]\n";
+}
+
+/**
+ * @brief 콘솔 없이 시뮬레이션만 최대 속도로 실행하는 헤드리스 진입점입니다.
+ * 사용법: headless [--games 게임 수 (기본 1)] [--ticks 게임당 틱 수 (기본 100000)] [--threads 작업 스레드 수 (기본 1)]
+ *                  [--log 로그 파일 (기본 없음)]
+ *                  [--seed 경기 시드 (기본 RandomStreams::DEFAULT_SEED, 게임마다 1씩 증가)]
+ *                  [--load 시작 스냅샷 (기본 없음, 주면 게임마다 이 상태에서 이어 가며 시드는 무시)]
+ *                  [--save 끝 스냅샷 (기본 없음, 마지막 게임이 끝난 상태를 저장)]
+ *                  [--planner-rollouts 전술 계획기 롤아웃 수 (기본 없음은 계획기 꺼짐, 주면 롤아웃 수만 제한해 재현 가능)]
+ *                  [--planner-budget-us 전술 계획기 시간 예산 (기본 없음, 0보다 크면 계획기를 켜고 시간으로 제한해 재현되지 않음)]
+ *                  [--profile 프로파일 보고서 (기본 없음, 주면 틱별 구간 시간을 모아 종료할 때 저장)]
+ *                  [--trace 타임라인 파일 (기본 없음, 주면 Chrome Trace Event JSON으로 저장)]
+ */
+int main(int argc, char* argv[]) {
+    dune::utils::CommandLine commandLine;
+    const bool parsed = commandLine.parse(argc, argv, {
+        { "--games", true }, { "--ticks", true }, { "--threads", true }, { "--log", false },
+        { "--seed", true }, { "--load", false }, { "--save", false }, { "--planner-rollouts", true },
+        { "--planner-budget-us", true }, { "--profile", false }, { "--trace", false } });
+    if (!parsed || !commandLine.getPositionals().empty()) {
+        std::cerr << (parsed ? "unexpected argument: " + commandLine.getPositionals().front() : commandLine.getError())
+                  << '\n' << USAGE;
+        return 1;
+    }
+    const std::uint64_t games = commandLine.getNumber("--games", 1);
+    const std::uint64_t ticksPerGame = commandLine.getNumber("--ticks", 100000);
+    const std::size_t threads = static_cast<std::size_t>(commandLine.getNumber("--threads", 1));
+    const std::string logPath = commandLine.getString("--log");
+    const std::uint64_t seed = commandLine.getNumber("--seed", dune::utils::RandomStreams::DEFAULT_SEED);
+    const std::string loadPath = commandLine.getString("--load");
+    const std::string savePath = commandLine.getString("--save");
+    const bool usePlanner = commandLine.has("--planner-rollouts") || commandLine.has("--planner-budget-us");
+    const std::chrono::microseconds plannerBudget(commandLine.getNumber("--planner-budget-us", 0));
+    const std::string profilePath = commandLine.getString("--profile");
+    const std::string tracePath = commandLine.getString("--trace");
+
+    if (!logPath.empty() && !dune::utils::Logger::instance().open(logPath, dune::utils::LogLevel::Debug)) {
+        std::cerr << "cannot open log file: " << logPath << '\n';
+        return 1;
+    }
+
+    dune::entity::combat::TacticalPlannerConfig plannerConfig;
+    plannerConfig.rollouts = static_cast<std::uint32_t>(
+        commandLine.getNumber("--planner-rollouts", plannerConfig.rollouts));
+    if (plannerBudget.count() > 0) {
+        plannerConfig.timeBudget = plannerBudget;
+        plannerConfig.deterministic = false;
+    }
+
+    if (!profilePath.empty()) {
+        Profiler::instance().setReportPath(profilePath);
+        Profiler::instance().setEnabled(true);
+    }
+    if (!tracePath.empty()) {
+        TraceRecorder::instance().start(tracePath);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t totalTicks = 0;
+    dune::pathfinding::PathCacheStats pathStats;
+    dune::entity::combat::TacticalPlannerStats plannerStats;
+
+    for (std::uint64_t game = 0; game < games; ++game) {
+        std::unique_ptr<Simulation> simulation;
+        if (loadPath.empty()) {
+            simulation = std::make_unique<Simulation>(nullptr, seed + game);
+        }
+        else if (!(simulation = loadSnapshot(loadPath))) {
+            std::cerr << "cannot read snapshot: " << loadPath << '\n';
+            return 1;
+        }
+        const std::uint64_t startTick = simulation->getTickCount();
+        simulation->setThreadCount(threads);
+        if (usePlanner) {
+            simulation->setTacticalPlanner(std::make_unique<dune::entity::combat::TacticalPlanner>(plannerConfig));
+        }
+        simulation->run(ticksPerGame);
+        totalTicks += simulation->getTickCount() - startTick;
+
+        const auto& stats = simulation->getMap().getPathCache().getStats();
+        pathStats.hits += stats.hits;
+        pathStats.misses += stats.misses;
+        pathStats.invalidations += stats.invalidations;
+        if (const auto* planner = simulation->getTacticalPlanner()) {
+            plannerStats.decisions += planner->getStats().decisions;
+            plannerStats.rollouts += planner->getStats().rollouts;
+            plannerStats.commands += planner->getStats().commands;
+            plannerStats.budgetStops += planner->getStats().budgetStops;
+        }
+
+        if (game + 1 == games && !savePath.empty() && !saveSnapshot(*simulation, savePath)) {
+            std::cerr << "cannot write snapshot: " << savePath << '\n';
+            return 1;
+        }
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    double seconds = elapsed.count() / 1e6;
+
+    std::cout << "games: " << games
+        << ", threads: " << threads
+        << ", seed: " << seed
+        << ", ticks: " << totalTicks
+        << ", elapsed: " << seconds << " s"
+        << ", ticks/s: " << (seconds > 0 ? totalTicks / seconds : 0.0)
+        << '\n';
+    std::cout << "path cache hits: " << pathStats.hits
+        << ", misses: " << pathStats.misses
+        << ", invalidations: " << pathStats.invalidations
+        << '\n';
+    if (TraceRecorder::instance().isRecording()) {
+        const std::uint64_t dropped = TraceRecorder::instance().getDroppedCount();
+        if (!TraceRecorder::instance().stop()) {
+            std::cerr << "cannot write trace: " << tracePath << '\n';
+            return 1;
+        }
+        std::cout << "trace: " << tracePath << ", dropped events: " << dropped << '\n';
+    }
+    if (usePlanner) {
+        std::cout << "planner decisions: " << plannerStats.decisions
+            << ", rollouts: " << plannerStats.rollouts
+            << ", commands: " << plannerStats.commands
+            << ", budget stops: " << plannerStats.budgetStops
+            << '\n';
+    }
+
+    return 0;
+}
@@ -35,7 +35,7 @@ namespace dune {
                     current_key = types::Key::Build_Plate;
                 }
                 else {
-                    current_key = types::Key::Undefined;
+                    current_key = types::Key::ToggleProfiler;
                 }
                 break;
 
@@ -96,6 +96,10 @@ namespace dune {
             case 'u': case 'U':
                 current_key = types::Key::ShowUnitList;
                 break;
+
+            case 'l': case 'L':
+                current_key = types::Key::ToggleTrace;
+                break;
                 // 유닛 명령 (Shift 없이)
             case 'h':
                  current_key = types::Key::Build_Harvester;
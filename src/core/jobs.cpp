@@ -0,0 +1,160 @@
+#include "core/jobs.hpp"
+#include <algorithm>
+
+namespace dune {
+    namespace core {
+
+        namespace {
+            // 작업자 스레드가 속한 JobSystem과 작업자 번호
+            thread_local const JobSystem* currentSystem = nullptr;
+            thread_local std::size_t currentWorker = 0;
+        }
+
+        void Job::run(std::size_t worker) {
+            if (range_) {
+                (*range_)(begin_, end_, worker);
+            }
+            else if (function_) {
+                function_();
+            }
+        }
+
+        JobSystem::JobSystem(std::size_t threadCount) {
+            threadCount = std::max<std::size_t>(threadCount, 1);
+            deques_.reserve(threadCount);
+            for (std::size_t i = 0; i < threadCount; ++i) {
+                deques_.push_back(std::make_unique<WorkStealingDeque<Job*>>(DEQUE_CAPACITY));
+            }
+            threads_.reserve(threadCount - 1);
+            for (std::size_t i = 1; i < threadCount; ++i) {
+                threads_.emplace_back(&JobSystem::workerLoop, this, i);
+            }
+        }
+
+        JobSystem::~JobSystem() {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                stopping_.store(true);
+            }
+            sleepCondition_.notify_all();
+            for (auto& thread : threads_) {
+                thread.join();
+            }
+        }
+
+        std::size_t JobSystem::getCurrentWorker() const {
+            return currentSystem == this ? currentWorker : 0;
+        }
+
+        void JobSystem::submit(Job& job) {
+            release(job);
+        }
+
+        void JobSystem::wait(Job& job) {
+            const std::size_t worker = getCurrentWorker();
+            while (!job.isDone()) {
+                if (!runOne(worker)) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void JobSystem::parallelFor(std::size_t count, std::size_t grain, const RangeFunction& body) {
+            if (count == 0) return;
+            grain = std::max<std::size_t>(grain, 1);
+
+            // 한 구간이거나 작업자가 하나면 그 자리에서 실행합니다.
+            const std::size_t chunkCount = (count + grain - 1) / grain;
+            if (chunkCount == 1 || deques_.size() == 1) {
+                body(0, count, getCurrentWorker());
+                return;
+            }
+
+            auto jobs = std::make_unique<Job[]>(chunkCount);
+            // 덱은 최근 것부터 꺼내므로 뒤 구간부터 넣어 호출자가 앞 구간부터 처리하게 합니다.
+            for (std::size_t chunk = chunkCount; chunk-- > 0;) {
+                Job& job = jobs[chunk];
+                job.range_ = &body;
+                job.begin_ = chunk * grain;
+                job.end_ = std::min(job.begin_ + grain, count);
+                submit(job);
+            }
+            for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                wait(jobs[chunk]);
+            }
+        }
+
+        void JobSystem::workerLoop(std::size_t worker) {
+            currentSystem = this;
+            currentWorker = worker;
+
+            int idleSpins = 0;
+            while (!stopping_.load(std::memory_order_relaxed)) {
+                if (runOne(worker)) {
+                    idleSpins = 0;
+                    continue;
+                }
+                if (++idleSpins < IDLE_SPINS) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                // 제출하는 쪽은 queuedJobs_를 올린 뒤 sleepingWorkers_를 보므로, 먼저 잠들 것을 알립니다.
+                std::unique_lock<std::mutex> lock(sleepMutex_);
+                sleepingWorkers_.fetch_add(1);
+                sleepCondition_.wait(lock, [this] {
+                    return stopping_.load() || queuedJobs_.load() > 0;
+                });
+                sleepingWorkers_.fetch_sub(1);
+                idleSpins = 0;
+            }
+        }
+
+        void JobSystem::release(Job& job) {
+            if (job.pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                enqueue(job);
+            }
+        }
+
+        void JobSystem::enqueue(Job& job) {
+            const std::size_t worker = getCurrentWorker();
+            // 꺼내는 쪽이 먼저 줄이지 않도록 넣기 전에 셉니다.
+            queuedJobs_.fetch_add(1);
+            if (!deques_[worker]->push(&job)) {
+                // 덱이 가득 차면 기다리지 않고 바로 실행합니다.
+                queuedJobs_.fetch_sub(1);
+                execute(job, worker);
+                return;
+            }
+            if (sleepingWorkers_.load() > 0) {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                sleepCondition_.notify_one();
+            }
+        }
+
+        void JobSystem::execute(Job& job, std::size_t worker) {
+            job.run(worker);
+            for (Job* successor : job.successors_) {
+                release(*successor);
+            }
+            // done_을 세운 뒤에는 소유자가 작업을 해제할 수 있으므로 마지막에 표시합니다.
+            job.done_.store(true, std::memory_order_release);
+        }
+
+        bool JobSystem::runOne(std::size_t worker) {
+            Job* job = nullptr;
+            bool found = deques_[worker]->pop(job);
+            // 자기 덱이 비면 다음 작업자부터 차례로 훔쳐 봅니다.
+            for (std::size_t i = 1; !found && i < deques_.size(); ++i) {
+                found = deques_[(worker + i) % deques_.size()]->steal(job);
+            }
+            if (!found) {
+                return false;
+            }
+            queuedJobs_.fetch_sub(1);
+            execute(*job, worker);
+            return true;
+        }
+
+    } // namespace core
+} // namespace dune
@@ -1,30 +1,118 @@
 #include "core/map.hpp"
-#include "ui/window/message_window.hpp"
+#include "core/profiler.hpp"
+#include "entity/building_descriptor.hpp"
 #include "utils/utils.hpp"
+#include "utils/constants.hpp"
+#include "utils/log.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <unordered_set>
 
 namespace dune {
     namespace core {
 
-        Map::Map(int width, int height, ui::MessageWindow* messageWindow)
+        Map::Map(int width, int height, MessageHandler messageHandler)
             : width_(width)
             , height_(height)
+            , occupancy_(width, height)
             , terrainManager_(width, height)
-            , messageWindow_(messageWindow) {
-            // 필요한 초기화 작업을 수행합니다.
+            , unitManager_(width, height)
+            , buildingManager_(width, height)
+            , messageHandler_(std::move(messageHandler))
+            , planContexts_(1) {
+            terrainManager_.attachOccupancy(&occupancy_);
+            unitManager_.attachOccupancy(&occupancy_);
+            buildingManager_.attachOccupancy(&occupancy_);
+
+            // 지형/건물이 바뀐 타일을 지나는 캐시 경로를 폐기합니다.
+            terrainManager_.setChangeHandler([this](const types::Position& position) {
+                journalPathCache();
+                pathCache_.invalidateArea(position, 1, 1);
+                clusterGraph_.markDirty(position, 1, 1);
+                flowFieldCache_.invalidateArea(*this, position, 1, 1);
+            });
+            buildingManager_.setChangeHandler([this](const Building& building) {
+                journalPathCache();
+                pathCache_.invalidateArea(building.getPosition(), building.getWidth(), building.getHeight());
+                clusterGraph_.markDirty(building.getPosition(), building.getWidth(), building.getHeight());
+                flowFieldCache_.invalidateArea(*this, building.getPosition(), building.getWidth(), building.getHeight());
+            });
         }
 
         void Map::update(std::chrono::milliseconds currentTime) {
-            // 각 유닛을 업데이트합니다.
-           for (const auto& entry : unitManager_.getUnits()) {
-                // entry는 pair<const types::Position, std::unique_ptr<Unit>> 이므로
-                // 실제 유닛 객체는 entry.second-> 를 통해 접근해야 합니다.
-                const auto& unitPtr = entry.second; // std::unique_ptr<Unit>에 대한 참조
-                // unitPtr는 unique_ptr<Unit>이므로 unitPtr->getType() 형태로 호출 가능
-                switch (unitPtr->getType()) {
+            ProfileScope updateScope(ProfileZone::MapUpdate);
+            // 이번 틱까지 예약된 유닛만 꺼냅니다. 다시 예약되어 틱이 달라진 항목은 버립니다.
+            const std::uint64_t tick = static_cast<std::uint64_t>(currentTime.count() / constants::TICK);
+            dueSlots_.clear();
+            scheduler_.advance(tick, [this](std::uint32_t id, std::uint64_t dueTick) {
+                if (id >= wakeTickById_.size() || wakeTickById_[id] != dueTick) {
+                    return;
+                }
+                journalUnit(id);
+                wakeTickById_[id] = TimingWheel<std::uint32_t>::NO_TICK;
+                const std::size_t slot = unitManager_.getSlotOfId(id);
+                if (slot != managers::UnitManager::NO_SLOT) {
+                    dueSlots_.push_back(slot);
+                }
+            });
+            // 매 틱 전체를 돌던 때와 같은 순서로 업데이트하도록 칸 번호 순으로 정렬합니다.
+            std::sort(dueSlots_.begin(), dueSlots_.end());
+            updateScope.setTraceArgs({ static_cast<std::int32_t>(dueSlots_.size()) });
+
+            // 계획 단계: 맵을 읽기만 하며 각 유닛이 자기 상태에 경로/목표를 준비합니다.
+            // 구간 작업은 중간에 기다리지 않으므로 작업자 하나가 버퍼 하나를 독점합니다.
+            const JobSystem::RangeFunction planRange = [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                PlanContext& context = planContexts_[worker];
+                for (std::size_t i = begin; i < end; ++i) {
+                    context.order = i;
+                    planUnit(dueSlots_[i], context, currentTime);
+                }
+            };
+            {
+                ProfileScope planScope(ProfileZone::MapPlan);
+                if (jobs_) {
+                    jobs_->parallelFor(dueSlots_.size(), PLAN_GRAIN, planRange);
+                }
+                else {
+                    planRange(0, dueSlots_.size(), 0);
+                }
+            }
+
+            // 작업자별로 모인 경로 캐시 갱신을 유닛 순서대로 반영합니다.
+            for (auto& context : planContexts_) {
+                std::move(context.cacheUpdates.begin(), context.cacheUpdates.end(), std::back_inserter(cacheUpdates_));
+                context.cacheUpdates.clear();
+            }
+            std::stable_sort(cacheUpdates_.begin(), cacheUpdates_.end(),
+                [](const pathfinding::PathCacheUpdate& a, const pathfinding::PathCacheUpdate& b) {
+                    return a.order < b.order;
+                });
+            if (!cacheUpdates_.empty()) {
+                journalPathCache();
+            }
+            for (const auto& cacheUpdate : cacheUpdates_) {
+                pathCache_.apply(cacheUpdate);
+            }
+            cacheUpdates_.clear();
+
+            // 반영 단계: 깨어난 유닛을 순서대로 업데이트합니다.
+            ProfileScope applyScope(ProfileZone::MapApply);
+            // 업데이트 중 제거된 유닛은 collectRemovedUnits() 전까지 칸이 남아 있으므로 건너뜁니다.
+            for (const std::size_t slot : dueSlots_) {
+                if (!unitManager_.isSlotActive(slot)) {
+                    continue;
+                }
+                Unit* unit = unitManager_.getUnitInSlot(slot);
+                // AI가 없는 유닛은 다음 틱에 다시 확인합니다.
+                std::chrono::milliseconds nextUpdateTime = currentTime;
+                switch (unit->getType()) {
                     case types::UnitType::Sandworm:
-                        if (auto* sandwormAI = unitPtr->getSandwormAI()) {
-                            sandwormAI->update(unitPtr.get(), *this, currentTime);
+                        if (auto* sandwormAI = unit->getSandwormAI()) {
+                            ProfileScope unitScope(Profiler::unitZone(types::UnitType::Sandworm, sandwormAI->getStateKind()));
+                            sandwormAI->update(unit, *this, currentTime);
+                            nextUpdateTime = sandwormAI->getNextUpdateTime(unit, currentTime);
                         }
                         else {
                             addSystemMessage(L"Cannot Initialize S AI");
@@ -32,9 +120,10 @@ namespace dune {
                         break;
 
                     case types::UnitType::Harvester:
-                        if (auto* harvesterAI = unitPtr->getHarvesterAI()) {
-                            addSystemMessage(L"[DEBUG] Updating harvester AI");
-                            harvesterAI->update(unitPtr.get(), *this, currentTime);
+                        if (auto* harvesterAI = unit->getHarvesterAI()) {
+                            ProfileScope unitScope(Profiler::unitZone(types::UnitType::Harvester, harvesterAI->getStateKind()));
+                            harvesterAI->update(unit, *this, currentTime);
+                            nextUpdateTime = harvesterAI->getNextUpdateTime(unit, currentTime);
                         }
                         else {
                             addSystemMessage(L"Cannot Initialize H AI");
@@ -45,8 +134,10 @@ namespace dune {
                     case types::UnitType::Fremen:
                     case types::UnitType::Fighter:
                     case types::UnitType::HeavyTank:
-                        if (auto* combatAI = unitPtr->getCombatUnitAI()) {
+                        if (auto* combatAI = unit->getCombatUnitAI()) {
+                            ProfileScope unitScope(Profiler::unitZone(unit->getType(), combatAI->getStateKind()));
                             combatAI->update(*this, currentTime);
+                            nextUpdateTime = combatAI->getNextUpdateTime(currentTime);
                         }
                         else {
                             addSystemMessage(L"Cannot Initialize C AI");
@@ -55,18 +146,176 @@ namespace dune {
                     default:
                         break;
                 }
+
+                // 업데이트 중 제거된 유닛과 깨울 필요가 없는 유닛은 예약하지 않습니다.
+                if (!unitManager_.isSlotActive(slot) || nextUpdateTime == std::chrono::milliseconds::max()) {
+                    continue;
+                }
+                // 예약 시간이 속한 틱 이후 첫 틱에 깨웁니다. (지난 시간이면 다음 틱)
+                const auto wakeTime = std::max<std::chrono::milliseconds::rep>(nextUpdateTime.count(), 0);
+                scheduleWake(unit->getId(), static_cast<std::uint64_t>((wakeTime + constants::TICK - 1) / constants::TICK));
+            }
+
+            releaseRemovedTargets();
+            unitManager_.collectRemovedUnits();
+            pruneGroupMoves();
+        }
+
+        void Map::advanceIdle(std::chrono::milliseconds currentTime) {
+            // 건너뛴 틱에는 꺼낼 항목이 없으므로 (있어도 이미 무효가 된 항목) 시간만 진행합니다.
+            const std::uint64_t tick = static_cast<std::uint64_t>(currentTime.count() / constants::TICK);
+            if (tick > scheduler_.now()) {
+                scheduler_.advance(tick - 1, [](std::uint32_t, std::uint64_t) {});
+            }
+            pruneGroupMoves();
+        }
+
+        void Map::pruneGroupMoves() {
+            std::erase_if(groupMoves_, [&](const GroupMove& order) {
+                return order.tick + GROUP_MOVE_WINDOW <= scheduler_.now() || !unitManager_.findUnitById(order.unitId);
+            });
+        }
+
+        void Map::releaseRemovedTargets() {
+            if (!unitManager_.hasRemovedUnits()) {
+                return;
+            }
+            removedUnits_.clear();
+            for (std::size_t slot = 0; slot < unitManager_.getSlotCount(); ++slot) {
+                if (!unitManager_.isSlotActive(slot)) {
+                    removedUnits_.push_back(unitManager_.getUnitInSlot(slot));
+                }
+            }
+            std::sort(removedUnits_.begin(), removedUnits_.end(), std::less<>());
+            for (std::size_t slot = 0; slot < unitManager_.getSlotCount(); ++slot) {
+                if (!unitManager_.isSlotActive(slot)) {
+                    continue;
+                }
+                Unit* unit = unitManager_.getUnitInSlot(slot);
+                auto* combatAI = unit->getCombatUnitAI();
+                if (combatAI && combatAI->holdsTargetIn(removedUnits_)) {
+                    journalUnit(unit->getId());
+                    combatAI->releaseTargets(removedUnits_);
+                }
             }
         }
 
+        void Map::planUnit(std::size_t slot, PlanContext& context, std::chrono::milliseconds currentTime) const {
+            Unit* unit = unitManager_.getUnitInSlot(slot);
+            switch (unit->getType()) {
+                case types::UnitType::Sandworm:
+                    if (auto* sandwormAI = unit->getSandwormAI()) {
+                        ProfileScope unitScope(Profiler::unitZone(types::UnitType::Sandworm, sandwormAI->getStateKind()));
+                        sandwormAI->plan(unit, *this, context, currentTime);
+                    }
+                    break;
+
+                case types::UnitType::Harvester:
+                    if (auto* harvesterAI = unit->getHarvesterAI()) {
+                        ProfileScope unitScope(Profiler::unitZone(types::UnitType::Harvester, harvesterAI->getStateKind()));
+                        harvesterAI->plan(unit, *this, context, currentTime);
+                    }
+                    break;
+
+                case types::UnitType::Soldier:
+                case types::UnitType::Fremen:
+                case types::UnitType::Fighter:
+                case types::UnitType::HeavyTank:
+                    if (auto* combatAI = unit->getCombatUnitAI()) {
+                        ProfileScope unitScope(Profiler::unitZone(unit->getType(), combatAI->getStateKind()));
+                        combatAI->plan(*this, context, currentTime);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void Map::setJobSystem(JobSystem* jobs) {
+            jobs_ = jobs;
+            planContexts_.resize(jobs_ ? jobs_->getThreadCount() : 1);
+        }
+
         void Map::addUnit(std::unique_ptr<Unit> unit) {
+            const Unit* raw = unit.get();
             unitManager_.addUnit(std::move(unit));
+            wakeUnit(raw);
+        }
+
+        void Map::wakeUnit(const Unit* unit) {
+            if (unitManager_.isActive(unit)) {
+                scheduleWake(unit->getId(), scheduler_.now());
+            }
+        }
+
+        bool Map::orderMove(Unit* unit, const types::Position& goal) {
+            auto* ai = unit->getCombatUnitAI();
+            if (!ai) {
+                return false;
+            }
+
+            touchUnit(unit);
+            // 같은 유닛의 이전 명령은 새 명령으로 바뀌었으므로 무리에서 뺍니다.
+            std::erase_if(groupMoves_, [&](const GroupMove& order) { return order.unitId == unit->getId(); });
+            const auto sameGoal = [&](const GroupMove& order) { return order.goal == goal; };
+            const std::size_t groupSize = static_cast<std::size_t>(std::count_if(groupMoves_.begin(), groupMoves_.end(), sameGoal)) + 1;
+            groupMoves_.push_back({ unit->getId(), goal, scheduler_.now() });
+            if (groupSize < GROUP_MOVE_SIZE) {
+                ai->moveCommand(goal, entity::combat::MoveMode::Path);
+                return true;
+            }
+
+            // 무리가 막 채워졌으면 앞서 경로로 보낸 유닛도 흐름장으로 바꿉니다. (그 사이 다른 명령을 받았거나 도착한 유닛은 제외)
+            if (groupSize == GROUP_MOVE_SIZE) {
+                for (const auto& order : groupMoves_) {
+                    Unit* member = order.unitId != unit->getId() && order.goal == goal
+                        ? unitManager_.findUnitById(order.unitId) : nullptr;
+                    auto* memberAI = member ? member->getCombatUnitAI() : nullptr;
+                    if (memberAI && memberAI->getStateKind() == entity::combat::CombatStateKind::Moving &&
+                        memberAI->getMoveTarget() == goal) {
+                        touchUnit(member);
+                        memberAI->moveCommand(goal, entity::combat::MoveMode::FlowField);
+                    }
+                }
+            }
+            ai->moveCommand(goal, entity::combat::MoveMode::FlowField);
+            return true;
+        }
+
+        bool Map::getNextWakeTime(std::chrono::milliseconds& time) const {
+            const std::uint64_t tick = scheduler_.nextDueTick();
+            if (tick == TimingWheel<std::uint32_t>::NO_TICK) {
+                return false;
+            }
+            time = std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(tick) * constants::TICK);
+            return true;
+        }
+
+        void Map::scheduleWake(std::uint32_t unitId, std::uint64_t tick) {
+            if (unitId >= wakeTickById_.size()) {
+                wakeTickById_.resize(unitManager_.getIdCount(), TimingWheel<std::uint32_t>::NO_TICK);
+            }
+            // 지난 틱은 스케줄러가 now()로 당기므로 유효 틱도 같이 맞춥니다.
+            tick = std::max(tick, scheduler_.now());
+            // 더 이른 예약이 있으면 그 틱에 깨어나 다시 예약하므로 그대로 둡니다.
+            std::uint64_t& scheduled = wakeTickById_[unitId];
+            if (scheduled <= tick) {
+                return;
+            }
+            journalUnit(unitId);
+            scheduled = tick;
+            scheduler_.schedule(tick, unitId);
         }
 
         void Map::addBuilding(std::unique_ptr<Building> building) {
+            journalBuildings();
             buildingManager_.addBuilding(std::move(building));
         }
 
         void Map::setTerrain(const types::Position& position, types::TerrainType type) {
+            if (isJournaling() && terrainManager_.isValidPosition(position)) {
+                tileJournal_.push_back({ position, terrainManager_.getType(position) });
+            }
             terrainManager_.setTerrain(position, type);
         }
 
@@ -79,7 +328,7 @@ namespace dune {
 
             while (true) {
                 // 검색 반경 내 유닛 쿼리
-                unitManager_.getQuadTree().queryRange(
+                unitManager_.getSpatialIndex().queryRange(
                     fromPosition.column - searchRadius,
                     fromPosition.row - searchRadius,
                     searchRadius * 2,
@@ -121,28 +370,148 @@ namespace dune {
         }
 
 
+        bool Map::moveUnit(Unit* unit, const types::Position& newPosition) {
+            touchUnit(unit);
+            return unitManager_.relocate(unit, newPosition);
+        }
+
+        void Map::setUnitHealth(Unit* unit, int health) {
+            touchUnit(unit);
+            unit->setHealth(health);
+        }
+
+        void Map::touchUnit(const Unit* unit) {
+            if (unit) {
+                journalUnit(unit->getId());
+            }
+        }
+
+        bool Map::findPath(const types::Position& start, const types::Position& goal, std::vector<types::Position>& path) {
+            return pathfinder_.findPath(*this, start, goal, path);
+        }
+
+        bool Map::findCachedPath(const Unit* unit, const types::Position& goal, std::vector<types::Position>& path) {
+            journalPathCache();
+            return pathCache_.findPath(pathfinder_, *this, unit->getPosition(), goal,
+                pathfinding::movementClassOf(unit->getType()), path);
+        }
+
+        std::shared_ptr<const pathfinding::FlowField> Map::acquireFlowField(const types::Position& goal) {
+            return flowFieldCache_.acquire(*this, goal);
+        }
+
+        bool Map::findHierarchicalPath(
+            const Unit* unit,
+            const types::Position& goal,
+            std::vector<types::Position>& waypoints,
+            std::vector<types::Position>& path
+        ) {
+            const types::Position start = unit->getPosition();
+            if (waypoints.empty()) {
+                if (utils::manhattanDistance(start, goal) <= LONG_PATH_DISTANCE) {
+                    return findCachedPath(unit, goal, path);
+                }
+                if (!clusterGraph_.findRoute(*this, start, goal, waypoints)) {
+                    return false;
+                }
+            }
+
+            return refineRoute(pathfinder_, start, goal, waypoints, path);
+        }
+
+        bool Map::planPath(
+            PlanContext& context,
+            const types::Position& start,
+            const types::Position& goal,
+            std::vector<types::Position>& path
+        ) const {
+            return context.pathfinder.findPath(*this, start, goal, path);
+        }
+
+        bool Map::planCachedPath(
+            PlanContext& context,
+            const Unit* unit,
+            const types::Position& goal,
+            std::vector<types::Position>& path
+        ) const {
+            pathfinding::PathCacheUpdate& cacheUpdate = context.cacheUpdates.emplace_back();
+            cacheUpdate.order = context.order;
+            return pathCache_.lookup(context.pathfinder, *this, unit->getPosition(), goal,
+                pathfinding::movementClassOf(unit->getType()), path, context.stitch, cacheUpdate);
+        }
+
+        bool Map::planHierarchicalPath(
+            PlanContext& context,
+            const Unit* unit,
+            const types::Position& goal,
+            std::vector<types::Position>& waypoints,
+            std::vector<types::Position>& path
+        ) const {
+            const types::Position start = unit->getPosition();
+            if (waypoints.empty()) {
+                if (utils::manhattanDistance(start, goal) <= LONG_PATH_DISTANCE) {
+                    return planCachedPath(context, unit, goal, path);
+                }
+                // 클러스터 그래프는 탐색 중 갱신되므로 반영 단계에서 경유지를 구합니다.
+                return false;
+            }
+            return refineRoute(context.pathfinder, start, goal, waypoints, path);
+        }
+
+        bool Map::refineRoute(
+            pathfinding::Pathfinder& pathfinder,
+            const types::Position& start,
+            const types::Position& goal,
+            std::vector<types::Position>& waypoints,
+            std::vector<types::Position>& path
+        ) const {
+            // 다음 경유지까지만 구체화합니다.
+            types::Position next = waypoints.back();
+            waypoints.pop_back();
+            if (pathfinder.findPath(*this, start, next, path)) {
+                return true;
+            }
+
+            // 유닛이 구간을 막고 있으면 목표까지 직접 탐색합니다.
+            waypoints.clear();
+            return pathfinder.findPath(*this, start, goal, path);
+        }
+
         void Map::removeUnit(Unit* unit) {
             if (unit) {
+                touchUnit(unit);
                 unitManager_.removeUnit(unit);
             }
         }
 
         void Map::damageBuildingAt(const types::Position& position, int damage) {
             if (auto* building = buildingManager_.getBuildingAt(position)) {
+                // 이미 부서진 건물은 제거될 때까지 다시 알리지 않습니다.
+                journalBuildings();
+                const bool wasDestroyed = building->isDestroyed();
                 building->takeDamage(damage);
-                if (building->isDestroyed()) {
-                    addSystemMessage(L"The building was destroyed!");
+                if (!wasDestroyed && building->isDestroyed()) {
+                    GameEvent destroyed{ GameEventType::BuildingDestroyed };
+                    destroyed.camp = building->getType();
+                    destroyed.position = position;
+                    events_.publish(destroyed);
                 }
             }
         }
 
         void Map::removeDestroyedBuildings() {
+            ProfileScope scope(ProfileZone::RemoveDestroyedBuildings);
+            const auto& buildings = buildingManager_.getBuildings();
+            if (std::any_of(buildings.begin(), buildings.end(), [](const auto& building) { return building->isDestroyed(); })) {
+                journalBuildings();
+            }
             buildingManager_.removeDestroyedBuildings();
         }
 
         void Map::addSystemMessage(const std::wstring& message) {
-            if (messageWindow_) {
-                messageWindow_->addMessage(message);
+            utils::log<utils::LogLevel::Info>([&] { return message; });
+            if (messageHandler_) {
+                messageHandler_(message);
             }
         }
 
@@ -163,24 +532,32 @@ namespace dune {
             if (targetPosition != sandworm->getPosition()) {
                 types::Position newPosition = calculateSandwormMove(sandworm, targetPosition);
 
-                sandworm->moveTo(newPosition);
-
-                // 새 위치에서 유닛 확인
+                // 새 위치의 유닛 확인
                 if (Unit* targetUnit = getEntityAt<Unit>(newPosition)) {
                     if (isValidSandwormTarget(targetUnit)) {
                         // 유닛을 잡아먹습니다.
                         sandworm->consumeTarget();
-                        addSystemMessage(L"Sandworm caught a " + getUnitTypeName(targetUnit->getType()) + L"!");
+                        GameEvent killed{ GameEventType::UnitKilled };
+                        killed.camp = targetUnit->getCamp();
+                        killed.unitType = targetUnit->getType();
+                        killed.sourceType = types::UnitType::Sandworm;
+                        killed.position = newPosition;
+                        events_.publish(killed);
                         removeUnit(targetUnit);
 
                         // 스파이스 생성 여부 확인
-                        if (sandworm->shouldExcrete()) {
+                        if (sandworm->shouldExcrete(getRandom(utils::RandomStream::Excretion))) {
                             sandworm->excrete();
                             setTerrain(newPosition, types::TerrainType::Spice);
-                            addSystemMessage(L"The sandworm left behind some spice.");
+                            GameEvent created{ GameEventType::SpiceCreated };
+                            created.unitType = types::UnitType::Sandworm;
+                            created.position = newPosition;
+                            events_.publish(created);
                         }
                     }
                 }
+
+                moveUnit(sandworm, newPosition);
             }
 
             sandworm->updateLastMoveTime(currentTime);
@@ -199,7 +576,7 @@ namespace dune {
                 // 수평 이동 시도
                 nextPosition.column += (dx > 0) ? 1 : -1;
                 // 바위를 만나면 수직 이동 시도
-                if (terrainManager_.getTerrain(nextPosition).getType() == types::TerrainType::Rock) {
+                if (terrainManager_.getType(nextPosition) == types::TerrainType::Rock) {
                     nextPosition.column = currentPosition.column;
                     nextPosition.row += (dy > 0) ? 1 : -1;
                 }
@@ -207,7 +584,7 @@ namespace dune {
                 // 수직 이동 시도
                 nextPosition.row += (dy > 0) ? 1 : -1;
                 // 바위를 만나면 수평 이동 시도
-                if (terrainManager_.getTerrain(nextPosition).getType() == types::TerrainType::Rock) {
+                if (terrainManager_.getType(nextPosition) == types::TerrainType::Rock) {
                     nextPosition.row = currentPosition.row;
                     nextPosition.column += (dx > 0) ? 1 : -1;
                 }
@@ -223,15 +600,334 @@ namespace dune {
                    targetType != types::UnitType::HeavyTank;
         }
 
-        std::wstring Map::getUnitTypeName(types::UnitType type) const {
-            switch (type) {
-            case types::UnitType::Harvester: return L"Harvester";
-            case types::UnitType::Fremen:    return L"Fremen";
-            case types::UnitType::Soldier:   return L"Soldier";
-            case types::UnitType::Fighter:   return L"Fighter";
-            case types::UnitType::HeavyTank: return L"HeavyTank";
-            default:                         return L"unit";
+        void Map::saveSnapshot(snapshot::Sections& sections) const {
+            constexpr std::size_t STREAM_COUNT = static_cast<std::size_t>(utils::RandomStream::Count);
+            static_assert(std::size(snapshot::SimulationRecord{}.random) == STREAM_COUNT);
+
+            auto& record = sections.simulation;
+            record.seed = random_.getSeed();
+            record.schedulerNow = scheduler_.now();
+            for (std::size_t i = 0; i < STREAM_COUNT; ++i) {
+                const auto& state = random_.get(static_cast<utils::RandomStream>(i)).getState();
+                std::copy(state.begin(), state.end(), record.random[i]);
+            }
+            record.pathCacheClock = pathCache_.getClock();
+            record.unitIdCount = unitManager_.getIdCount();
+
+            const auto& tiles = terrainManager_.getTiles();
+            sections.terrain.assign(tiles.begin(), tiles.end());
+
+            sections.buildings.clear();
+            appendBuildings(sections.buildings);
+
+            // 타겟은 이미 해제된 유닛일 수 있으므로 맵에 있는 유닛만 번호로 바꿉니다.
+            const snapshot::UnitIds ids = [this](const Unit* unit) {
+                return unitManager_.findUnitById(unit->getId()) == unit ? unit->getId() : snapshot::NO_UNIT;
+            };
+            sections.units.clear();
+            sections.positions.clear();
+            for (std::size_t slot = 0; slot < unitManager_.getSlotCount(); ++slot) {
+                if (unitManager_.isSlotActive(slot)) {
+                    appendUnit(unitManager_.getUnitInSlot(slot), sections.units, sections.positions, ids);
+                }
+            }
+
+            sections.pathCache.clear();
+            appendPathCache(sections.pathCache, sections.positions);
+
+            sections.groupMoves.clear();
+            for (const auto& order : groupMoves_) {
+                sections.groupMoves.push_back({ order.unitId, 0, snapshot::toRecord(order.goal), order.tick });
+            }
+        }
+
+        bool Map::restoreSnapshot(const snapshot::SectionView& view) {
+            constexpr std::size_t STREAM_COUNT = static_cast<std::size_t>(utils::RandomStream::Count);
+            const auto& record = *view.simulation;
+            // 사라진 유닛의 명령은 orderMove()가 고유 번호로 찾지 못해 건너뛰므로 그대로 읽습니다.
+            groupMoves_.clear();
+            for (const auto& order : view.groupMoves) {
+                groupMoves_.push_back({ order.unitId, snapshot::toPosition(order.goal), order.tick });
+            }
+
+            random_.reseed(record.seed);
+            for (std::size_t i = 0; i < STREAM_COUNT; ++i) {
+                std::array<std::uint64_t, 4> state;
+                std::copy(std::begin(record.random[i]), std::end(record.random[i]), state.begin());
+                random_.get(static_cast<utils::RandomStream>(i)).setState(state);
+            }
+
+            if (!terrainManager_.loadTiles(view.terrain) || !restoreBuildings(view.buildings)) {
+                return false;
+            }
+
+            // 다른 유닛을 가리키는 AI가 있으므로 유닛을 모두 만든 뒤 AI를 되살립니다.
+            for (const auto& unitRecord : view.units) {
+                if (unitRecord.type == static_cast<std::uint8_t>(types::UnitType::None) ||
+                    unitRecord.type > static_cast<std::uint8_t>(types::UnitType::Sandstorm) ||
+                    unitRecord.camp < static_cast<std::uint8_t>(types::Camp::Common) ||
+                    unitRecord.camp > static_cast<std::uint8_t>(types::Camp::Harkonnen)) {
+                    return false;
+                }
+            }
+            std::vector<Unit*> restored;
+            if (!unitManager_.restoreUnits(view.units, record.unitIdCount, restored)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < restored.size(); ++i) {
+                if (!restored[i]->restoreAI(view.units[i].ai, view.positions, unitManager_)) {
+                    return false;
+                }
+            }
+
+            // 예약 틱은 저장 시점의 스케줄러 기준이므로 현재 틱을 먼저 맞춘 뒤 다시 예약합니다.
+            scheduler_.reset(record.schedulerNow);
+            wakeTickById_.assign(record.unitIdCount, TimingWheel<std::uint32_t>::NO_TICK);
+            for (const auto& unitRecord : view.units) {
+                if (unitRecord.wakeTick != snapshot::NO_TICK) {
+                    scheduleWake(unitRecord.id, unitRecord.wakeTick);
+                }
+            }
+
+            return restorePathCache(view.pathCache, view.positions, record.pathCacheClock);
+        }
+
+        void Map::appendBuildings(std::vector<snapshot::BuildingRecord>& records) const {
+            for (const auto& building : buildingManager_.getBuildings()) {
+                snapshot::BuildingRecord& record = records.emplace_back();
+                record.kind = static_cast<std::uint8_t>(building->getKind());
+                record.camp = static_cast<std::uint8_t>(building->getType());
+                record.health = building->getHealth();
+                record.position = snapshot::toRecord(building->getPosition());
+            }
+        }
+
+        void Map::appendPathCache(std::vector<snapshot::PathCacheRecord>& records,
+            std::vector<snapshot::PositionRecord>& positions) const {
+            pathCache_.forEachEntry([&](int region, const types::Position& goal, pathfinding::MovementClass movementClass,
+                const types::Position& start, const std::vector<types::Position>& path, std::uint64_t lastUsed) {
+                snapshot::PathCacheRecord& entry = records.emplace_back();
+                entry.region = region;
+                entry.movementClass = static_cast<std::uint8_t>(movementClass);
+                entry.goal = snapshot::toRecord(goal);
+                entry.start = snapshot::toRecord(start);
+                entry.lastUsed = lastUsed;
+                snapshot::appendPath(positions, path, entry.pathOffset, entry.pathCount);
+            });
+        }
+
+        void Map::appendUnit(const Unit* unit, std::vector<snapshot::UnitRecord>& records,
+            std::vector<snapshot::PositionRecord>& positions, const snapshot::UnitIds& ids) const {
+            snapshot::UnitRecord& record = records.emplace_back();
+            unit->save(record, positions, ids);
+            record.wakeTick = unit->getId() < wakeTickById_.size()
+                ? wakeTickById_[unit->getId()]
+                : snapshot::NO_TICK;
+        }
+
+        bool Map::restoreBuildings(std::span<const snapshot::BuildingRecord> records) {
+            const auto isCamp = [](std::uint8_t camp) {
+                return camp >= static_cast<std::uint8_t>(types::Camp::Common) &&
+                    camp <= static_cast<std::uint8_t>(types::Camp::Harkonnen);
+            };
+
+            const auto& buildings = buildingManager_.getBuildings();
+            bool sameBuildings = buildings.size() == records.size();
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                const auto& record = records[i];
+                const types::Position position = snapshot::toPosition(record.position);
+                if (record.kind == static_cast<std::uint8_t>(types::BuildingType::None) ||
+                    record.kind >= entity::BUILDING_DESCRIPTORS.size() ||
+                    !isCamp(record.camp) || !terrainManager_.isValidPosition(position)) {
+                    return false;
+                }
+                sameBuildings = sameBuildings &&
+                    record.kind == static_cast<std::uint8_t>(buildings[i]->getKind()) &&
+                    record.camp == static_cast<std::uint8_t>(buildings[i]->getType()) &&
+                    position == buildings[i]->getPosition();
+            }
+            if (sameBuildings) {
+                for (std::size_t i = 0; i < records.size(); ++i) {
+                    buildings[i]->restoreHealth(records[i].health);
+                }
+                return true;
+            }
+            while (!buildings.empty()) {
+                buildingManager_.removeBuilding(buildings.back().get());
+            }
+            for (const auto& record : records) {
+                addBuilding(std::make_unique<Building>(static_cast<types::BuildingType>(record.kind),
+                    static_cast<types::Camp>(record.camp), snapshot::toPosition(record.position), record.health));
+            }
+            return true;
+        }
+
+        bool Map::restorePathCache(std::span<const snapshot::PathCacheRecord> records,
+            std::span<const snapshot::PositionRecord> positions, std::uint64_t clock) {
+            pathCache_.restore(clock);
+            std::vector<types::Position> path;
+            for (const auto& entry : records) {
+                if (entry.movementClass > static_cast<std::uint8_t>(pathfinding::MovementClass::Sandworm) ||
+                    !snapshot::readPath(positions, entry.pathOffset, entry.pathCount, path) ||
+                    !pathCache_.restoreEntry(entry.region, snapshot::toPosition(entry.goal),
+                        static_cast<pathfinding::MovementClass>(entry.movementClass),
+                        snapshot::toPosition(entry.start), path, entry.lastUsed)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        Map::CheckpointId Map::checkpoint() {
+            // 시대가 바뀌므로 이 시점 이후 처음 바뀌는 유닛/건물/경로 캐시는 다시 기록됩니다.
+            ++epoch_;
+            Checkpoint& level = checkpoints_.emplace_back();
+            level.id = nextCheckpointId_++;
+            level.tiles = tileJournal_.size();
+            level.units = unitJournal_.size();
+            level.positions = journalPositions_.size();
+            level.buildingImages = buildingImages_.size();
+            level.pathCacheImages = pathCacheImages_.size();
+            level.unitIdCount = unitManager_.getIdCount();
+            level.schedulerNow = scheduler_.now();
+            level.random = random_;
+            level.groupMoves = groupMoves_;
+            return level.id;
+        }
+
+        bool Map::rollback(CheckpointId checkpoint) {
+            const auto found = std::find_if(checkpoints_.begin(), checkpoints_.end(),
+                [&](const Checkpoint& level) { return level.id == checkpoint; });
+            if (found == checkpoints_.end()) {
+                return false;
+            }
+            const Checkpoint& level = *found;
+            restoring_ = true;
+
+            // 타일은 바뀐 순서의 반대로 되감습니다.
+            for (std::size_t i = tileJournal_.size(); i > level.tiles; --i) {
+                terrainManager_.setTerrain(tileJournal_[i - 1].position, tileJournal_[i - 1].type);
+            }
+
+            // 건물 목록, 유닛, 경로 캐시는 범위 안에서 가장 이른 레코드가 그 시점의 상태입니다.
+            // (뒤에 잡은 시점의 레코드는 그 사이에 바뀌지 않은 상태입니다)
+            bool ok = true;
+            if (buildingImages_.size() > level.buildingImages) {
+                const std::size_t begin = buildingImages_[level.buildingImages];
+                const std::size_t end = level.buildingImages + 1 < buildingImages_.size()
+                    ? buildingImages_[level.buildingImages + 1] : buildingJournal_.size();
+                ok = restoreBuildings(std::span<const snapshot::BuildingRecord>(buildingJournal_).subspan(begin, end - begin));
+            }
+
+            // 시대를 하나 써서 고유 번호마다 첫 레코드만 고릅니다. 시점 뒤에 생긴 유닛은 restoreUnits()가 지웁니다.
+            ++epoch_;
+            rollbackUnits_.clear();
+            for (std::size_t i = level.units; i < unitJournal_.size(); ++i) {
+                const auto& record = unitJournal_[i];
+                if (record.id < level.unitIdCount && unitEpochs_[record.id] != epoch_) {
+                    unitEpochs_[record.id] = epoch_;
+                    rollbackUnits_.push_back(record);
+                }
+            }
+            std::sort(rollbackUnits_.begin(), rollbackUnits_.end(),
+                [](const snapshot::UnitRecord& a, const snapshot::UnitRecord& b) { return a.id < b.id; });
+            std::vector<Unit*> restored;
+            ok = ok && unitManager_.restoreUnits(rollbackUnits_, level.unitIdCount, restored);
+            for (std::size_t i = 0; ok && i < restored.size(); ++i) {
+                ok = restored[i]->restoreAI(rollbackUnits_[i].ai, journalPositions_, unitManager_);
+            }
+
+            // 그 뒤의 예약은 스케줄러에 남아도 wakeTickById_와 틱이 달라 꺼낼 때 버려지므로, 되돌린 유닛만 다시 예약합니다.
+            scheduler_.rewind(level.schedulerNow);
+            wakeTickById_.resize(level.unitIdCount, TimingWheel<std::uint32_t>::NO_TICK);
+            for (const auto& record : rollbackUnits_) {
+                wakeTickById_[record.id] = record.wakeTick;
+                if (record.wakeTick != snapshot::NO_TICK) {
+                    scheduler_.schedule(record.wakeTick, record.id);
+                }
+            }
+
+            if (pathCacheImages_.size() > level.pathCacheImages) {
+                const PathCacheImage& image = pathCacheImages_[level.pathCacheImages];
+                const std::size_t end = level.pathCacheImages + 1 < pathCacheImages_.size()
+                    ? pathCacheImages_[level.pathCacheImages + 1].begin : pathCacheJournal_.size();
+                ok = ok && restorePathCache(std::span<const snapshot::PathCacheRecord>(pathCacheJournal_)
+                    .subspan(image.begin, end - image.begin), journalPositions_, image.clock);
+            }
+            random_ = level.random;
+            groupMoves_ = level.groupMoves;
+
+            // 되돌린 시점부터 다시 기록합니다.
+            tileJournal_.resize(level.tiles);
+            unitJournal_.resize(level.units);
+            journalPositions_.resize(level.positions);
+            if (buildingImages_.size() > level.buildingImages) {
+                buildingJournal_.resize(buildingImages_[level.buildingImages]);
+                buildingImages_.resize(level.buildingImages);
+            }
+            if (pathCacheImages_.size() > level.pathCacheImages) {
+                pathCacheJournal_.resize(pathCacheImages_[level.pathCacheImages].begin);
+                pathCacheImages_.resize(level.pathCacheImages);
+            }
+            checkpoints_.erase(found + 1, checkpoints_.end());
+            ++epoch_;
+            restoring_ = false;
+            return ok;
+        }
+
+        void Map::releaseCheckpoint(CheckpointId checkpoint) {
+            // 기록은 그대로 두면 앞선 시점의 범위에 합쳐지고, 뒤에 잡은 시점은 자기 범위만 쓰므로 영향이 없습니다.
+            std::erase_if(checkpoints_, [&](const Checkpoint& level) { return level.id == checkpoint; });
+            if (!checkpoints_.empty()) {
+                return;
+            }
+            tileJournal_.clear();
+            unitJournal_.clear();
+            journalPositions_.clear();
+            buildingJournal_.clear();
+            buildingImages_.clear();
+            pathCacheJournal_.clear();
+            pathCacheImages_.clear();
+        }
+
+        Map::JournalStats Map::getJournalStats() const {
+            return { tileJournal_.size(), unitJournal_.size(), buildingImages_.size(), pathCacheImages_.size() };
+        }
+
+        void Map::journalUnit(std::uint32_t id) {
+            // 시점 뒤에 생긴 유닛은 되돌릴 때 통째로 지우므로 기록하지 않습니다.
+            if (!isJournaling() || id >= checkpoints_.back().unitIdCount) {
+                return;
+            }
+            if (id >= unitEpochs_.size()) {
+                unitEpochs_.resize(unitManager_.getIdCount(), 0);
+            }
+            const std::size_t slot = unitManager_.getSlotOfId(id);
+            if (unitEpochs_[id] == epoch_ || slot == managers::UnitManager::NO_SLOT) {
+                return;
+            }
+            unitEpochs_[id] = epoch_;
+            // 이번 틱에 제거된 타겟도 아직 해제 전이라 시점의 상태 그대로 번호로 남깁니다.
+            appendUnit(unitManager_.getUnitInSlot(slot), unitJournal_, journalPositions_,
+                [](const Unit* unit) { return unit->getId(); });
+        }
+
+        void Map::journalBuildings() {
+            if (!isJournaling() || buildingEpoch_ == epoch_) {
+                return;
+            }
+            buildingEpoch_ = epoch_;
+            buildingImages_.push_back(buildingJournal_.size());
+            appendBuildings(buildingJournal_);
+        }
+
+        void Map::journalPathCache() {
+            if (!isJournaling() || pathCacheEpoch_ == epoch_) {
+                return;
             }
+            pathCacheEpoch_ = epoch_;
+            pathCacheImages_.push_back({ pathCacheJournal_.size(), pathCache_.getClock() });
+            appendPathCache(pathCacheJournal_, journalPositions_);
         }
 
     } // namespace core
@@ -0,0 +1,32 @@
+#include "core/occupancy_grid.hpp"
+#include <algorithm>
+
+namespace dune {
+    namespace core {
+
+        OccupancyGrid::OccupancyGrid(int width, int height)
+            : width_(width)
+            , height_(height)
+            , cells_(static_cast<std::size_t>(width) * height, 0) {}
+
+        void OccupancyGrid::assign(const types::Position& position, Layer layer, bool occupied) {
+            if (!isValidPosition(position)) return;
+            auto& cell = cells_[indexOf(position)];
+            cell = occupied ? (cell | layer) : (cell & ~layer);
+        }
+
+        void OccupancyGrid::assignArea(const types::Position& origin, int width, int height, Layer layer, bool occupied) {
+            int firstRow = std::max(0, origin.row);
+            int lastRow = std::min(height_, origin.row + height);
+            int firstColumn = std::max(0, origin.column);
+            int lastColumn = std::min(width_, origin.column + width);
+            for (int row = firstRow; row < lastRow; ++row) {
+                for (int column = firstColumn; column < lastColumn; ++column) {
+                    auto& cell = cells_[static_cast<std::size_t>(row) * width_ + column];
+                    cell = occupied ? (cell | layer) : (cell & ~layer);
+                }
+            }
+        }
+
+    } // namespace core
+} // namespace dune
@@ -0,0 +1,263 @@
+#include "core/profiler.hpp"
+#include "entity/combat_unit_state.hpp"
+#include "entity/harvester_state.hpp"
+#include "entity/sandworm_state.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+
+namespace dune {
+    namespace core {
+
+        namespace {
+            constexpr const char* FIXED_ZONE_NAMES[] = {
+                "ProcessInput", "UpdateGameState", "DisplayUpdate", "ConsoleFlush", "SimulationStep", "TacticalPlanner",
+                "MapUpdate", "MapPlan", "MapApply", "RemoveDestroyedBuildings", "EventDispatch",
+                "AStar", "FlowField", "ClusterRoute"
+            };
+            static_assert(std::size(FIXED_ZONE_NAMES) == Profiler::FIXED_ZONE_COUNT);
+
+            const char* unitTypeName(types::UnitType type) {
+                switch (type) {
+                case types::UnitType::Harvester:   return "Harvester";
+                case types::UnitType::Fremen:      return "Fremen";
+                case types::UnitType::Soldier:     return "Soldier";
+                case types::UnitType::Fighter:     return "Fighter";
+                case types::UnitType::HeavyTank:   return "HeavyTank";
+                case types::UnitType::Sandworm:    return "Sandworm";
+                case types::UnitType::DesertEagle: return "DesertEagle";
+                case types::UnitType::Sandstorm:   return "Sandstorm";
+                default:                           return "None";
+                }
+            }
+
+            // 상태 이름은 모두 ASCII입니다.
+            std::string narrow(const wchar_t* text) {
+                std::string out;
+                for (; *text; ++text) {
+                    out.push_back(static_cast<char>(*text));
+                }
+                return out;
+            }
+
+            std::string stateName(types::UnitType type, std::size_t state) {
+                switch (type) {
+                case types::UnitType::Harvester:
+                    return narrow(entity::getStateName(static_cast<entity::HarvesterStateKind>(state)));
+                case types::UnitType::Sandworm:
+                    return narrow(entity::getStateName(static_cast<entity::SandwormStateKind>(state)));
+                case types::UnitType::Soldier:
+                case types::UnitType::Fremen:
+                case types::UnitType::Fighter:
+                case types::UnitType::HeavyTank:
+                    return narrow(entity::combat::getStateName(static_cast<entity::combat::CombatStateKind>(state)));
+                default:
+                    return "State" + std::to_string(state);
+                }
+            }
+
+            double toMicroseconds(std::uint64_t nanoseconds) {
+                return static_cast<double>(nanoseconds) / 1000.0;
+            }
+        }
+
+        // LatencyHistogram 클래스 구현
+
+        std::size_t LatencyHistogram::indexOf(std::uint64_t value) {
+            if (value < SUB_BUCKET_COUNT) {
+                return static_cast<std::size_t>(value);
+            }
+            // 위쪽 SUB_BUCKET_BITS 비트만 남기도록 자른 뒤, 그 구간의 뒤쪽 절반 칸에 넣습니다.
+            const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - SUB_BUCKET_BITS;
+            return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF +
+                static_cast<std::size_t>((value >> shift) - SUB_BUCKET_HALF);
+        }
+
+        std::uint64_t LatencyHistogram::highestEquivalentValue(std::size_t index) {
+            if (index < SUB_BUCKET_COUNT) {
+                return index;
+            }
+            const std::size_t offset = index - SUB_BUCKET_COUNT;
+            const unsigned shift = static_cast<unsigned>(offset / SUB_BUCKET_HALF) + 1;
+            const std::uint64_t subBucket = offset % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+            // 마지막 칸은 2^64에서 넘쳐 0이 되므로 1을 빼면 최댓값이 됩니다.
+            return ((subBucket + 1) << shift) - 1;
+        }
+
+        void LatencyHistogram::record(std::uint64_t value) {
+            ++counts_[indexOf(value)];
+            ++count_;
+            max_ = std::max(max_, value);
+            total_ += value;
+        }
+
+        std::uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const {
+            if (count_ == 0) {
+                return 0;
+            }
+            const double clamped = std::clamp(percentile, 0.0, 100.0);
+            const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * count_)));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+                seen += counts_[i];
+                if (seen >= rank) {
+                    return std::min(highestEquivalentValue(i), max_);
+                }
+            }
+            return max_;
+        }
+
+        // Profiler 클래스 구현
+
+        Profiler& Profiler::instance() {
+            static Profiler profiler;
+            return profiler;
+        }
+
+        Profiler::~Profiler() {
+            if (!reportPath_.empty()) {
+                writeReport(reportPath_);
+            }
+        }
+
+        void Profiler::setEnabled(bool enabled) {
+            if (enabled && !isEnabled()) {
+                std::lock_guard<std::mutex> lock(threadsMutex_);
+                for (auto& totals : threads_) {
+                    *totals = ThreadTotals{};
+                }
+            }
+            enabled_.store(enabled, std::memory_order_relaxed);
+        }
+
+        void Profiler::setReportPath(const std::string& path) {
+            reportPath_ = path;
+        }
+
+        Profiler::ThreadTotals& Profiler::getThreadTotals() {
+            // 스레드가 끝나면 칸을 돌려주고, 다음에 처음 기록하는 스레드가 이어 씁니다.
+            // 작업 풀을 다시 만들 때마다 칸이 늘지 않도록 칸 수는 동시에 살아 있던 스레드 수로 묶입니다.
+            struct ThreadSlot {
+                ThreadTotals* totals = nullptr;
+                ~ThreadSlot() {
+                    if (totals) {
+                        Profiler::instance().releaseThreadTotals(totals);
+                    }
+                }
+            };
+            thread_local ThreadSlot slot;
+            if (!slot.totals) {
+                std::lock_guard<std::mutex> lock(threadsMutex_);
+                if (freeThreads_.empty()) {
+                    threads_.push_back(std::make_unique<ThreadTotals>());
+                    slot.totals = threads_.back().get();
+                }
+                else {
+                    slot.totals = freeThreads_.back();
+                    freeThreads_.pop_back();
+                }
+            }
+            return *slot.totals;
+        }
+
+        void Profiler::releaseThreadTotals(ThreadTotals* totals) {
+            // 쌓다 만 값은 그대로 두어 다음 endTick()에 합쳐집니다.
+            std::lock_guard<std::mutex> lock(threadsMutex_);
+            freeThreads_.push_back(totals);
+        }
+
+        void Profiler::record(std::size_t zone, std::chrono::nanoseconds elapsed) {
+            ThreadTotals& totals = getThreadTotals();
+            totals.nanoseconds[zone] += static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed.count(), 0));
+            ++totals.calls[zone];
+        }
+
+        void Profiler::endTick() {
+            if (!isEnabled()) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(threadsMutex_);
+            for (std::size_t zone = 0; zone < ZONE_COUNT; ++zone) {
+                std::uint64_t nanoseconds = 0;
+                std::uint64_t calls = 0;
+                for (auto& totals : threads_) {
+                    nanoseconds += totals->nanoseconds[zone];
+                    calls += totals->calls[zone];
+                    totals->nanoseconds[zone] = 0;
+                    totals->calls[zone] = 0;
+                }
+                // 이번 틱에 불리지 않은 구간은 0을 넣지 않아 분포가 한 번이라도 돈 틱만 보여 줍니다.
+                if (calls == 0) {
+                    continue;
+                }
+                ZoneStats& stats = zones_[zone];
+                if (!stats.histogram) {
+                    stats.histogram = std::make_unique<LatencyHistogram>();
+                }
+                stats.histogram->record(nanoseconds);
+                stats.calls += calls;
+            }
+            ++ticks_;
+        }
+
+        void Profiler::reset() {
+            std::lock_guard<std::mutex> lock(threadsMutex_);
+            for (auto& totals : threads_) {
+                *totals = ThreadTotals{};
+            }
+            for (auto& stats : zones_) {
+                stats = ZoneStats{};
+            }
+            ticks_ = 0;
+        }
+
+        std::string Profiler::getZoneName(std::size_t zone) {
+            if (zone < FIXED_ZONE_COUNT) {
+                return FIXED_ZONE_NAMES[zone];
+            }
+            const std::size_t unit = zone - FIXED_ZONE_COUNT;
+            const auto type = static_cast<types::UnitType>(unit / UNIT_STATE_COUNT);
+            return std::string(unitTypeName(type)) + "/" + stateName(type, unit % UNIT_STATE_COUNT);
+        }
+
+        void Profiler::writeReport(std::ostream& out) const {
+            out << "ticks: " << ticks_ << " (times are per tick, in microseconds)\n";
+            out << std::left << std::setw(28) << "zone"
+                << std::right << std::setw(10) << "ticks"
+                << std::setw(12) << "calls"
+                << std::setw(12) << "mean"
+                << std::setw(12) << "p50"
+                << std::setw(12) << "p99"
+                << std::setw(12) << "max" << '\n';
+
+            out << std::fixed << std::setprecision(1);
+            for (std::size_t zone = 0; zone < ZONE_COUNT; ++zone) {
+                const LatencyHistogram* histogram = zones_[zone].histogram.get();
+                if (!histogram) {
+                    continue;
+                }
+                out << std::left << std::setw(28) << getZoneName(zone)
+                    << std::right << std::setw(10) << histogram->getCount()
+                    << std::setw(12) << zones_[zone].calls
+                    << std::setw(12) << toMicroseconds(histogram->getTotal() / histogram->getCount())
+                    << std::setw(12) << toMicroseconds(histogram->getValueAtPercentile(50.0))
+                    << std::setw(12) << toMicroseconds(histogram->getValueAtPercentile(99.0))
+                    << std::setw(12) << toMicroseconds(histogram->getMax()) << '\n';
+            }
+        }
+
+        bool Profiler::writeReport(const std::string& path) const {
+            std::ofstream file(path, std::ios::out | std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+            writeReport(file);
+            return static_cast<bool>(file);
+        }
+
+    } // namespace core
+} // namespace dune
@@ -0,0 +1,209 @@
+#include "core/replay.hpp"
+#include "core/simulation.hpp"
+#include "entity/building_descriptor.hpp"
+#include <iterator>
+
+namespace dune {
+    namespace core {
+
+        namespace {
+            constexpr char MAGIC[4] = { 'D', 'U', 'N', 'R' };
+            constexpr std::uint16_t VERSION = 1;
+            constexpr std::uint8_t END_MARKER = 0xFF;   // 명령 종류 자리에 오면 끝 표시입니다.
+            constexpr std::uint8_t LAST_COMMAND = static_cast<std::uint8_t>(CommandType::Patrol);
+
+            void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+                while (value >= 0x80) {
+                    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<std::uint8_t>(value));
+            }
+
+            // 위치는 음수일 수 있으므로 지그재그로 바꿔 작은 절댓값을 1바이트에 담습니다.
+            void putSigned(std::vector<std::uint8_t>& out, int value) {
+                const auto wide = static_cast<std::int64_t>(value);
+                putVarint(out, static_cast<std::uint64_t>((wide << 1) ^ (wide >> 63)));
+            }
+
+            void putLittleEndian(std::vector<std::uint8_t>& out, std::uint64_t value, int bytes) {
+                for (int i = 0; i < bytes; ++i) {
+                    out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+                }
+            }
+
+            // 읽기 위치가 끝을 넘으면 false를 반환하는 작은 바이트 읽기 도구
+            struct ByteReader {
+                const std::vector<std::uint8_t>& data;
+                std::size_t offset = 0;
+
+                bool atEnd() const { return offset >= data.size(); }
+
+                bool readByte(std::uint8_t& value) {
+                    if (atEnd()) return false;
+                    value = data[offset++];
+                    return true;
+                }
+
+                bool readVarint(std::uint64_t& value) {
+                    value = 0;
+                    for (int shift = 0; shift < 64; shift += 7) {
+                        std::uint8_t byte;
+                        if (!readByte(byte)) return false;
+                        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                        if ((byte & 0x80) == 0) return true;
+                    }
+                    return false;
+                }
+
+                bool readSigned(int& value) {
+                    std::uint64_t raw;
+                    if (!readVarint(raw)) return false;
+                    value = static_cast<int>(static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1));
+                    return true;
+                }
+
+                bool readLittleEndian(std::uint64_t& value, int bytes) {
+                    value = 0;
+                    for (int i = 0; i < bytes; ++i) {
+                        std::uint8_t byte;
+                        if (!readByte(byte)) return false;
+                        value |= static_cast<std::uint64_t>(byte) << (8 * i);
+                    }
+                    return true;
+                }
+            };
+        }
+
+        ReplayWriter::~ReplayWriter() {
+            // 끝 틱을 모르므로 끝 표시 없이 닫습니다. 읽는 쪽은 잘린 리플레이로 다룹니다.
+            if (file_.is_open()) {
+                file_.close();
+            }
+        }
+
+        bool ReplayWriter::open(const std::string& path, std::uint64_t seed) {
+            if (file_.is_open()) {
+                file_.close();
+            }
+
+            file_.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!file_) {
+                return false;
+            }
+
+            buffer_.clear();
+            for (char c : MAGIC) {
+                buffer_.push_back(static_cast<std::uint8_t>(c));
+            }
+            putLittleEndian(buffer_, VERSION, 2);
+            putLittleEndian(buffer_, 0, 2);
+            putLittleEndian(buffer_, seed, 8);
+            file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+            file_.flush();
+
+            lastTick_ = 0;
+            commandCount_ = 0;
+            return true;
+        }
+
+        void ReplayWriter::record(std::uint64_t tick, const Command& command) {
+            if (!file_.is_open()) return;
+
+            buffer_.clear();
+            putVarint(buffer_, tick - lastTick_);
+            buffer_.push_back(static_cast<std::uint8_t>(command.type));
+            buffer_.push_back(static_cast<std::uint8_t>(command.building));
+            putSigned(buffer_, command.source.row);
+            putSigned(buffer_, command.source.column);
+            putSigned(buffer_, command.target.row);
+            putSigned(buffer_, command.target.column);
+            file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+            file_.flush();
+
+            lastTick_ = tick;
+            ++commandCount_;
+        }
+
+        void ReplayWriter::close(std::uint64_t endTick) {
+            if (!file_.is_open()) return;
+
+            buffer_.clear();
+            putVarint(buffer_, endTick >= lastTick_ ? endTick - lastTick_ : 0);
+            buffer_.push_back(END_MARKER);
+            file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+            file_.close();
+        }
+
+        bool loadReplay(const std::string& path, Replay& replay) {
+            std::ifstream file(path, std::ios::in | std::ios::binary);
+            if (!file) {
+                return false;
+            }
+            const std::vector<std::uint8_t> data{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+            ByteReader reader{ data };
+            std::uint64_t version = 0;
+            std::uint64_t reserved = 0;
+            for (char expected : MAGIC) {
+                std::uint8_t byte;
+                if (!reader.readByte(byte) || byte != static_cast<std::uint8_t>(expected)) return false;
+            }
+            if (!reader.readLittleEndian(version, 2) || version != VERSION ||
+                !reader.readLittleEndian(reserved, 2) ||
+                !reader.readLittleEndian(replay.seed, 8)) {
+                return false;
+            }
+
+            replay.entries.clear();
+            replay.complete = false;
+            std::uint64_t tick = 0;
+            while (!reader.atEnd()) {
+                std::uint64_t delta;
+                std::uint8_t type;
+                if (!reader.readVarint(delta) || !reader.readByte(type)) break;
+                tick += delta;
+
+                if (type == END_MARKER) {
+                    replay.complete = true;
+                    break;
+                }
+                if (type > LAST_COMMAND) {
+                    return false;
+                }
+
+                ReplayEntry entry{ tick, {} };
+                std::uint8_t building;
+                if (!reader.readByte(building) ||
+                    !reader.readSigned(entry.command.source.row) ||
+                    !reader.readSigned(entry.command.source.column) ||
+                    !reader.readSigned(entry.command.target.row) ||
+                    !reader.readSigned(entry.command.target.column)) {
+                    break;
+                }
+                if (building >= entity::BUILDING_DESCRIPTORS.size()) {
+                    return false;
+                }
+                entry.command.type = static_cast<CommandType>(type);
+                entry.command.building = static_cast<types::BuildingType>(building);
+                replay.entries.push_back(entry);
+            }
+
+            replay.endTick = replay.complete ? tick : (replay.entries.empty() ? 0 : replay.entries.back().tick);
+            return true;
+        }
+
+        void playReplay(Simulation& simulation, const Replay& replay) {
+            for (const auto& entry : replay.entries) {
+                if (entry.tick > simulation.getTickCount()) {
+                    simulation.run(entry.tick - simulation.getTickCount());
+                }
+                simulation.execute(entry.command);
+            }
+            if (replay.endTick > simulation.getTickCount()) {
+                simulation.run(replay.endTick - simulation.getTickCount());
+            }
+        }
+
+    } // namespace core
+} // namespace dune
@@ -0,0 +1,88 @@
+#include "core/replay.hpp"
+#include "core/simulation.hpp"
+#include "utils/command_line.hpp"
+#include "utils/log.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using namespace dune::core;
+
+namespace {
+    const char* const USAGE = "usage: replay_player <replay file> [--repeat N] [--threads N] [--log FILE]\n";
+}
+
+/**
+ * @brief 리플레이 파일의 명령을 콘솔 없이 최대 속도로 다시 실행하는 재생기입니다.
+ * 성능 측정과 회귀 실행의 표준 작업량으로 씁니다. 옵션은 headless와 같은 꼴입니다. (utils::CommandLine)
+ * 사용법: replay_player <리플레이 파일> [--repeat 반복 횟수 (기본 1)] [--threads 작업 스레드 수 (기본 1)]
+ *                       [--log 로그 파일 (기본 없음)]
+ */
+int main(int argc, char* argv[]) {
+    dune::utils::CommandLine commandLine;
+    const bool parsed = commandLine.parse(argc, argv, {
+        { "--repeat", true }, { "--threads", true }, { "--log", false } });
+    if (!parsed || commandLine.getPositionals().size() != 1) {
+        if (!parsed) {
+            std::cerr << commandLine.getError() << '\n';
+        }
+        std::cerr << USAGE;
+        return 1;
+    }
+    const std::string replayPath = commandLine.getPositionals().front();
+    const std::uint64_t repeat = commandLine.getNumber("--repeat", 1);
+    const std::size_t threads = static_cast<std::size_t>(commandLine.getNumber("--threads", 1));
+    const std::string logPath = commandLine.getString("--log");
+
+    Replay replay;
+    if (!loadReplay(replayPath, replay)) {
+        std::cerr << "cannot read replay: " << replayPath << '\n';
+        return 1;
+    }
+    if (!logPath.empty() && !dune::utils::Logger::instance().open(logPath, dune::utils::LogLevel::Debug)) {
+        std::cerr << "cannot open log file: " << logPath << '\n';
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t totalTicks = 0;
+    int spice = 0;
+    std::size_t units = 0;
+    std::size_t buildings = 0;
+
+    for (std::uint64_t i = 0; i < repeat; ++i) {
+        Simulation simulation(nullptr, replay.seed);
+        simulation.setThreadCount(threads);
+        playReplay(simulation, replay);
+        totalTicks += simulation.getTickCount();
+
+        // 같은 리플레이는 매번 같은 결과가 나와야 하므로 마지막 반복의 상태만 보고합니다.
+        spice = simulation.getResource().spice;
+        units = simulation.getMap().getUnitManager().getUnits().size();
+        buildings = simulation.getMap().getBuildingManager().getBuildings().size();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    double seconds = elapsed.count() / 1e6;
+
+    std::cout << "replay: " << replayPath
+        << ", seed: " << replay.seed
+        << ", commands: " << replay.entries.size()
+        << ", end tick: " << replay.endTick
+        << (replay.complete ? "" : " (truncated)")
+        << '\n';
+    std::cout << "repeat: " << repeat
+        << ", threads: " << threads
+        << ", ticks: " << totalTicks
+        << ", elapsed: " << seconds << " s"
+        << ", ticks/s: " << (seconds > 0 ? totalTicks / seconds : 0.0)
+        << '\n';
+    std::cout << "final spice: " << spice
+        << ", units: " << units
+        << ", buildings: " << buildings
+        << '\n';
+
+    return 0;
+}
@@ -0,0 +1,526 @@
+#include "core/simulation.hpp"
+#include "core/profiler.hpp"
+#include "core/replay.hpp"
+#include "entity/unit_descriptor.hpp"
+#include "utils/constants.hpp"
+#include "utils/utils.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace dune {
+    namespace core {
+
+        Simulation::Simulation(MessageHandler messageHandler, std::uint64_t seed)
+            : jobs_(std::make_unique<JobSystem>(1))
+            , map_(constants::MAP_WIDTH, constants::MAP_HEIGHT, std::move(messageHandler))
+            , resource_{ 100, 1000, 10, 100 }
+            , currentTime_(0)
+            , tickCount_(0)
+        {
+            map_.setJobSystem(jobs_.get());
+            map_.setSeed(seed);
+            map_.getEvents().subscribe([this](const GameEvent& event) { onSpiceDelivered(event); });
+            initResources();
+            initTerrain();
+            initBuildings();
+            initSandworms();
+            initHarvesters();
+        }
+
+        Simulation::Simulation(MessageHandler messageHandler, EmptyTag)
+            : jobs_(std::make_unique<JobSystem>(1))
+            , map_(constants::MAP_WIDTH, constants::MAP_HEIGHT, std::move(messageHandler))
+            , resource_{}
+            , currentTime_(0)
+            , tickCount_(0)
+        {
+            map_.setJobSystem(jobs_.get());
+            map_.getEvents().subscribe([this](const GameEvent& event) { onSpiceDelivered(event); });
+        }
+
+        void Simulation::writeSnapshot(snapshot::Sections& sections) const {
+            map_.saveSnapshot(sections);
+
+            auto& record = sections.simulation;
+            record.tickCount = tickCount_;
+            record.currentTime = currentTime_.count();
+            record.spice = resource_.spice;
+            record.spiceMax = resource_.spice_max;
+            record.population = resource_.population;
+            record.populationMax = resource_.population_max;
+        }
+
+        std::unique_ptr<Simulation> Simulation::restoreSnapshot(const snapshot::SectionView& view,
+            MessageHandler messageHandler) {
+            // 빈 시뮬레이션 생성자는 외부에 열려 있지 않으므로 make_unique 대신 직접 만듭니다.
+            std::unique_ptr<Simulation> simulation(new Simulation(std::move(messageHandler), EmptyTag{}));
+            if (!simulation->map_.restoreSnapshot(view)) {
+                return nullptr;
+            }
+
+            const auto& record = *view.simulation;
+            simulation->tickCount_ = record.tickCount;
+            simulation->currentTime_ = std::chrono::milliseconds(record.currentTime);
+            simulation->resource_ = types::Resource{ record.spice, record.spiceMax, record.population, record.populationMax };
+            return simulation;
+        }
+
+        Simulation::Checkpoint Simulation::checkpoint() {
+            const Checkpoint checkpoint = map_.checkpoint();
+            checkpoints_.push_back({ checkpoint, currentTime_, tickCount_, resource_ });
+            return checkpoint;
+        }
+
+        bool Simulation::restore(Checkpoint checkpoint) {
+            const auto found = std::find_if(checkpoints_.begin(), checkpoints_.end(),
+                [&](const SavedClock& saved) { return saved.checkpoint == checkpoint; });
+            if (found == checkpoints_.end() || !map_.rollback(checkpoint)) {
+                return false;
+            }
+
+            currentTime_ = found->currentTime;
+            tickCount_ = found->tickCount;
+            resource_ = found->resource;
+            checkpoints_.erase(found + 1, checkpoints_.end());
+            return true;
+        }
+
+        void Simulation::release(Checkpoint checkpoint) {
+            map_.releaseCheckpoint(checkpoint);
+            std::erase_if(checkpoints_, [&](const SavedClock& saved) { return saved.checkpoint == checkpoint; });
+        }
+
+        void Simulation::step() {
+            ProfileScope scope(ProfileZone::SimulationStep);
+            scope.setTraceArgs({ static_cast<std::int32_t>(tickCount_) });
+            if (planner_ && planner_->isDue(tickCount_)) {
+                ProfileScope plannerScope(ProfileZone::TacticalPlanner);
+                planner_->plan(map_, *jobs_, currentTime_);
+            }
+            map_.update(currentTime_);
+            map_.removeDestroyedBuildings();
+            {
+                ProfileScope dispatchScope(ProfileZone::EventDispatch);
+                map_.getEvents().dispatch();
+            }
+
+            currentTime_ += std::chrono::milliseconds(constants::TICK);
+            ++tickCount_;
+        }
+
+        void Simulation::setThreadCount(std::size_t threadCount) {
+            // 맵이 이전 풀을 참조하지 않도록 새 풀을 먼저 연결한 뒤 이전 풀을 해제합니다.
+            auto jobs = std::make_unique<JobSystem>(threadCount);
+            map_.setJobSystem(jobs.get());
+            jobs_ = std::move(jobs);
+        }
+
+        void Simulation::onSpiceDelivered(const GameEvent& event) {
+            if (event.type != GameEventType::SpiceDelivered || event.camp != types::Camp::ArtLadies) {
+                return;
+            }
+
+            // 창고 용량을 넘는 양은 버립니다.
+            const int added = std::min(event.amount, resource_.spice_max - resource_.spice);
+            resource_.spice += added;
+            if (added < event.amount) {
+                map_.addSystemMessage(L"Storage full! Excess spice discarded: " + std::to_wstring(event.amount - added));
+            }
+        }
+
+        bool Simulation::execute(const Command& command) {
+            if (recorder_) {
+                recorder_->record(tickCount_, command);
+            }
+
+            switch (command.type) {
+            case CommandType::PlacePlate:    return placePlate(command.target);
+            case CommandType::PlaceBuilding: return placeBuilding(command.building, command.target);
+            case CommandType::ProduceUnit:   return produceUnit(command.source, command.target);
+            case CommandType::Move:
+            case CommandType::Harvest:
+            case CommandType::Attack:
+            case CommandType::Patrol:        return commandUnit(command);
+            }
+            return false;
+        }
+
+        bool Simulation::placePlate(const types::Position& position) {
+            const auto& plate = entity::getBuildingDescriptor(types::BuildingType::Plate);
+
+            // 장판 크기만큼 사막이고 건물이 없어야 합니다.
+            for (int row = position.row; row < position.row + plate.height; ++row) {
+                for (int col = position.column; col < position.column + plate.width; ++col) {
+                    types::Position tilePos{ row, col };
+                    if (!tilePos.is_valid() ||
+                        map_.getTerrainManager().getType(tilePos) != types::TerrainType::Desert ||
+                        map_.getOccupancy().isBlocked(tilePos, OccupancyGrid::Building)) {
+                        map_.addSystemMessage(L"Cannot place Plate here.");
+                        return false;
+                    }
+                }
+            }
+
+            if (resource_.spice < plate.cost) {
+                map_.addSystemMessage(L"Not enough spice to build Plate.");
+                return false;
+            }
+
+            for (int row = position.row; row < position.row + plate.height; ++row) {
+                for (int col = position.column; col < position.column + plate.width; ++col) {
+                    map_.setTerrain({ row, col }, types::TerrainType::Plate);
+                }
+            }
+
+            resource_.spice -= plate.cost;
+            map_.addSystemMessage(L"The Plate has been installed.");
+            return true;
+        }
+
+        bool Simulation::placeBuilding(types::BuildingType kind, const types::Position& position) {
+            const auto& descriptor = entity::getBuildingDescriptor(kind);
+            const std::wstring name = descriptor.name;
+            if (descriptor.placeKey == types::Key::None || kind == types::BuildingType::Plate) {
+                return false;
+            }
+            if (resource_.spice < descriptor.cost) {
+                map_.addSystemMessage(L"Not enough spice to build " + name + L".");
+                return false;
+            }
+
+            auto building = std::make_unique<Building>(kind, descriptor.camp, position);
+            const auto& terrainManager = map_.getTerrainManager();
+            if (!building->isPlaceable(position, terrainManager, map_.getOccupancy())) {
+                map_.addSystemMessage(L"The " + name + L" cannot be installed in this location.");
+                return false;
+            }
+
+            // 건물은 장판 위에만 설치할 수 있습니다.
+            for (int row = position.row; row < position.row + descriptor.height; ++row) {
+                for (int col = position.column; col < position.column + descriptor.width; ++col) {
+                    if (terrainManager.getType({ row, col }) != types::TerrainType::Plate) {
+                        map_.addSystemMessage(L"A Plate is required to build here.");
+                        return false;
+                    }
+                }
+            }
+
+            map_.addBuilding(std::move(building));
+            resource_.spice -= descriptor.cost;
+            resource_.spice_max += descriptor.spiceCapacityBonus;
+            resource_.population_max += descriptor.populationCapacityBonus;
+            map_.addSystemMessage(L"The " + name + L" has been installed.");
+            return true;
+        }
+
+        bool Simulation::produceUnit(const types::Position& buildingPosition, const types::Position& position) {
+            const Building* building = map_.getEntityAt<Building>(buildingPosition);
+            if (!building) {
+                return false;
+            }
+            const auto& descriptor = entity::getUnitDescriptor(building->getProducedUnit());
+            if (descriptor.maxDistance == 0) {
+                return false;
+            }
+
+            if (resource_.spice < descriptor.cost) {
+                map_.addSystemMessage(L"Not enough spice");
+                return false;
+            }
+            if (resource_.population + descriptor.population > resource_.population_max) {
+                map_.addSystemMessage(L"Not enough population capacity");
+                return false;
+            }
+            if (utils::manhattanDistance(position, building->getPosition()) > descriptor.maxDistance) {
+                map_.addSystemMessage(L"Too far from the base");
+                return false;
+            }
+            if (map_.getOccupancy().isBlocked(position)) {
+                map_.addSystemMessage(std::wstring(L"Cannot place ") + descriptor.name + L" here");
+                return false;
+            }
+
+            // 생산한 유닛은 생산 건물의 진영에 속합니다.
+            const types::Camp camp = building->getType();
+            switch (descriptor.type) {
+            case types::UnitType::Harvester: addHarvester(position, camp); break;
+            case types::UnitType::Soldier:   addSoldier(position, camp);   break;
+            case types::UnitType::Fremen:    addFremen(position, camp);    break;
+            case types::UnitType::Fighter:   addFighter(position, camp);   break;
+            case types::UnitType::HeavyTank: addHeavyTank(position, camp); break;
+            default: break;
+            }
+
+            resource_.spice -= descriptor.cost;
+            resource_.population += descriptor.population;
+            map_.addSystemMessage(std::wstring(L"A new ") + descriptor.name + L" ready");
+            return true;
+        }
+
+        bool Simulation::commandUnit(const Command& command) {
+            Unit* unit = map_.getEntityAt<Unit>(command.source);
+            if (!unit) {
+                return false;
+            }
+            map_.touchUnit(unit);
+
+            if (auto* harvesterAI = unit->getHarvesterAI()) {
+                // 하베스터 AI가 명령을 거절하면 (갈 수 없는 타일, 이미 수확 중인 매장지) 아무것도 바뀌지 않습니다.
+                if (command.type == CommandType::Move) {
+                    return harvesterAI->giveMoveCommand(unit, map_, command.target, currentTime_);
+                }
+                if (command.type == CommandType::Harvest) {
+                    if (map_.getTerrainManager().getType(command.target) != types::TerrainType::Spice) {
+                        map_.addSystemMessage(L"Cannot harvest here: No spice found.");
+                        return false;
+                    }
+                    return harvesterAI->giveHarvestCommand(unit, map_, command.target, currentTime_);
+                }
+                return false;
+            }
+
+            auto* combatAI = unit->getCombatUnitAI();
+            if (!combatAI) {
+                return false;
+            }
+
+            switch (command.type) {
+            case CommandType::Move:
+                map_.orderMove(unit, command.target);
+                break;
+            case CommandType::Patrol:
+                combatAI->patrolCommand(unit->getPosition(), command.target);
+                break;
+            case CommandType::Attack: {
+                Unit* targetUnit = map_.getEntityAt<Unit>(command.target);
+                if (!targetUnit) {
+                    map_.addSystemMessage(L"No target found at selected position.");
+                    return false;
+                }
+                if (targetUnit->getCamp() == unit->getCamp()) {
+                    map_.addSystemMessage(L"Cannot attack friendly units.");
+                    return false;
+                }
+                combatAI->attackCommand(targetUnit);
+                break;
+            }
+            default:
+                return false;
+            }
+
+            // 이동 쿨다운을 기다리며 잠든 유닛도 새 명령을 다음 틱에 처리하도록 깨웁니다.
+            map_.wakeUnit(unit);
+            return true;
+        }
+
+        void Simulation::run(std::uint64_t ticks) {
+            std::uint64_t remaining = ticks;
+            while (remaining > 0) {
+                step();
+                Profiler::instance().endTick();
+                --remaining;
+
+                // 다음으로 깨어날 유닛이 있는 틱까지는 아무 일도 일어나지 않으므로 시간만 진행합니다.
+                std::chrono::milliseconds wakeTime;
+                std::uint64_t idleTicks = remaining;
+                if (map_.getNextWakeTime(wakeTime)) {
+                    idleTicks = wakeTime > currentTime_
+                        ? std::min<std::uint64_t>(remaining, (wakeTime - currentTime_).count() / constants::TICK)
+                        : 0;
+                }
+                if (planner_) {
+                    // 계획할 틱은 건너뛰지 않습니다.
+                    const std::uint64_t interval = planner_->getConfig().interval;
+                    idleTicks = std::min<std::uint64_t>(idleTicks, (interval - tickCount_ % interval) % interval);
+                }
+                if (idleTicks > 0) {
+                    currentTime_ += std::chrono::milliseconds(idleTicks * constants::TICK);
+                    tickCount_ += idleTicks;
+                    remaining -= idleTicks;
+                    map_.advanceIdle(currentTime_);
+                }
+            }
+        }
+
+        /**
+        * PDF 1. 준비
+        */
+        void Simulation::initResources() {
+            resource_ = types::Resource{
+                100,    // spice
+                1000,   // spice_max
+                10,     // population
+                100     // population_max
+            };
+        }
+
+        /**
+        * PDF 1. 준비
+        */
+        void Simulation::initTerrain() {
+            // 바위(Rock) 배치
+            const std::vector<types::Position> rock_positions = {
+                {5, 20}, {8, 30}, {12, 40}, {3, 50}, {15, 45}
+            };
+
+            for (const auto& pos : rock_positions) {
+                map_.setTerrain(pos, types::TerrainType::Rock);
+            }
+
+            // 스파이스 매장지 배치
+            const std::vector<types::Position> spice_positions = {
+                {15, 4}, {2, 55}
+            };
+
+            for (const auto& pos : spice_positions) {
+                map_.setTerrain(pos, types::TerrainType::Spice);
+            }
+
+            // 장판(Plate) 배치
+            const std::vector<types::Position> plate_positions = {
+                {constants::MAP_HEIGHT - 3, 0}, {0, constants::MAP_WIDTH - 3}
+            };
+
+            for (const auto& pos : plate_positions) {
+                map_.setTerrain(pos, types::TerrainType::Plate);
+            }
+        }
+
+        /**
+        * PDF 1. 준비
+        */
+        void Simulation::initBuildings() {
+            // Base(B)와 Plate(P) - 좌하단
+            map_.addBuilding(std::make_unique<Building>(
+                types::BuildingType::Base,
+                types::Camp::ArtLadies,
+                types::Position{ constants::MAP_HEIGHT - 4, 0 }
+            ));
+
+            // Base(B)와 Plate(P) - 우상단
+            map_.addBuilding(std::make_unique<Building>(
+                types::BuildingType::Base,
+                types::Camp::Harkonnen,
+                types::Position{ 0, constants::MAP_WIDTH - 4 }
+            ));
+        }
+
+        /**
+        * PDF 3. 샌드웜
+        */
+        void Simulation::initSandworms() {
+            auto sandworm1 = std::make_unique<Unit>(
+                types::UnitType::Sandworm,
+                types::Position{ constants::MAP_HEIGHT - 6, 5 }
+            );
+            sandworm1->initializeAI(); // AI 초기화
+
+            map_.addUnit(std::move(sandworm1));
+
+            auto sandworm2 = std::make_unique<Unit>(
+                types::UnitType::Sandworm,
+                types::Position{ 5, constants::MAP_WIDTH - 6 }
+            );
+            sandworm2->initializeAI(); // AI 초기화
+
+            map_.addUnit(std::move(sandworm2));
+
+            map_.addSystemMessage(L"Sandworm AI successfully initialized.");
+        }
+
+        /**
+        * PDF 1. 준비
+        */
+        void Simulation::initHarvesters() {
+            addHarvester({ constants::MAP_HEIGHT - 5, 0 }, types::Camp::ArtLadies);
+            addHarvester({ 2, constants::MAP_WIDTH - 3 }, types::Camp::Harkonnen);
+        }
+
+        void Simulation::addHarvester(const types::Position& pos, types::Camp camp) {
+            auto harvester = std::make_unique<Unit>(
+                types::UnitType::Harvester,
+                entity::getUnitDescriptor(types::UnitType::Harvester).cost,
+                entity::getUnitDescriptor(types::UnitType::Harvester).population,
+                pos,
+                70,
+                constants::HARVESTER_SPEED,
+                0, 0,
+                camp
+            );
+            harvester->initializeAI();
+            map_.addUnit(std::move(harvester));
+
+            std::wstring campName = (camp == types::Camp::ArtLadies) ? L"ArtLadies" : L"Harkonnen";
+            map_.addSystemMessage(campName + L" Harvester AI successfully initialized.");
+        }
+
+        void Simulation::addSoldier(const types::Position& pos, types::Camp camp) {
+            auto soldier = std::make_unique<Unit>(
+                types::UnitType::Soldier,
+                entity::getUnitDescriptor(types::UnitType::Soldier).cost,
+                entity::getUnitDescriptor(types::UnitType::Soldier).population,
+                pos,
+                15,
+                constants::SOLDIER_SPEED,
+                5, 1,
+                camp
+            );
+            soldier->initializeAI();
+            map_.addUnit(std::move(soldier));
+
+            map_.addSystemMessage(L"Camp ArtLadies`s Soldier AI successfully initialized.");
+        }
+
+        void Simulation::addFremen(const types::Position& pos, types::Camp camp) {
+            auto fremen = std::make_unique<Unit>(
+                types::UnitType::Fremen,
+                entity::getUnitDescriptor(types::UnitType::Fremen).cost,
+                entity::getUnitDescriptor(types::UnitType::Fremen).population,
+                pos,
+                25,
+                constants::FREMEN_SPEED,
+                15, 8,
+                camp
+            );
+            fremen->initializeAI();
+            map_.addUnit(std::move(fremen));
+
+            map_.addSystemMessage(L"Camp ArtLadies`s Fremen AI successfully initialized.");
+        }
+
+        void Simulation::addFighter(const types::Position& pos, types::Camp camp) {
+            auto fighter = std::make_unique<Unit>(
+                types::UnitType::Fighter,
+                entity::getUnitDescriptor(types::UnitType::Fighter).cost,
+                entity::getUnitDescriptor(types::UnitType::Fighter).population,
+                pos,
+                6,
+                constants::FIGHTER_SPEED,
+                10, 1,
+                camp
+            );
+            fighter->initializeAI();
+            map_.addUnit(std::move(fighter));
+
+            map_.addSystemMessage(L"Camp Harkonnen`s Fighter AI successfully initialized.");
+        }
+
+        void Simulation::addHeavyTank(const types::Position& pos, types::Camp camp) {
+            auto heavyTank = std::make_unique<Unit>(
+                types::UnitType::HeavyTank,
+                entity::getUnitDescriptor(types::UnitType::HeavyTank).cost,
+                entity::getUnitDescriptor(types::UnitType::HeavyTank).population,
+                pos,
+                60,
+                constants::HEAVY_TANK_SPEED,
+                40, 4,
+                camp
+            );
+            heavyTank->initializeAI();
+            map_.addUnit(std::move(heavyTank));
+
+            map_.addSystemMessage(L"Camp Harkonnen`s heavyTank AI successfully initialized.");
+        }
+
+    } // namespace core
+} // namespace dune
@@ -0,0 +1,222 @@
+#include "core/snapshot.hpp"
+#include "utils/constants.hpp"
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dune {
+    namespace core {
+
+        namespace {
+            using namespace snapshot;
+
+            // 레코드를 바이트 그대로 쓰고 읽으므로 리틀 엔디언 환경만 지원합니다.
+            static_assert(std::endian::native == std::endian::little);
+
+            constexpr std::size_t SECTION_COUNT = 7;
+
+            std::uint64_t alignUp(std::uint64_t offset) {
+                return (offset + ALIGNMENT - 1) & ~static_cast<std::uint64_t>(ALIGNMENT - 1);
+            }
+
+            /**
+             * @brief 파일을 읽기 전용으로 메모리에 매핑합니다.
+             * 매핑을 지원하지 않는 환경에서는 파일 전체를 버퍼로 읽습니다.
+             */
+            class MappedFile {
+            public:
+                MappedFile() = default;
+                MappedFile(const MappedFile&) = delete;
+                MappedFile& operator=(const MappedFile&) = delete;
+                ~MappedFile() { close(); }
+
+                bool open(const std::string& path) {
+                    close();
+#if defined(_WIN32)
+                    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                    if (file_ == INVALID_HANDLE_VALUE) return false;
+                    LARGE_INTEGER size;
+                    if (!GetFileSizeEx(file_, &size) || size.QuadPart <= 0) return false;
+                    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (!mapping_) return false;
+                    view_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+                    if (!view_) return false;
+                    data_ = static_cast<const std::uint8_t*>(view_);
+                    size_ = static_cast<std::size_t>(size.QuadPart);
+                    return true;
+#elif defined(__unix__) || defined(__APPLE__)
+                    descriptor_ = ::open(path.c_str(), O_RDONLY);
+                    if (descriptor_ < 0) return false;
+                    struct stat status;
+                    if (fstat(descriptor_, &status) != 0 || status.st_size <= 0) return false;
+                    void* view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor_, 0);
+                    if (view == MAP_FAILED) return false;
+                    data_ = static_cast<const std::uint8_t*>(view);
+                    size_ = static_cast<std::size_t>(status.st_size);
+                    return true;
+#else
+                    std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+                    if (!file) return false;
+                    buffer_.resize(static_cast<std::size_t>(file.tellg()));
+                    file.seekg(0);
+                    if (!file.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()))) {
+                        return false;
+                    }
+                    data_ = buffer_.data();
+                    size_ = buffer_.size();
+                    return true;
+#endif
+                }
+
+                const std::uint8_t* data() const { return data_; }
+                std::size_t size() const { return size_; }
+
+            private:
+                void close() {
+#if defined(_WIN32)
+                    if (view_) UnmapViewOfFile(view_);
+                    if (mapping_) CloseHandle(mapping_);
+                    if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+                    view_ = nullptr;
+                    mapping_ = nullptr;
+                    file_ = INVALID_HANDLE_VALUE;
+#elif defined(__unix__) || defined(__APPLE__)
+                    if (data_) munmap(const_cast<std::uint8_t*>(data_), size_);
+                    if (descriptor_ >= 0) ::close(descriptor_);
+                    descriptor_ = -1;
+#else
+                    buffer_.clear();
+#endif
+                    data_ = nullptr;
+                    size_ = 0;
+                }
+
+                const std::uint8_t* data_ = nullptr;
+                std::size_t size_ = 0;
+#if defined(_WIN32)
+                HANDLE file_ = INVALID_HANDLE_VALUE;
+                HANDLE mapping_ = nullptr;
+                void* view_ = nullptr;
+#elif defined(__unix__) || defined(__APPLE__)
+                int descriptor_ = -1;
+#else
+                std::vector<std::uint8_t> buffer_;
+#endif
+            };
+
+            // 구역 목차를 채우며 본문을 8바이트 경계에 이어 붙입니다.
+            template<typename T>
+            void appendSection(std::vector<std::uint8_t>& file, std::array<SectionEntry, SECTION_COUNT>& entries,
+                std::size_t& index, SectionId id, const T* records, std::size_t count) {
+                file.resize(alignUp(file.size()), 0);
+                entries[index++] = { id, static_cast<std::uint32_t>(sizeof(T)), file.size(), count };
+                const auto* bytes = reinterpret_cast<const std::uint8_t*>(records);
+                file.insert(file.end(), bytes, bytes + count * sizeof(T));
+            }
+
+            // 목차의 구역을 레코드 배열로 봅니다. 크기나 경계가 맞지 않으면 false입니다.
+            template<typename T>
+            bool viewSection(const MappedFile& file, const SectionEntry& entry, std::span<const T>& records) {
+                if (entry.recordSize != sizeof(T) || entry.offset % alignof(T) != 0 || entry.offset > file.size() ||
+                    entry.count > (file.size() - entry.offset) / sizeof(T)) {
+                    return false;
+                }
+                records = { reinterpret_cast<const T*>(file.data() + entry.offset), static_cast<std::size_t>(entry.count) };
+                return true;
+            }
+        }
+
+        bool saveSnapshot(const Simulation& simulation, const std::string& path) {
+            Sections sections;
+            simulation.writeSnapshot(sections);
+
+            std::vector<std::uint8_t> file(sizeof(FileHeader) + SECTION_COUNT * sizeof(SectionEntry), 0);
+            std::array<SectionEntry, SECTION_COUNT> entries{};
+            std::size_t index = 0;
+            appendSection(file, entries, index, SectionId::Simulation, &sections.simulation, 1);
+            appendSection(file, entries, index, SectionId::Terrain, sections.terrain.data(), sections.terrain.size());
+            appendSection(file, entries, index, SectionId::Buildings, sections.buildings.data(), sections.buildings.size());
+            appendSection(file, entries, index, SectionId::Units, sections.units.data(), sections.units.size());
+            appendSection(file, entries, index, SectionId::Positions, sections.positions.data(), sections.positions.size());
+            appendSection(file, entries, index, SectionId::PathCache, sections.pathCache.data(), sections.pathCache.size());
+            appendSection(file, entries, index, SectionId::GroupMoves, sections.groupMoves.data(), sections.groupMoves.size());
+
+            FileHeader header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.sectionCount = static_cast<std::uint16_t>(SECTION_COUNT);
+            header.width = simulation.getMap().getWidth();
+            header.height = simulation.getMap().getHeight();
+            header.fileSize = file.size();
+            std::memcpy(file.data(), &header, sizeof(header));
+            std::memcpy(file.data() + sizeof(header), entries.data(), sizeof(entries));
+
+            std::ofstream out(path, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!out) {
+                return false;
+            }
+            out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+            return static_cast<bool>(out);
+        }
+
+        std::unique_ptr<Simulation> loadSnapshot(const std::string& path, Simulation::MessageHandler messageHandler) {
+            MappedFile file;
+            if (!file.open(path) || file.size() < sizeof(FileHeader)) {
+                return nullptr;
+            }
+
+            FileHeader header;
+            std::memcpy(&header, file.data(), sizeof(header));
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+                header.fileSize != file.size() ||
+                header.width != constants::MAP_WIDTH || header.height != constants::MAP_HEIGHT ||
+                file.size() < sizeof(FileHeader) + std::size_t{ header.sectionCount } * sizeof(SectionEntry)) {
+                return nullptr;
+            }
+
+            // 모르는 구역은 건너뛰고, 필요한 구역이 하나라도 없으면 거부합니다.
+            SectionView view;
+            std::span<const SimulationRecord> simulation;
+            unsigned found = 0;
+            const auto* entries = reinterpret_cast<const SectionEntry*>(file.data() + sizeof(FileHeader));
+            for (std::size_t i = 0; i < header.sectionCount; ++i) {
+                const SectionEntry& entry = entries[i];
+                bool valid = true;
+                switch (entry.id) {
+                case SectionId::Simulation:   valid = viewSection(file, entry, simulation); break;
+                case SectionId::Terrain:      valid = viewSection(file, entry, view.terrain); break;
+                case SectionId::Buildings:    valid = viewSection(file, entry, view.buildings); break;
+                case SectionId::Units:        valid = viewSection(file, entry, view.units); break;
+                case SectionId::Positions:    valid = viewSection(file, entry, view.positions); break;
+                case SectionId::PathCache:    valid = viewSection(file, entry, view.pathCache); break;
+                case SectionId::GroupMoves:   valid = viewSection(file, entry, view.groupMoves); break;
+                default:
+                    continue;
+                }
+                if (!valid) {
+                    return nullptr;
+                }
+                found |= 1u << static_cast<unsigned>(entry.id);
+            }
+            if (found != ((1u << (SECTION_COUNT + 1)) - 2) || simulation.size() != 1) {
+                return nullptr;
+            }
+            view.simulation = simulation.data();
+
+            return Simulation::restoreSnapshot(view, std::move(messageHandler));
+        }
+
+    } // namespace core
+} // namespace dune
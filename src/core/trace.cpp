@@ -0,0 +1,179 @@
+#include "core/trace.hpp"
+#include "core/profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <span>
+
+namespace dune {
+    namespace core {
+
+        namespace {
+            // 구간별 정수 인자 이름 (ProfileScope::setTraceArgs()에 넘기는 순서와 같습니다)
+            constexpr const char* STEP_ARGS[] = { "tick" };
+            constexpr const char* MAP_UPDATE_ARGS[] = { "units" };
+            constexpr const char* A_STAR_ARGS[] = { "startRow", "startColumn", "goalRow", "goalColumn", "expanded", "found" };
+            constexpr const char* FLOW_FIELD_ARGS[] = { "goalRow", "goalColumn", "reached" };
+            constexpr const char* CLUSTER_ROUTE_ARGS[] = { "startRow", "startColumn", "goalRow", "goalColumn", "waypoints" };
+
+            std::span<const char* const> argNames(std::size_t zone) {
+                switch (static_cast<ProfileZone>(zone)) {
+                case ProfileZone::SimulationStep: return STEP_ARGS;
+                case ProfileZone::MapUpdate:      return MAP_UPDATE_ARGS;
+                case ProfileZone::AStar:          return A_STAR_ARGS;
+                case ProfileZone::FlowField:      return FLOW_FIELD_ARGS;
+                case ProfileZone::ClusterRoute:   return CLUSTER_ROUTE_ARGS;
+                default:                          return {};
+                }
+            }
+
+            const char* category(std::size_t zone) {
+                switch (static_cast<ProfileZone>(zone)) {
+                case ProfileZone::ProcessInput:
+                case ProfileZone::UpdateGameState:
+                    return "game";
+                case ProfileZone::DisplayUpdate:
+                case ProfileZone::ConsoleFlush:
+                    return "render";
+                case ProfileZone::AStar:
+                case ProfileZone::FlowField:
+                case ProfileZone::ClusterRoute:
+                    return "path";
+                default:
+                    return "tick";
+                }
+            }
+
+            // Chrome 형식의 시각 단위는 마이크로초입니다. 소수 셋째 자리(ns)까지 씁니다.
+            void writeMicroseconds(std::ostream& out, std::int64_t nanoseconds) {
+                out << nanoseconds / 1000 << '.';
+                const auto fraction = nanoseconds % 1000;
+                out << static_cast<char>('0' + fraction / 100) << static_cast<char>('0' + fraction / 10 % 10)
+                    << static_cast<char>('0' + fraction % 10);
+            }
+        }
+
+        TraceRecorder& TraceRecorder::instance() {
+            static TraceRecorder recorder;
+            return recorder;
+        }
+
+        TraceRecorder::~TraceRecorder() {
+            stop();
+        }
+
+        void TraceRecorder::start(const std::string& path, std::size_t maxEventsPerThread) {
+            stop();
+
+            std::lock_guard<std::mutex> lock(threadsMutex_);
+            for (auto& buffer : threads_) {
+                buffer->events.clear();
+            }
+            dropped_.store(0, std::memory_order_relaxed);
+            maxEventsPerThread_ = maxEventsPerThread;
+            path_ = path;
+            start_ = std::chrono::steady_clock::now();
+            recording_.store(true, std::memory_order_relaxed);
+        }
+
+        bool TraceRecorder::stop() {
+            if (!isRecording()) {
+                return false;
+            }
+            recording_.store(false, std::memory_order_relaxed);
+
+            std::ofstream file(path_, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!file) {
+                return false;
+            }
+            write(file);
+            return static_cast<bool>(file);
+        }
+
+        void TraceRecorder::push(const TraceEvent& event) {
+            thread_local ThreadBuffer* buffer = nullptr;
+            if (!buffer) {
+                std::lock_guard<std::mutex> lock(threadsMutex_);
+                threads_.push_back(std::make_unique<ThreadBuffer>());
+                buffer = threads_.back().get();
+            }
+            if (buffer->events.size() >= maxEventsPerThread_) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            buffer->events.push_back(event);
+        }
+
+        void TraceRecorder::recordZone(std::size_t zone, std::chrono::steady_clock::time_point begin,
+            std::chrono::steady_clock::time_point end, const std::int32_t* args, std::size_t argCount) {
+            TraceEvent event{};
+            event.kind = TraceEvent::Kind::Zone;
+            event.zone = static_cast<std::uint16_t>(zone);
+            // 기록을 시작하기 전에 열린 구간은 시작 시각부터 잽니다.
+            begin = std::max(begin, start_);
+            event.start = sinceStart(begin);
+            event.duration = std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(), 0);
+            event.argCount = static_cast<std::uint8_t>(std::min(argCount, TraceEvent::MAX_ARGS));
+            std::copy_n(args, event.argCount, event.args.begin());
+            push(event);
+        }
+
+        void TraceRecorder::recordStateChange(std::size_t from, std::size_t to, std::int32_t unitId) {
+            TraceEvent event{};
+            event.kind = TraceEvent::Kind::StateChange;
+            event.zone = static_cast<std::uint16_t>(from);
+            event.target = static_cast<std::uint16_t>(to);
+            event.start = sinceStart(std::chrono::steady_clock::now());
+            event.argCount = 1;
+            event.args[0] = unitId;
+            push(event);
+        }
+
+        void TraceRecorder::write(std::ostream& out) const {
+            out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":" << getDroppedCount() << "},\"traceEvents\":[\n";
+            bool first = true;
+            auto separate = [&] {
+                if (!first) {
+                    out << ",\n";
+                }
+                first = false;
+            };
+
+            for (std::size_t tid = 0; tid < threads_.size(); ++tid) {
+                separate();
+                out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                    << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+
+                for (const TraceEvent& event : threads_[tid]->events) {
+                    separate();
+                    if (event.kind == TraceEvent::Kind::StateChange) {
+                        // "Soldier/Moving" → "Soldier/Moving -> Pursuing"
+                        const std::string to = Profiler::getZoneName(event.target);
+                        out << "{\"name\":\"" << Profiler::getZoneName(event.zone) << " -> " << to.substr(to.find('/') + 1)
+                            << "\",\"cat\":\"ai\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+                        writeMicroseconds(out, event.start);
+                        out << ",\"args\":{\"unit\":" << event.args[0] << "}}";
+                        continue;
+                    }
+
+                    out << "{\"name\":\"" << Profiler::getZoneName(event.zone) << "\",\"cat\":\"" << category(event.zone)
+                        << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+                    writeMicroseconds(out, event.start);
+                    out << ",\"dur\":";
+                    writeMicroseconds(out, event.duration);
+                    const auto names = argNames(event.zone);
+                    const std::size_t count = std::min<std::size_t>(event.argCount, names.size());
+                    if (count > 0) {
+                        out << ",\"args\":{";
+                        for (std::size_t i = 0; i < count; ++i) {
+                            out << (i ? "," : "") << '"' << names[i] << "\":" << event.args[i];
+                        }
+                        out << '}';
+                    }
+                    out << '}';
+                }
+            }
+            out << "\n]}\n";
+        }
+
+    } // namespace core
+} // namespace dune
@@ -9,29 +9,15 @@ namespace dune {
 
         // Building 클래스 구현
 
-        Building::Building(types::Camp type, const std::wstring& name, const std::wstring& description,
-            int buildCost, types::Position position, int width, int height, int health, types::UnitType producedUnit)
-            : type_(type)
-            , name_(name)
-            , description_(description)
-            , buildingCost_(buildCost)
+        Building::Building(types::BuildingType kind, types::Camp type, types::Position position, int health)
+            : descriptor_(&getBuildingDescriptor(kind))
+            , type_(type)
             , position_(position)
-            , width_(width)
-            , height_(height)
-            , health_(constants::DEFAULT_HEALTH)
-            , producedUnit_(producedUnit)
+            , health_(health)
         {}
 
         wchar_t Building::getRepresentation() const {
-            if (name_ == L"Base") return L'B';
-            if (name_ == L"Plate") return L'P';
-            if (name_ == L"Dormitory") return L'D';
-            if (name_ == L"Garage") return L'G';
-            if (name_ == L"Barracks") return L'K';
-            if (name_ == L"Shelter") return L'S';
-            if (name_ == L"Arena") return L'A';
-            if (name_ == L"Factory") return L'F';
-            return L'?';
+            return descriptor_->glyph;
         }
 
         int Building::getColor() const {
@@ -44,11 +30,11 @@ namespace dune {
         }
 
         void Building::printInfo() const {
-            std::wcout << L"Building: " << name_
-                << L", Description: " << description_
-                << L", Cost: " << buildingCost_
+            std::wcout << L"Building: " << descriptor_->name
+                << L", Description: " << descriptor_->description
+                << L", Cost: " << descriptor_->cost
                 << L", Position: (" << position_.row << L", " << position_.column << L")"
-                << L", Size: " << width_ << L"x" << height_
+                << L", Size: " << descriptor_->width << L"x" << descriptor_->height
                 << L", Health: " << health_ << std::endl;
         }
 
@@ -57,17 +43,18 @@ namespace dune {
         }
 
         bool Building::contains(const types::Position& position) const {
-            return position.row >= position_.row && position.row < position_.row + height_ &&
-                position.column >= position_.column && position.column < position_.column + width_;
+            return position.row >= position_.row && position.row < position_.row + descriptor_->height &&
+                position.column >= position_.column && position.column < position_.column + descriptor_->width;
         }
 
         void Building::takeDamage(int damage) {
             health_ = std::max(0, health_ - damage);
         }
 
-        bool Building::isPlaceable(const types::Position& position, const TerrainManager& terrainManager) const {
-            for (int i = 0; i < height_; ++i) {
-                for (int j = 0; j < width_; ++j) {
+        bool Building::isPlaceable(const types::Position& position, const TerrainManager& terrainManager,
+            const core::OccupancyGrid& occupancy) const {
+            for (int i = 0; i < descriptor_->height; ++i) {
+                for (int j = 0; j < descriptor_->width; ++j) {
                     types::Position checkPos = { position.row + i, position.column + j };
                     // 맵 범위 체크
                     if (checkPos.row < 0 || checkPos.row >= constants::MAP_HEIGHT ||
@@ -75,7 +62,11 @@ namespace dune {
                         return false;
                     }
                     // 지형 체크
-                    if (!terrainManager.getTerrain(checkPos).isBuildable()) {
+                    if (!terrainManager.isBuildable(checkPos)) {
+                        return false;
+                    }
+                    // 다른 건물이나 유닛과 겹치는지 체크
+                    if (occupancy.isBlocked(checkPos, core::OccupancyGrid::Building | core::OccupancyGrid::Unit)) {
                         return false;
                     }
                 }
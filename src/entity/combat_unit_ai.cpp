@@ -1,31 +1,51 @@
 #include "entity/combat_unit_ai.hpp"
 #include "entity/unit.hpp"
 #include "core/map.hpp"
+#include "core/plan_context.hpp"
+#include "core/profiler.hpp"
 #include "utils/utils.hpp"
+#include <algorithm>
+#include <functional>
 
 namespace dune::entity::combat {
     CombatUnitAI::CombatUnitAI(Unit* unit)
         : owner_(unit)
-        , currentState_(std::make_unique<CombatIdleState>(this))
+        , currentState_(std::in_place_type<CombatIdleState>, this)
         , currentTarget_(nullptr)
         , lastAttackTime_(std::chrono::milliseconds(0))
         , moveTarget_({ -1, -1 }) {}
 
+    void CombatUnitAI::traceStateChange(CombatStateKind next) const {
+        const types::UnitType type = owner_->getType();
+        core::TraceRecorder::instance().recordStateChange(core::Profiler::unitZone(type, getStateKind()),
+            core::Profiler::unitZone(type, next), static_cast<std::int32_t>(owner_->getId()));
+    }
+
     void CombatUnitAI::update(core::Map& map, std::chrono::milliseconds currentTime) {
-        // 상태가 있다면 업데이트 수행
-        if (currentState_) {
-            currentState_->update(owner_, map, currentTime);
+        std::visit([&](auto& state) { state.update(owner_, map, currentTime); }, currentState_);
+
+        // 계획 단계에서 찾은 적 공격 (Idle 상태일 때만, 그 사이 제거된 적은 무시)
+        const Unit* enemy = sightedEnemy_;
+        sightedEnemy_ = nullptr;
+        if (enemy && isIdle() && map.getUnitManager().isActive(enemy)) {
+            attackCommand(const_cast<Unit*>(enemy));
         }
+    }
+
+    void CombatUnitAI::plan(const core::Map& map, core::PlanContext& context, std::chrono::milliseconds currentTime) {
+        std::visit([&](auto& state) { state.plan(owner_, map, context, currentTime); }, currentState_);
 
         // 시야 내의 적 탐지 (Idle 상태일 때만)
-        if (currentState_->getStateName() == L"Idle") {
-            detectEnemiesInSight(map);
-        }
+        sightedEnemy_ = isIdle() ? findEnemyInSight(map, context.nearbyUnits) : nullptr;
     }
 
-    void CombatUnitAI::moveCommand(const types::Position& target) {
+    std::chrono::milliseconds CombatUnitAI::getNextUpdateTime(std::chrono::milliseconds currentTime) const {
+        return std::visit([&](const auto& state) { return state.getNextUpdateTime(owner_, currentTime); }, currentState_);
+    }
+
+    void CombatUnitAI::moveCommand(const types::Position& target, MoveMode mode) {
         moveTarget_ = target;
-        CombatChangeState(std::make_unique<CombatMovingState>(this, target));
+        CombatChangeState<CombatMovingState>(target, mode);
     }
 
     void CombatUnitAI::attackCommand(Unit* target) {
@@ -33,34 +53,54 @@ namespace dune::entity::combat {
 
         currentTarget_ = target;
         // 공격 범위 내에 있으면 바로 공격, 아니면 추적
-        if (currentState_->isInAttackRange(owner_, target)) {
-            CombatChangeState(std::make_unique<AttackingState>(this, target));
+        if (CombatUnitState::isInAttackRange(owner_, target)) {
+            CombatChangeState<AttackingState>(target);
         }
         else {
-            CombatChangeState(std::make_unique<PursuingState>(this, target));
+            CombatChangeState<PursuingState>(target);
         }
     }
 
-    void CombatUnitAI::patrolCommand(const types::Position& from, const types::Position& to) {
-        CombatChangeState(std::make_unique<PatrollingState>(this, from, to));
+    bool CombatUnitAI::holdsTargetIn(std::span<const Unit* const> units) const {
+        return isTargetIn(currentTarget_, units) || isTargetIn(getStateTarget(), units);
     }
 
-    std::wstring CombatUnitAI::getCurrentState() const {
-        return currentState_ ? currentState_->getStateName() : L"Unknown";
+    void CombatUnitAI::releaseTargets(std::span<const Unit* const> removed) {
+        if (isTargetIn(currentTarget_, removed)) {
+            currentTarget_ = nullptr;
+        }
+        if (isTargetIn(getStateTarget(), removed)) {
+            CombatChangeState<CombatIdleState>();
+        }
     }
 
-    void CombatUnitAI::CombatChangeState(std::unique_ptr<CombatUnitState> newState) {
-        currentState_ = std::move(newState);
+    bool CombatUnitAI::isTargetIn(const Unit* target, std::span<const Unit* const> units) {
+        return target && std::binary_search(units.begin(), units.end(), target, std::less<>());
     }
 
-    void CombatUnitAI::detectEnemiesInSight(core::Map& map) {
-        const auto& quadTree = map.getUnitManager().getQuadTree();
-        std::vector<const entity::Unit*> nearbyUnits;
+    const Unit* CombatUnitAI::getStateTarget() const {
+        return std::visit([](const auto& state) -> const Unit* {
+            if constexpr (requires { state.getTarget(); }) {
+                return state.getTarget();
+            }
+            else {
+                return nullptr;
+            }
+        }, currentState_);
+    }
+
+    void CombatUnitAI::patrolCommand(const types::Position& from, const types::Position& to) {
+        CombatChangeState<PatrollingState>(from, to);
+    }
+
+    const Unit* CombatUnitAI::findEnemyInSight(const core::Map& map, std::vector<const Unit*>& nearbyUnits) const {
+        const auto& spatialIndex = map.getUnitManager().getSpatialIndex();
+        nearbyUnits.clear();
 
         types::Position pos = owner_->getPosition();
         int sightRange = owner_->getSightRange();
 
-        quadTree.queryRange(
+        spatialIndex.queryRange(
             pos.column - sightRange,
             pos.row - sightRange,
             sightRange * 2,
@@ -69,7 +109,7 @@ namespace dune::entity::combat {
         );
 
         // 가장 가까운 적 찾기
-        Unit* nearestEnemy = nullptr;
+        const Unit* nearestEnemy = nullptr;
         int minDistance = std::numeric_limits<int>::max();
 
         for (const auto* nearbyUnit : nearbyUnits) {
@@ -78,7 +118,7 @@ namespace dune::entity::combat {
 
             // 하베스터는 공격 우선순위가 높음
             if (nearbyUnit->getType() == types::UnitType::Harvester) {
-                nearestEnemy = const_cast<Unit*>(nearbyUnit);
+                nearestEnemy = nearbyUnit;
                 break;
             }
 
@@ -89,13 +129,66 @@ namespace dune::entity::combat {
 
             if (distance < minDistance) {
                 minDistance = distance;
-                nearestEnemy = const_cast<Unit*>(nearbyUnit);
+                nearestEnemy = nearbyUnit;
             }
         }
 
-        // 적을 발견하면 공격
-        if (nearestEnemy) {
-            attackCommand(nearestEnemy);
+        return nearestEnemy;
+    }
+
+    void CombatUnitAI::save(
+        core::snapshot::AiRecord& record,
+        std::vector<core::snapshot::PositionRecord>& positions,
+        const core::snapshot::UnitIds& ids
+    ) const {
+        record.kind = core::snapshot::AiKind::Combat;
+        record.state = static_cast<std::uint8_t>(getStateKind());
+        record.targetUnit = core::snapshot::findUnitId(ids, currentTarget_);
+        record.targetPosition = core::snapshot::toRecord(moveTarget_);
+        record.lastAttackTime = lastAttackTime_.count();
+        record.stateTargetUnit = core::snapshot::NO_UNIT;
+        std::visit([&](const auto& state) { state.save(record, ids); }, currentState_);
+        core::snapshot::appendPath(positions, path_, record.pathOffset, record.pathCount);
+        core::snapshot::appendPath(positions, waypoints_, record.waypointOffset, record.waypointCount);
+    }
+
+    bool CombatUnitAI::restore(
+        const core::snapshot::AiRecord& record,
+        std::span<const core::snapshot::PositionRecord> positions,
+        const managers::UnitManager& units
+    ) {
+        if (record.moveMode > static_cast<std::uint8_t>(MoveMode::FlowField)) {
+            return false;
+        }
+
+        Unit* stateTarget = units.findUnitById(record.stateTargetUnit);
+        switch (static_cast<CombatStateKind>(record.state)) {
+        case CombatStateKind::Idle:
+            CombatChangeState<CombatIdleState>();
+            break;
+        case CombatStateKind::Moving:
+            CombatChangeState<CombatMovingState>(
+                core::snapshot::toPosition(record.stateTarget), static_cast<MoveMode>(record.moveMode));
+            break;
+        case CombatStateKind::Attacking:
+            CombatChangeState<AttackingState>(stateTarget);
+            break;
+        case CombatStateKind::Patrolling:
+            CombatChangeState<PatrollingState>(
+                core::snapshot::toPosition(record.patrolFrom), core::snapshot::toPosition(record.patrolTo));
+            break;
+        case CombatStateKind::Pursuing:
+            CombatChangeState<PursuingState>(stateTarget);
+            break;
+        default:
+            return false;
         }
+        std::visit([&](auto& state) { state.restore(record); }, currentState_);
+
+        currentTarget_ = units.findUnitById(record.targetUnit);
+        moveTarget_ = core::snapshot::toPosition(record.targetPosition);
+        lastAttackTime_ = std::chrono::milliseconds(record.lastAttackTime);
+        return core::snapshot::readPath(positions, record.pathOffset, record.pathCount, path_) &&
+            core::snapshot::readPath(positions, record.waypointOffset, record.waypointCount, waypoints_);
     }
-} // namespace dune::entity
\ No newline at end of file
+} // namespace dune::entity
@@ -1,130 +1,46 @@
 #include "entity/combat_unit_state.hpp"
+#include "entity/combat_unit_ai.hpp"
 #include "core/map.hpp"
 #include "utils/utils.hpp"
-#include <iostream>
-#include <queue>
-#include <unordered_set>
+#include "utils/constants.hpp"
+#include <algorithm>
 #include <array>
+#include <iostream>
 
 namespace dune::entity::combat {
 
-    // A* 알고리즘을 이용한 경로 찾기 (하베스터와 동일)
-    std::vector<types::Position> CombatUnitState::findPath(
-        const types::Position& start,
-        const types::Position& goal,
-        const core::Map& map
-    ) const {
-        // 방향 설정 (상, 하, 좌, 우)
-        const std::array<types::Position, 4> directions = {
-            types::Position{-1, 0}, // 위
-            types::Position{1, 0}, // 아래
-            types::Position{0, -1}, // 왼쪽
-            types::Position{0, 1}  // 오른쪽
-        };
-
-        // 우선순위 큐 및 노드 관리
-        auto cmp = [](const types::Node& a, const types::Node& b) {
-            return a.fCost() > b.fCost();
-            };
-        std::priority_queue<types::Node, std::vector<types::Node>, decltype(cmp)> openList(cmp);
-        std::unordered_map<types::Position, types::Node> closedList;
-
-        // 시작 노드 초기화
-        openList.push({ start, 0, utils::manhattanDistance(start, goal), { -1, -1 } });
-
-        while (!openList.empty()) {
-            // 최상위 노드 가져오기
-            types::Node currentNode = openList.top();
-            openList.pop();
-
-            // 목표 지점에 도달하면 경로 재구성
-            if (currentNode.position == goal) {
-                std::vector<types::Position> path;
-                types::Position currentPos = goal;
-                while (currentPos != start) {
-                    path.push_back(currentPos);
-                    currentPos = closedList[currentPos].parent; // 부모 노드로 이동
-                }
-                std::reverse(path.begin(), path.end());
-                return path; // 완성된 경로 반환
-            }
-
-            // 현재 노드를 닫힌 리스트에 추가
-            closedList[currentNode.position] = currentNode;
-
-            // 이웃 노드 탐색
-            for (const auto& dir : directions) {
-                types::Position neighborPos = currentNode.position + dir;
-
-                // 맵 경계 확인
-                if (!neighborPos.is_valid() ||
-                    neighborPos.row >= map.getHeight() ||
-                    neighborPos.column >= map.getWidth()) {
-                    continue;
-                }
-
-                // 장애물 확인
-                const auto& terrain = map.getTerrainManager().getTerrain(neighborPos);
-                if (terrain.getType() == types::TerrainType::Rock ||
-                    map.getEntityAt<dune::entity::Building>(neighborPos) ||
-                    map.getEntityAt<dune::entity::Unit>(neighborPos)) {
-                    continue; // 장애물이 있는 경우 무시
-                }
-
-                // 비용 계산
-                int newGCost = currentNode.gCost + 1; // 기본 이동 비용
-                int hCost = utils::manhattanDistance(neighborPos, goal);
-
-                // 이미 닫힌 리스트에 있는 노드는 무시
-                if (closedList.find(neighborPos) != closedList.end() &&
-                    closedList[neighborPos].gCost <= newGCost) {
-                    continue;
-                }
-
-                // 우선순위 큐에 추가
-                openList.push({ neighborPos, newGCost, hCost, currentNode.position });
-            }
-        }
-
-        // 경로를 찾지 못한 경우
-        return {};
-    }
-
     bool CombatUnitState::isInAttackRange(
         const Unit* attacker,
         const Unit* target
-    ) const {
+    ) {
         if (!attacker || !target) return false;
 
-        int distance = utils::manhattanDistance(
-            attacker->getPosition(),
-            target->getPosition()
-        );
+        const int attackRange = getAttackRange(attacker->getType());
+        if (attackRange == 0) {
+            return false;  // 공격 불가능한 유닛
+        }
+        return utils::manhattanDistance(attacker->getPosition(), target->getPosition()) <= attackRange;
+    }
 
+    int CombatUnitState::getAttackRange(types::UnitType type) {
         // 각 유닛의 특성에 따른 공격 범위 설정
-        int attackRange;
-        switch (attacker->getType()) {
+        switch (type) {
         case types::UnitType::Soldier:    // 보병
         case types::UnitType::Fighter:    // 투사
-            attackRange = 1;  // 근접 공격
-            break;
+            return 1;  // 근접 공격
         case types::UnitType::Fremen:     // 프레멘
-            attackRange = 2;  // 중거리 공격
-            break;
+            return 2;  // 중거리 공격
         case types::UnitType::HeavyTank:  // 중전차
-            attackRange = 3;  // 장거리 공격
-            break;
+            return 3;  // 장거리 공격
         default:
-            return false;  // 공격 불가능한 유닛
+            return 0;  // 공격 불가능한 유닛
         }
-
-        return distance <= attackRange;
     }
 
     bool CombatUnitState::isInSightRange(
         const Unit* unit,
         const types::Position& pos
-    ) const {
+    ) {
         if (!unit) return false;
 
         int distance = utils::manhattanDistance(
@@ -142,6 +58,10 @@ namespace dune::entity::combat {
         return unit->isReadyToMove(currentTime); // 이동과 동일한 쿨다운 사용
     }
 
+    std::chrono::milliseconds CombatUnitState::getNextSightScanTime(const Unit* unit, std::chrono::milliseconds currentTime) {
+        return currentTime + std::chrono::milliseconds(std::max(unit->getSpeed(), constants::TICK));
+    }
+
     // CombatIdleState 구현
     CombatIdleState::CombatIdleState(CombatUnitAI* ai)
         : ai_(ai) {}
@@ -156,38 +76,131 @@ namespace dune::entity::combat {
     }
 
     // CombatMovingState 구현
-    CombatMovingState::CombatMovingState(CombatUnitAI* ai, const types::Position& target)
+    CombatMovingState::CombatMovingState(CombatUnitAI* ai, const types::Position& target, MoveMode mode)
         : ai_(ai)
         , targetPosition_(target)
-        , currentPath_() {}
+        , mode_(mode) {}
+
+    void CombatMovingState::plan(
+        const Unit* unit,
+        const core::Map& map,
+        core::PlanContext& context,
+        std::chrono::milliseconds currentTime
+    ) {
+        auto& path = ai_->getPath();
+        // 흐름장은 목표별로 공유되므로 반영 단계에서 받습니다.
+        if (mode_ == MoveMode::Path && path.empty()) {
+            map.planHierarchicalPath(context, unit, targetPosition_, ai_->getWaypoints(), path);
+        }
+    }
 
     void CombatMovingState::update(
         Unit* unit,
         core::Map& map,
         std::chrono::milliseconds currentTime
     ) {
-        if (currentPath_.empty()) {
-            currentPath_ = findPath(unit->getPosition(), targetPosition_, map);
-            if (currentPath_.empty()) {
+        auto& path = ai_->getPath();
+        auto& waypoints = ai_->getWaypoints();
+        if (mode_ == MoveMode::FlowField) {
+            updateFlowField(unit, map, currentTime);
+            return;
+        }
+
+        // 새 경유지 목록이 필요하면 plan()이 넘겨 두었으므로 여기서 구합니다.
+        if (path.empty()) {
+            map.findHierarchicalPath(unit, targetPosition_, waypoints, path);
+            if (path.empty()) {
+                map.addSystemMessage(L"Unable to find path to target.");
+                ai_->CombatChangeState<CombatIdleState>();
+                return;
+            }
+        }
+
+        if (unit->isReadyToMove(currentTime)) {
+            types::Position nextPos = path.back();
+            if (!map.moveUnit(unit, nextPos)) {
+                // 다른 유닛이 경로를 막고 있으면 다음 틱에 경로를 다시 계산합니다.
+                path.clear();
+                waypoints.clear();
+                return;
+            }
+            path.pop_back();
+            unit->updateLastMoveTime(currentTime);
+
+            if (path.empty() && waypoints.empty()) {
+                // 목적지 도달
+                ai_->CombatChangeState<CombatIdleState>();
+            }
+        }
+    }
+
+    std::chrono::milliseconds CombatMovingState::getNextUpdateTime(
+        const Unit* unit,
+        std::chrono::milliseconds currentTime
+    ) const {
+        // 경로와 흐름장은 update()에서 바로 준비되므로 다음 이동 쿨다운까지 잘 수 있습니다.
+        return unit->getNextMoveTime();
+    }
+
+    void CombatMovingState::updateFlowField(
+        Unit* unit,
+        core::Map& map,
+        std::chrono::milliseconds currentTime
+    ) {
+        // 지형/건물이 바뀌어 흐름장이 오래되면 새 흐름장을 받습니다 (같은 목표의 유닛들과 다시 공유).
+        if (!flowField_ || flowField_->isStale()) {
+            flowField_ = map.acquireFlowField(targetPosition_);
+            if (unit->getPosition() != targetPosition_ && !flowField_->isReachable(unit->getPosition())) {
                 map.addSystemMessage(L"Unable to find path to target.");
-                ai_->CombatChangeState(std::make_unique<CombatIdleState>(ai_));
+                ai_->CombatChangeState<CombatIdleState>();
                 return;
             }
         }
 
+        if (unit->getPosition() == targetPosition_) {
+            ai_->CombatChangeState<CombatIdleState>();
+            return;
+        }
+
         if (unit->isReadyToMove(currentTime)) {
-            types::Position nextPos = currentPath_.back();
-            currentPath_.pop_back();
-            unit->moveTo(nextPos);
+            types::Position nextPos;
+            if (!flowField_->nextStep(map, unit->getPosition(), nextPos) || !map.moveUnit(unit, nextPos)) {
+                // 앞이 이미 멈춘 유닛들로 막혀 있으면 도착한 것으로 보고, 움직이는 유닛이면 한 이동 주기 기다립니다.
+                unit->updateLastMoveTime(currentTime);
+                if (isBlockedBySettledUnits(unit, map) || ++blockedMoves_ >= MAX_BLOCKED_MOVES) {
+                    ai_->CombatChangeState<CombatIdleState>();
+                }
+                return;
+            }
+            blockedMoves_ = 0;
             unit->updateLastMoveTime(currentTime);
 
-            if (currentPath_.empty()) {
+            if (nextPos == targetPosition_) {
                 // 목적지 도달
-                ai_->CombatChangeState(std::make_unique<CombatIdleState>(ai_));
+                ai_->CombatChangeState<CombatIdleState>();
             }
         }
     }
 
+    void CombatMovingState::save(core::snapshot::AiRecord& record, const core::snapshot::UnitIds& ids) const {
+        record.stateTarget = core::snapshot::toRecord(targetPosition_);
+        record.moveMode = static_cast<std::uint8_t>(mode_);
+        record.blockedMoves = blockedMoves_;
+    }
+
+    bool CombatMovingState::isBlockedBySettledUnits(const Unit* unit, const core::Map& map) const {
+        std::array<types::Position, 4> closer;
+        int count = flowField_->getCloserNeighbors(unit->getPosition(), closer);
+        for (int i = 0; i < count; ++i) {
+            const Unit* occupant = map.getEntityAt<Unit>(closer[i]);
+            if (!occupant) return false;
+
+            const auto* occupantAI = occupant->getCombatUnitAI();
+            if (occupantAI && occupantAI->getStateKind() == CombatStateKind::Moving) return false;
+        }
+        return true;
+    }
+
     // 공격 상태 구현
     AttackingState::AttackingState(CombatUnitAI* ai, Unit* target)
         : ai_(ai)
@@ -201,13 +214,13 @@ namespace dune::entity::combat {
     ) {
         if (!target_ || target_->getHealth() <= 0) {
             // 타겟이 죽었거나 없어진 경우
-            ai_->CombatChangeState(std::make_unique<CombatIdleState>(ai_));
+            ai_->CombatChangeState<CombatIdleState>();
             return;
         }
 
         if (!isInAttackRange(unit, target_)) {
             // 타겟이 공격 범위를 벗어난 경우 추적 상태로 전환
-            ai_->CombatChangeState(std::make_unique<PursuingState>(ai_, target_));
+            ai_->CombatChangeState<PursuingState>(target_);
             return;
         }
 
@@ -215,31 +228,34 @@ namespace dune::entity::combat {
             // 공격 실행
             int damage = unit->getAttackPower();
 
-            // 메시지 생성
-            std::wstring message;
-            if (unit->getCamp() == types::Camp::ArtLadies) {
-                message = L"Our " + getUnitTypeName(unit->getType()) +
-                    L" attacks enemy for " + std::to_wstring(damage) + L" damage!";
-            }
-            else {
-                message = L"Enemy " + getUnitTypeName(unit->getType()) +
-                    L" attacks us for " + std::to_wstring(damage) + L" damage!";
-            }
-            map.addSystemMessage(message);
+            core::GameEvent attacked{ core::GameEventType::UnitAttacked };
+            attacked.camp = unit->getCamp();
+            attacked.unitType = unit->getType();
+            attacked.position = target_->getPosition();
+            attacked.amount = damage;
+            map.getEvents().publish(attacked);
 
-            // TODO: target_->takeDamage(damage) 구현 필요
+            map.setUnitHealth(target_, getHealthAfterAttack(target_->getHealth(), damage));
+            unit->updateLastMoveTime(currentTime);
             lastAttackTime_ = currentTime;
+
+            if (target_->getHealth() <= 0) {
+                core::GameEvent killed{ core::GameEventType::UnitKilled };
+                killed.camp = target_->getCamp();
+                killed.unitType = target_->getType();
+                killed.sourceType = unit->getType();
+                killed.position = target_->getPosition();
+                map.getEvents().publish(killed);
+                map.removeUnit(target_);
+                ai_->CombatChangeState<CombatIdleState>();
+                return;
+            }
         }
     }
 
-    std::wstring AttackingState::getUnitTypeName(types::UnitType type) const {
-        switch (type) {
-        case types::UnitType::Soldier:    return L"Soldier";
-        case types::UnitType::Fremen:     return L"Fremen";
-        case types::UnitType::Fighter:    return L"Fighter";
-        case types::UnitType::HeavyTank:  return L"Heavy Tank";
-        default:                          return L"Unit";
-        }
+    void AttackingState::save(core::snapshot::AiRecord& record, const core::snapshot::UnitIds& ids) const {
+        record.stateTargetUnit = core::snapshot::findUnitId(ids, target_);
+        record.stateTime = lastAttackTime_.count();
     }
 
     // 추적 상태 구현
@@ -248,41 +264,60 @@ namespace dune::entity::combat {
         , target_(target)
         , lastPathUpdateTime_(std::chrono::milliseconds(0)) {}
 
+    void PursuingState::plan(
+        const Unit* unit,
+        const core::Map& map,
+        core::PlanContext& context,
+        std::chrono::milliseconds currentTime
+    ) {
+        auto& path = ai_->getPath();
+        // 타겟이 없거나 공격 범위 안이면 update()에서 상태를 바꿉니다.
+        if (!target_ || target_->getHealth() <= 0 || isInAttackRange(unit, target_)) {
+            return;
+        }
+
+        // 주기적으로 경로 업데이트
+        if (path.empty() ||
+            (currentTime - lastPathUpdateTime_).count() > 1000) {  // 1초마다 경로 갱신
+            map.planPath(context, unit->getPosition(), target_->getPosition(), path);
+            lastPathUpdateTime_ = currentTime;
+        }
+    }
+
     void PursuingState::update(
         Unit* unit,
         core::Map& map,
         std::chrono::milliseconds currentTime
     ) {
+        auto& path = ai_->getPath();
         if (!target_ || target_->getHealth() <= 0) {
-            ai_->CombatChangeState(std::make_unique<CombatIdleState>(ai_));
+            ai_->CombatChangeState<CombatIdleState>();
             return;
         }
 
         // 타겟이 공격 범위 안에 들어오면 공격 상태로 전환
         if (isInAttackRange(unit, target_)) {
-            ai_->CombatChangeState(std::make_unique<AttackingState>(ai_, target_));
+            ai_->CombatChangeState<AttackingState>(target_);
             return;
         }
 
-        // 주기적으로 경로 업데이트
-        if (currentPath_.empty() ||
-            (currentTime - lastPathUpdateTime_).count() > 1000) {  // 1초마다 경로 갱신
-            currentPath_ = findPath(
-                unit->getPosition(),
-                target_->getPosition(),
-                map
-            );
-            lastPathUpdateTime_ = currentTime;
-        }
-
-        if (!currentPath_.empty() && unit->isReadyToMove(currentTime)) {
-            types::Position nextPos = currentPath_.back();
-            currentPath_.pop_back();
-            unit->moveTo(nextPos);
+        if (!path.empty() && unit->isReadyToMove(currentTime)) {
+            types::Position nextPos = path.back();
+            if (!map.moveUnit(unit, nextPos)) {
+                // 다른 유닛이 경로를 막고 있으면 다음 틱에 경로를 다시 계산합니다.
+                path.clear();
+                return;
+            }
+            path.pop_back();
             unit->updateLastMoveTime(currentTime);
         }
     }
 
+    void PursuingState::save(core::snapshot::AiRecord& record, const core::snapshot::UnitIds& ids) const {
+        record.stateTargetUnit = core::snapshot::findUnitId(ids, target_);
+        record.stateTime = lastPathUpdateTime_.count();
+    }
+
     // 순찰 상태 구현
     PatrollingState::PatrollingState(
         CombatUnitAI* ai,
@@ -294,19 +329,22 @@ namespace dune::entity::combat {
         , toPosition_(to)
         , currentTarget_(to) {}
 
-    void PatrollingState::update(
-        Unit* unit,
-        core::Map& map,
+    void PatrollingState::plan(
+        const Unit* unit,
+        const core::Map& map,
+        core::PlanContext& context,
         std::chrono::milliseconds currentTime
     ) {
-        // 적 발견 시 추적으로 전환
-        const auto& quadTree = map.getUnitManager().getQuadTree();
-        std::vector<const entity::Unit*> nearbyUnits;
+        auto& path = ai_->getPath();
+        // 적 발견 시 update()에서 추적으로 전환
+        const auto& spatialIndex = map.getUnitManager().getSpatialIndex();
+        auto& nearbyUnits = context.nearbyUnits;
+        nearbyUnits.clear();
 
         types::Position pos = unit->getPosition();
         int sightRange = unit->getSightRange();
 
-        quadTree.queryRange(
+        spatialIndex.queryRange(
             pos.column - sightRange,  // qx
             pos.row - sightRange,     // qy
             sightRange * 2,           // qw
@@ -314,27 +352,60 @@ namespace dune::entity::combat {
             nearbyUnits               // results
         );
 
+        sightedEnemy_ = nullptr;
         for (const auto* nearbyUnit : nearbyUnits) {
             if (nearbyUnit->getCamp() != unit->getCamp()) {
-                ai_->CombatChangeState(std::make_unique<PursuingState>(ai_, const_cast<Unit*>(nearbyUnit)));
+                sightedEnemy_ = nearbyUnit;
                 return;
             }
         }
 
-        if (currentPath_.empty()) {
-            currentPath_ = findPath(unit->getPosition(), currentTarget_, map);
+        if (path.empty()) {
+            map.planPath(context, unit->getPosition(), currentTarget_, path);
+        }
+    }
+
+    void PatrollingState::update(
+        Unit* unit,
+        core::Map& map,
+        std::chrono::milliseconds currentTime
+    ) {
+        auto& path = ai_->getPath();
+        // 계획 단계에서 본 적이 아직 살아 있으면 추적으로 전환
+        if (sightedEnemy_ && map.getUnitManager().isActive(sightedEnemy_)) {
+            ai_->CombatChangeState<PursuingState>(const_cast<Unit*>(sightedEnemy_));
+            return;
         }
 
-        if (!currentPath_.empty() && unit->isReadyToMove(currentTime)) {
-            types::Position nextPos = currentPath_.back();
-            currentPath_.pop_back();
-            unit->moveTo(nextPos);
+        if (!path.empty() && unit->isReadyToMove(currentTime)) {
+            types::Position nextPos = path.back();
+            if (!map.moveUnit(unit, nextPos)) {
+                // 다른 유닛이 경로를 막고 있으면 다음 틱에 경로를 다시 계산합니다.
+                path.clear();
+                return;
+            }
+            path.pop_back();
             unit->updateLastMoveTime(currentTime);
 
-            if (currentPath_.empty()) {
+            if (path.empty()) {
                 // 목적지에 도달하면 다음 목적지로 전환
                 currentTarget_ = (currentTarget_ == toPosition_) ? fromPosition_ : toPosition_;
             }
         }
     }
-}
\ No newline at end of file
+
+    std::chrono::milliseconds PatrollingState::getNextUpdateTime(
+        const Unit* unit,
+        std::chrono::milliseconds currentTime
+    ) const {
+        // 시야는 깨어날 때마다 plan()에서 훑으므로 이동 주기가 곧 시야 주기입니다.
+        // 경로가 없으면 (막혔거나 찾지 못했으면) 한 이동 주기 뒤에 시야와 경로를 함께 다시 봅니다.
+        return ai_->getPath().empty() ? getNextSightScanTime(unit, currentTime) : unit->getNextMoveTime();
+    }
+
+    void PatrollingState::save(core::snapshot::AiRecord& record, const core::snapshot::UnitIds& ids) const {
+        record.patrolFrom = core::snapshot::toRecord(fromPosition_);
+        record.patrolTo = core::snapshot::toRecord(toPosition_);
+        record.stateTarget = core::snapshot::toRecord(currentTarget_);
+    }
+}
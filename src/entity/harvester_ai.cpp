@@ -2,31 +2,56 @@
 #include "entity/harvester_state.hpp"
 #include "entity/unit.hpp"
 #include "core/map.hpp"
+#include "core/profiler.hpp"
 #include "utils/harvester_command.hpp"
+#include "utils/log.hpp"
 
 namespace dune::entity {
 
     HarvesterAI::HarvesterAI(const types::Position& basePosition)
             : basePosition_(basePosition)
-            , currentState_(std::make_unique<IdleState>(this))
+            , targetPosition_{}
+            , currentState_(std::in_place_type<IdleState>, this)
             , spiceAmount_(0) {}
+
+    void HarvesterAI::traceStateChange(HarvesterStateKind next) const {
+        // AI는 자기 유닛을 모르므로 유닛 번호는 남기지 않습니다.
+        core::TraceRecorder::instance().recordStateChange(core::Profiler::unitZone(types::UnitType::Harvester, getStateKind()),
+            core::Profiler::unitZone(types::UnitType::Harvester, next), -1);
+    }
     
     void HarvesterAI::update(Unit* harvester, core::Map& map, std::chrono::milliseconds currentTime) {
-        map.addSystemMessage(L"[DEBUG] HarvesterAI::update - Current State: " + currentState_->getStateName());
-        if (currentState_) {
-            currentState_->update(harvester, map, currentTime);
-        }
+        utils::log<utils::LogLevel::Debug>([&] {
+            return std::wstring(L"HarvesterAI::update - Current State: ") + getCurrentState();
+        });
+        std::visit([&](auto& state) { state.update(harvester, map, currentTime); }, currentState_);
 
         // 명령이 없고 유후 상태일 때 마지막 명령 반복 실행
         if (commandQueue_.hasCommand() &&
-        currentState_->getStateName() == L"Idle") {
-            map.addSystemMessage(L"[DEBUG] Executing last command in Idle state");
+        getStateKind() == HarvesterStateKind::Idle) {
+            utils::log<utils::LogLevel::Debug>([] { return std::wstring(L"Executing last command in Idle state"); });
             executeLastCommand(harvester, map, currentTime);
         }
     }
 
-    void HarvesterAI::changeState(std::unique_ptr<HarvesterState> newState) {
-        currentState_ = std::move(newState);
+    void HarvesterAI::plan(
+        const Unit* harvester,
+        const core::Map& map,
+        core::PlanContext& context,
+        std::chrono::milliseconds currentTime
+    ) {
+        std::visit([&](auto& state) { state.plan(harvester, map, context, currentTime); }, currentState_);
+    }
+
+    std::chrono::milliseconds HarvesterAI::getNextUpdateTime(
+        const Unit* harvester,
+        std::chrono::milliseconds currentTime
+    ) const {
+        // 대기 중에 남은 명령이 있으면 매 틱 다시 시도합니다.
+        if (commandQueue_.hasCommand() && getStateKind() == HarvesterStateKind::Idle) {
+            return currentTime;
+        }
+        return std::visit([&](const auto& state) { return state.getNextUpdateTime(harvester, currentTime); }, currentState_);
     }
 
     bool HarvesterAI::giveHarvestCommand(
@@ -34,10 +59,9 @@ namespace dune::entity {
         const types::Position& spicePosition,
         std::chrono::milliseconds currentTime
     ) {
-        map.addSystemMessage(L"[DEBUG] Attempting to give harvest command");
-        const auto& terrain = map.getTerrainManager().getTerrain(spicePosition);
-        if (terrain.getType() != types::TerrainType::Spice) {
-            map.addSystemMessage(L"[DEBUG] Invalid harvest location: No spice");
+        utils::log<utils::LogLevel::Debug>([] { return std::wstring(L"Attempting to give harvest command"); });
+        if (map.getTerrainManager().getType(spicePosition) != types::TerrainType::Spice) {
+            utils::log<utils::LogLevel::Debug>([] { return std::wstring(L"Invalid harvest location: No spice"); });
             return false;
         }
 
@@ -49,8 +73,9 @@ namespace dune::entity {
         auto command = HarvesterCommand::createHarvestCommand(spicePosition, currentTime);
         commandQueue_.addCommand(command);
         targetPosition_ = spicePosition;
-        changeState(std::make_unique<MovingToHarvestState>(this, spicePosition));
-        map.addSystemMessage(L"[DEBUG] Harvest command given successfully");
+        changeState<MovingToHarvestState>(spicePosition);
+        map.wakeUnit(harvester);
+        utils::log<utils::LogLevel::Debug>([] { return std::wstring(L"Harvest command given successfully"); });
         return true;
     }
 
@@ -69,7 +94,8 @@ namespace dune::entity {
         auto command = HarvesterCommand::createMoveCommand(movePosition, currentTime);
         commandQueue_.addCommand(command);
         targetPosition_ = movePosition;
-        changeState(std::make_unique<MovingState>(this, movePosition));
+        changeState<MovingState>(movePosition);
+        map.wakeUnit(harvester);
         map.addSystemMessage(L"Commands Successfully change state");
         return true;
     }
@@ -95,7 +121,7 @@ namespace dune::entity {
 
         // 명령이 성공적으로 실행되었다면 큐를 비웁니다
         if (commandExecuted) {
-            map.addSystemMessage(L"[DEBUG] Command executed successfully, clearing queue");
+            utils::log<utils::LogLevel::Debug>([] { return std::wstring(L"Command executed successfully, clearing queue"); });
             commandQueue_.clear();
         }
     }
@@ -104,14 +130,8 @@ namespace dune::entity {
         const core::Map& map,
         const types::Position& spicePos
     ) const {
-        const auto& units = map.getUnitManager().getUnits();
-        for (const auto& [pos, unit] : units) {
-            if (unit->getType() == types::UnitType::Harvester &&
-                unit->getPosition() == spicePos) {
-                    return true;
-            }
-        }
-        return false;
+        const auto* unit = map.getUnitManager().getUnitAt(spicePos);
+        return unit && unit->getType() == types::UnitType::Harvester;
     }
 
     bool HarvesterAI::isValidMovePosition(
@@ -120,7 +140,49 @@ namespace dune::entity {
     ) const {
         if (!pos.is_valid()) return false;
 
-        const auto& terrain = map.getTerrainManager().getTerrain(pos);
-        return terrain.isWalkable() && !map.getEntityAt<Building>(pos);
+        return !map.getOccupancy().isBlocked(pos, core::OccupancyGrid::STATIC_LAYERS);
+    }
+
+    void HarvesterAI::save(core::snapshot::AiRecord& record, std::vector<core::snapshot::PositionRecord>& positions) const {
+        const auto& command = commandQueue_.getCurrentCommand();
+        record.kind = core::snapshot::AiKind::Harvester;
+        record.state = static_cast<std::uint8_t>(getStateKind());
+        record.commandType = static_cast<std::uint8_t>(command.type);
+        record.spiceAmount = spiceAmount_;
+        record.basePosition = core::snapshot::toRecord(basePosition_);
+        record.targetPosition = core::snapshot::toRecord(targetPosition_);
+        record.commandPosition = core::snapshot::toRecord(command.targetPosition);
+        record.commandTime = command.issueTime.count();
+        std::visit([&](const auto& state) { state.save(record); }, currentState_);
+        core::snapshot::appendPath(positions, path_, record.pathOffset, record.pathCount);
+        core::snapshot::appendPath(positions, waypoints_, record.waypointOffset, record.waypointCount);
+    }
+
+    bool HarvesterAI::restore(const core::snapshot::AiRecord& record, std::span<const core::snapshot::PositionRecord> positions) {
+        if (record.commandType > static_cast<std::uint8_t>(HarvesterCommand::Type::Move)) {
+            return false;
+        }
+
+        const types::Position stateTarget = core::snapshot::toPosition(record.stateTarget);
+        switch (static_cast<HarvesterStateKind>(record.state)) {
+        case HarvesterStateKind::Idle:            changeState<IdleState>(); break;
+        case HarvesterStateKind::Moving:          changeState<MovingState>(stateTarget); break;
+        case HarvesterStateKind::MovingToHarvest: changeState<MovingToHarvestState>(stateTarget); break;
+        case HarvesterStateKind::Harvesting:      changeState<HarvestingState>(); break;
+        case HarvesterStateKind::Returning:       changeState<ReturningState>(); break;
+        default:
+            return false;
+        }
+        std::visit([&](auto& state) { state.restore(record); }, currentState_);
+
+        basePosition_ = core::snapshot::toPosition(record.basePosition);
+        targetPosition_ = core::snapshot::toPosition(record.targetPosition);
+        spiceAmount_ = record.spiceAmount;
+        commandQueue_.addCommand(HarvesterCommand(
+            static_cast<HarvesterCommand::Type>(record.commandType),
+            core::snapshot::toPosition(record.commandPosition),
+            std::chrono::milliseconds(record.commandTime)));
+        return core::snapshot::readPath(positions, record.pathOffset, record.pathCount, path_) &&
+            core::snapshot::readPath(positions, record.waypointOffset, record.waypointCount, waypoints_);
     }
-}
\ No newline at end of file
+}
@@ -1,101 +1,18 @@
 #include "entity/harvester_state.hpp"
+#include "entity/harvester_ai.hpp"
 #include "core/map.hpp"
 #include "utils/utils.hpp"
-#include <queue>
-#include <unordered_set>
-#include <array>
+#include "utils/log.hpp"
 
 namespace dune::entity {
     
-    std::vector<types::Position> HarvesterState::findPath(
-        const types::Position& start,
-        const types::Position& goal,
-        const core::Map& map
-    ) const {
-        // 방향 설정 (상, 하, 좌, 우)
-        const std::array<types::Position, 4> directions = {
-            types::Position{-1, 0}, // 위
-            types::Position{1, 0}, // 아래
-            types::Position{0, -1}, // 왼쪽
-            types::Position{0, 1}  // 오른쪽
-        };
-
-        // 우선순위 큐 및 노드 관리
-        auto cmp = [](const types::Node& a, const types::Node& b) {
-            return a.fCost() > b.fCost();
-            };
-        std::priority_queue<types::Node, std::vector<types::Node>, decltype(cmp)> openList(cmp);
-        std::unordered_map<types::Position, types::Node> closedList;
-
-        // 시작 노드 초기화
-        openList.push({ start, 0, utils::manhattanDistance(start, goal), { -1, -1 } });
-
-        while (!openList.empty()) {
-            // 최상위 노드 가져오기
-            types::Node currentNode = openList.top();
-            openList.pop();
-
-            // 목표 지점에 도달하면 경로 재구성
-            if (currentNode.position == goal) {
-                std::vector<types::Position> path;
-                types::Position currentPos = goal;
-                while (currentPos != start) {
-                    path.push_back(currentPos);
-                    currentPos = closedList[currentPos].parent; // 부모 노드로 이동
-                }
-                std::reverse(path.begin(), path.end());
-                return path; // 완성된 경로 반환
-            }
-
-            // 현재 노드를 닫힌 리스트에 추가
-            closedList[currentNode.position] = currentNode;
-
-            // 이웃 노드 탐색
-            for (const auto& dir : directions) {
-                types::Position neighborPos = currentNode.position + dir;
-
-                // 맵 경계 확인
-                if (!neighborPos.is_valid() ||
-                    neighborPos.row >= map.getHeight() ||
-                    neighborPos.column >= map.getWidth()) {
-                    continue;
-                }
-
-                // 장애물 확인
-                const auto& terrain = map.getTerrainManager().getTerrain(neighborPos);
-                if (terrain.getType() == types::TerrainType::Rock ||
-                    map.getEntityAt<dune::entity::Building>(neighborPos) ||
-                    map.getEntityAt<dune::entity::Unit>(neighborPos)) {
-                    continue; // 장애물이 있는 경우 무시
-                }
-
-                // 비용 계산
-                int newGCost = currentNode.gCost + 1; // 기본 이동 비용
-                int hCost = utils::manhattanDistance(neighborPos, goal);
-
-                // 이미 닫힌 리스트에 있는 노드는 무시
-                if (closedList.find(neighborPos) != closedList.end() &&
-                    closedList[neighborPos].gCost <= newGCost) {
-                    continue;
-                }
-
-                // 우선순위 큐에 추가
-                openList.push({ neighborPos, newGCost, hCost, currentNode.position });
-            }
-        }
-
-        // 경로를 찾지 못한 경우
-        return {};
-    }
-
     bool HarvesterState::isValidPosition(
         const types::Position& pos,
         const core::Map& map
     ) const {
         if (!pos.is_valid()) return false;
 
-        const auto& terrain = map.getTerrainManager().getTerrain(pos);
-        return terrain.isWalkable() && !map.getEntityAt<Building>(pos);
+        return !map.getOccupancy().isBlocked(pos, core::OccupancyGrid::STATIC_LAYERS);
     }
 
     // 대기중인 상태.
@@ -110,74 +27,128 @@ namespace dune::entity {
         // 대기 상태에서는 특별한 동작 없음
     }
 
+    std::chrono::milliseconds IdleState::getNextUpdateTime(
+        const Unit* harvester,
+        std::chrono::milliseconds currentTime
+    ) const {
+        // 새 명령(giveMoveCommand/giveHarvestCommand)이 유닛을 깨울 때까지 기다립니다.
+        return std::chrono::milliseconds::max();
+    }
+
     // 이동 중인 상태 클래스 부분
     MovingState::MovingState(HarvesterAI* ai, const types::Position& target)
         : ai_(ai), targetPosition_(target) {};
 
+    void MovingState::plan(
+        const Unit* harvester,
+        const core::Map& map,
+        core::PlanContext& context,
+        std::chrono::milliseconds currentTime
+    ) {
+        auto& path = ai_->getPath();
+        if (path.empty()) {
+            map.planCachedPath(context, harvester, targetPosition_, path);
+        }
+    }
+
     void
     MovingState::update(
         Unit* harvester,
         core::Map& map,
         std::chrono::milliseconds currentTime
     ) {
-        map.addSystemMessage(L"[DEBUG] MovingToHarvestState::update");
-        if (currentPath_.empty()) {
-            currentPath_ = findPath(harvester->getPosition(), targetPosition_, map);
-            if (currentPath_.empty()) {
-                map.addSystemMessage(L"[DEBUG] Unable to find path to spice field");
-                ai_->changeState(std::make_unique<IdleState>(ai_));
-                return;
-            }
+        auto& path = ai_->getPath();
+        utils::log<utils::LogLevel::Debug>([] { return std::wstring(L"MovingState::update"); });
+        // 경로는 plan()에서 준비하므로 비어 있으면 갈 수 없는 곳입니다.
+        if (path.empty()) {
+            utils::log<utils::LogLevel::Warning>([] { return std::wstring(L"Harvester move target is unreachable"); });
+            ai_->changeState<IdleState>();
+            return;
         }
 
         if (harvester->isReadyToMove(currentTime)) {
-            types::Position nextPos = currentPath_.back();
-            currentPath_.pop_back();
-            harvester->moveTo(nextPos);
+            types::Position nextPos = path.back();
+            if (!map.moveUnit(harvester, nextPos)) {
+                // 다른 유닛이 경로를 막고 있으면 다음 틱에 경로를 다시 계산합니다.
+                path.clear();
+                return;
+            }
+            path.pop_back();
             harvester->updateLastMoveTime(currentTime);
-            map.addSystemMessage(L"[DEBUG] Moving to next position: " +
-                std::to_wstring(nextPos.row) + L"," + std::to_wstring(nextPos.column));
+            utils::log<utils::LogLevel::Debug>([&] {
+                return L"Moving to next position: " +
+                    std::to_wstring(nextPos.row) + L"," + std::to_wstring(nextPos.column);
+            });
 
-            if (currentPath_.empty()) {
+            if (path.empty()) {
                 // 목적지 도달
-                map.addSystemMessage(L"[DEBUG] Reached spice field, changing to HarvestingState");
-                ai_->changeState(std::make_unique<IdleState>(ai_));
+                utils::log<utils::LogLevel::Debug>([] { return std::wstring(L"Reached move target, changing to IdleState"); });
+                ai_->changeState<IdleState>();
             }
         }
     }
 
+    std::chrono::milliseconds MovingState::getNextUpdateTime(
+        const Unit* harvester,
+        std::chrono::milliseconds currentTime
+    ) const {
+        return harvester->getNextMoveTime();
+    }
+
     // 수확 위치로 이동하는 상태 클래스
     MovingToHarvestState::MovingToHarvestState(HarvesterAI* ai, const types::Position& spicePos)
         : ai_(ai), spicePosition_(spicePos) {}
 
+    void MovingToHarvestState::plan(
+        const Unit* harvester,
+        const core::Map& map,
+        core::PlanContext& context,
+        std::chrono::milliseconds currentTime
+    ) {
+        auto& path = ai_->getPath();
+        if (path.empty()) {
+            map.planCachedPath(context, harvester, spicePosition_, path);
+        }
+    }
+
     void 
     MovingToHarvestState::update(
         Unit* harvester,
         core::Map& map,
         std::chrono::milliseconds currentTime
     ) {
-        if (currentPath_.empty()) {
-            currentPath_ = findPath(harvester->getPosition(), spicePosition_, map);
-            if (currentPath_.empty()) {
-                map.addSystemMessage(L"Unable to find path to spice field.");
-                ai_->changeState(std::make_unique<IdleState>(ai_));
-                return;
-            }
+        auto& path = ai_->getPath();
+        // 경로는 plan()에서 준비하므로 비어 있으면 갈 수 없는 곳입니다.
+        if (path.empty()) {
+            map.addSystemMessage(L"Unable to find path to spice field.");
+            ai_->changeState<IdleState>();
+            return;
         }
 
         if (harvester->isReadyToMove(currentTime)) {
-            types::Position nextPos = currentPath_.back();
-            currentPath_.pop_back();
-            harvester->moveTo(nextPos);
+            types::Position nextPos = path.back();
+            if (!map.moveUnit(harvester, nextPos)) {
+                // 다른 유닛이 경로를 막고 있으면 다음 틱에 경로를 다시 계산합니다.
+                path.clear();
+                return;
+            }
+            path.pop_back();
             harvester->updateLastMoveTime(currentTime);
 
-            if (currentPath_.empty()) {
+            if (path.empty()) {
                 // 스파이스 위치 도달
-                ai_->changeState(std::make_unique<HarvestingState>(ai_));
+                ai_->changeState<HarvestingState>();
             }
         }
     }
 
+    std::chrono::milliseconds MovingToHarvestState::getNextUpdateTime(
+        const Unit* harvester,
+        std::chrono::milliseconds currentTime
+    ) const {
+        return harvester->getNextMoveTime();
+    }
+
     // 수확 중인 상태 클래스
     HarvestingState::HarvestingState(HarvesterAI* ai)
         : ai_(ai), harvestStartTime_(std::chrono::milliseconds(0)) {}
@@ -194,56 +165,88 @@ namespace dune::entity {
 
         if (currentTime - harvestStartTime_ >= HARVEST_TIME) {
             // 수확량 결정 (2~4)
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dis(MIN_HARVEST, MAX_HARVEST);
-            int amount = dis(gen);
+            int amount = map.getRandom(utils::RandomStream::HarvestYield).nextInt(MIN_HARVEST, MAX_HARVEST);
 
             ai_->setSpiceAmount(amount);
             map.addSystemMessage(L"Collected " + std::to_wstring(amount) + L" spice.");
 
             // 본진으로 돌아가기
-            ai_->changeState(std::make_unique<ReturningState>(ai_));
+            ai_->changeState<ReturningState>();
         }
     }
 
+    std::chrono::milliseconds HarvestingState::getNextUpdateTime(
+        const Unit* harvester,
+        std::chrono::milliseconds currentTime
+    ) const {
+        return harvestStartTime_ + HARVEST_TIME;
+    }
+
     // 본진으로 돌아가는 상태 클래스.
     ReturningState::ReturningState(HarvesterAI* ai) : ai_(ai) {};
 
+    void ReturningState::plan(
+        const Unit* harvester,
+        const core::Map& map,
+        core::PlanContext& context,
+        std::chrono::milliseconds currentTime
+    ) {
+        auto& path = ai_->getPath();
+        if (path.empty()) {
+            map.planHierarchicalPath(context, harvester, ai_->getBasePosition(), ai_->getWaypoints(), path);
+        }
+    }
+
     void ReturningState::update(
         Unit* harvester,
         core::Map& map,
         std::chrono::milliseconds currentTime
     ) {
-        if (currentPath_.empty()) {
-            currentPath_ = findPath(harvester->getPosition(),
-                ai_->getBasePosition(), map);
-            if (currentPath_.empty()) {
+        auto& path = ai_->getPath();
+        auto& waypoints = ai_->getWaypoints();
+        // 새 경유지 목록이 필요하면 plan()이 넘겨 두었으므로 여기서 구합니다.
+        if (path.empty()) {
+            map.findHierarchicalPath(harvester, ai_->getBasePosition(), waypoints, path);
+            if (path.empty()) {
                 map.addSystemMessage(L"Unable to find path back to base.");
-                ai_->changeState(std::make_unique<IdleState>(ai_));
+                ai_->changeState<IdleState>();
                 return;
             }
         }
 
         if (harvester->isReadyToMove(currentTime)) {
-            types::Position nextPos = currentPath_.back();
-            currentPath_.pop_back();
-            harvester->moveTo(nextPos);
+            types::Position nextPos = path.back();
+            if (!map.moveUnit(harvester, nextPos)) {
+                // 다른 유닛이 경로를 막고 있으면 다음 틱에 경로를 다시 계산합니다.
+                path.clear();
+                waypoints.clear();
+                return;
+            }
+            path.pop_back();
             harvester->updateLastMoveTime(currentTime);
 
-            if (currentPath_.empty()) {
-                // 본진 도착 - 시스템 메시지만 전송
-                int spiceAmount = ai_->getSpiceAmount();
-                map.addSystemMessage(L"Harvester returned with " +
-                    std::to_wstring(spiceAmount) +
-                    L" spice.");
+            if (path.empty() && waypoints.empty()) {
+                // 본진 도착 - 배달 사건을 발행하고 자원 정산은 구독자에게 맡깁니다.
+                core::GameEvent delivered{ core::GameEventType::SpiceDelivered };
+                delivered.camp = harvester->getCamp();
+                delivered.unitType = harvester->getType();
+                delivered.position = harvester->getPosition();
+                delivered.amount = ai_->getSpiceAmount();
+                map.getEvents().publish(delivered);
 
                 // 스파이스 양을 0으로 리셋
                 ai_->setSpiceAmount(0);
 
                 // 대기 상태로 전환
-                ai_->changeState(std::make_unique<IdleState>(ai_));
+                ai_->changeState<IdleState>();
             }
         }
     }
-}
\ No newline at end of file
+
+    std::chrono::milliseconds ReturningState::getNextUpdateTime(
+        const Unit* harvester,
+        std::chrono::milliseconds currentTime
+    ) const {
+        return harvester->getNextMoveTime();
+    }
+}
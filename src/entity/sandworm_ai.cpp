@@ -2,24 +2,53 @@
 #include "entity/sandworm_state.hpp"
 #include "entity/unit.hpp"
 #include "core/map.hpp"
+#include "core/profiler.hpp"
 
 namespace dune::entity {
     SandwormAI::SandwormAI()
-        : currentState_(std::make_unique<HuntingState>(this)) {}
+        : currentState_(std::in_place_type<HuntingState>, this) {}
 
     SandwormAI::~SandwormAI() = default;
 
+    void SandwormAI::traceStateChange(SandwormStateKind next) const {
+        // AI는 자기 유닛을 모르므로 유닛 번호는 남기지 않습니다.
+        core::TraceRecorder::instance().recordStateChange(core::Profiler::unitZone(types::UnitType::Sandworm, getStateKind()),
+            core::Profiler::unitZone(types::UnitType::Sandworm, next), -1);
+    }
+
     void SandwormAI::update(Unit* sandworm, core::Map& map, std::chrono::milliseconds currentTime) {
-        if (currentState_) {
-            currentState_->update(sandworm, map, currentTime);
-        }
+        std::visit([&](auto& state) { state.update(sandworm, map, currentTime); }, currentState_);
+    }
+
+    void SandwormAI::plan(
+        const Unit* sandworm,
+        const core::Map& map,
+        core::PlanContext& context,
+        std::chrono::milliseconds currentTime
+    ) {
+        std::visit([&](auto& state) { state.plan(sandworm, map, context, currentTime); }, currentState_);
+    }
+
+    std::chrono::milliseconds SandwormAI::getNextUpdateTime(const Unit* sandworm, std::chrono::milliseconds currentTime) const {
+        return std::visit([&](const auto& state) { return state.getNextUpdateTime(sandworm, currentTime); }, currentState_);
     }
 
-    std::wstring SandwormAI::getCurrentState() const {
-        return currentState_ ? currentState_->getStateName() : L"Unknown";
+    void SandwormAI::save(core::snapshot::AiRecord& record, std::vector<core::snapshot::PositionRecord>& positions) const {
+        record.kind = core::snapshot::AiKind::Sandworm;
+        record.state = static_cast<std::uint8_t>(getStateKind());
+        std::visit([&](const auto& state) { state.save(record); }, currentState_);
+        core::snapshot::appendPath(positions, path_, record.pathOffset, record.pathCount);
     }
 
-    void SandwormAI::changeState(std::unique_ptr<SandwormState> newState) {
-        currentState_ = std::move(newState);
+    bool SandwormAI::restore(const core::snapshot::AiRecord& record, std::span<const core::snapshot::PositionRecord> positions) {
+        switch (static_cast<SandwormStateKind>(record.state)) {
+        case SandwormStateKind::Hunting:   changeState<HuntingState>(); break;
+        case SandwormStateKind::Digesting: changeState<DigestingState>(); break;
+        case SandwormStateKind::Burrowing: changeState<BurrowingState>(); break;
+        default:
+            return false;
+        }
+        std::visit([&](auto& state) { state.restore(record); }, currentState_);
+        return core::snapshot::readPath(positions, record.pathOffset, record.pathCount, path_);
     }
 }
@@ -3,10 +3,7 @@
 #include "core/map.hpp"
 #include "utils/utils.hpp"
 #include "utils/types.hpp"
-#include "core/map.hpp"
-#include <queue>
-#include <unordered_set>
-#include <array>
+#include <algorithm>
 
 namespace dune::entity {
     bool SandwormState::isValidTarget(const Unit* target) const {
@@ -16,101 +13,13 @@ namespace dune::entity {
             targetType != types::UnitType::HeavyTank;
     }
 
-    void SandwormState::changeState(SandwormAI* ai, std::unique_ptr<SandwormState> newState) {
-        if (ai) {
-            ai->changeState(std::move(newState));
-        }
-    }
-
-    std::vector<types::Position> SandwormState::findPath(
-        const types::Position& start,
-        const types::Position& goal,
-        const dune::core::Map& map
-    ) const {
-        // 방향 설정 (상, 하, 좌, 우)
-        const std::array<types::Position, 4> directions = {
-            types::Position{-1, 0}, // 위
-            types::Position{1, 0}, // 아래
-            types::Position{0, -1}, // 왼쪽
-            types::Position{0, 1}  // 오른쪽
-        };
-
-        // 우선순위 큐 및 노드 관리
-        auto cmp = [](const types::Node& a, const types::Node& b) {
-            return a.fCost() > b.fCost();
-            };
-        std::priority_queue<types::Node, std::vector<types::Node>, decltype(cmp)> openList(cmp);
-        std::unordered_map<types::Position, types::Node> closedList;
-
-        // 시작 노드 초기화
-        openList.push({ start, 0, utils::manhattanDistance(start, goal), { -1, -1 } });
-
-        while (!openList.empty()) {
-            // 최상위 노드 가져오기
-            types::Node currentNode = openList.top();
-            openList.pop();
-
-            // 목표 지점에 도달하면 경로 재구성
-            if (currentNode.position == goal) {
-                std::vector<types::Position> path;
-                types::Position currentPos = goal;
-                while (currentPos != start) {
-                    path.push_back(currentPos);
-                    currentPos = closedList[currentPos].parent; // 부모 노드로 이동
-                }
-                std::reverse(path.begin(), path.end());
-                return path; // 완성된 경로 반환
-            }
-
-            // 현재 노드를 닫힌 리스트에 추가
-            closedList[currentNode.position] = currentNode;
-
-            // 이웃 노드 탐색
-            for (const auto& dir : directions) {
-                types::Position neighborPos = currentNode.position + dir;
-
-                // 맵 경계 확인
-                if (!neighborPos.is_valid() ||
-                    neighborPos.row >= map.getHeight() ||
-                    neighborPos.column >= map.getWidth()) {
-                    continue;
-                }
-
-                // 장애물 확인
-                const auto& terrain = map.getTerrainManager().getTerrain(neighborPos);
-                if (terrain.getType() == types::TerrainType::Rock ||
-                    map.getEntityAt<dune::entity::Building>(neighborPos) ||
-                    map.getEntityAt<dune::entity::Unit>(neighborPos)) {
-                    continue; // 장애물이 있는 경우 무시
-                }
-
-                // 비용 계산
-                int newGCost = currentNode.gCost + 1; // 기본 이동 비용
-                int hCost = utils::manhattanDistance(neighborPos, goal);
-
-                // 이미 닫힌 리스트에 있는 노드는 무시
-                if (closedList.find(neighborPos) != closedList.end() &&
-                    closedList[neighborPos].gCost <= newGCost) {
-                    continue;
-                }
-
-                // 우선순위 큐에 추가
-                openList.push({ neighborPos, newGCost, hCost, currentNode.position });
-            }
-        }
-
-        // 경로를 찾지 못한 경우
-        return {};
-    }
-
-
-
-    types::Position SandwormState::findNearestPrey(const Unit* sandworm, const dune::core::Map& map) const {
+    types::Position SandwormState::findNearestPrey(const Unit* sandworm, const dune::core::Map& map,
+        std::vector<const Unit*>& nearbyUnits) const {
         types::Position nearestPos = sandworm->getPosition();
         int minDistance = std::numeric_limits<int>::max();
 
-        std::vector<const Unit*> nearbyUnits;
-        map.getUnitManager().getQuadTree().queryRange(
+        nearbyUnits.clear();
+        map.getUnitManager().getSpatialIndex().queryRange(
             sandworm->getPosition().column - 10,
             sandworm->getPosition().row - 10,
             20, 20,
@@ -135,7 +44,7 @@ namespace dune::entity {
     }
 
     types::Position SandwormState::findSuitableExcretionSpot(
-        const types::Position& currentPos, const dune::core::Map& map
+        const types::Position& currentPos, dune::core::Map& map
     ) const {
         std::vector<types::Position> candidates;
 
@@ -148,10 +57,8 @@ namespace dune::entity {
 
                 if (!pos.is_valid()) continue;
 
-                const auto& terrain = map.getTerrainManager().getTerrain(pos);
-                if (terrain.getType() == types::TerrainType::Desert &&
-                    !map.getEntityAt<Unit>(pos) &&
-                    !map.getEntityAt<Building>(pos)) {
+                if (map.getTerrainManager().getType(pos) == types::TerrainType::Desert &&
+                    !map.getOccupancy().isBlocked(pos)) {
                     candidates.push_back(pos);
                 }
             }
@@ -161,52 +68,78 @@ namespace dune::entity {
             return currentPos;
         }
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, candidates.size() - 1);
-        return candidates[dis(gen)];
+        auto& random = map.getRandom(utils::RandomStream::Excretion);
+        return candidates[random.nextInt(0, static_cast<int>(candidates.size()) - 1)];
     }
 
-    void HuntingState::update(Unit* sandworm, dune::core::Map& map, std::chrono::milliseconds currentTime) {
+    void HuntingState::plan(
+        const Unit* sandworm,
+        const dune::core::Map& map,
+        core::PlanContext& context,
+        std::chrono::milliseconds currentTime
+    ) {
+        auto& path = ai_->getPath();
         if (!sandworm->isReadyToMove(currentTime)) return;
 
-        if (currentPath_.empty() || currentTime - lastPathUpdate_ >= PATH_UPDATE_INTERVAL) {
-            types::Position targetPos = findNearestPrey(sandworm, map);
+        if (path.empty() || currentTime - lastPathUpdate_ >= PATH_UPDATE_INTERVAL) {
+            types::Position targetPos = findNearestPrey(sandworm, map, context.nearbyUnits);
+            lastPathUpdate_ = currentTime;
 
             if (targetPos != sandworm->getPosition()) {
-                currentPath_ = findPath(sandworm->getPosition(), targetPos, map);
-                lastPathUpdate_ = currentTime;
+                map.planPath(context, sandworm->getPosition(), targetPos, path);
             }
         }
+    }
+
+    void HuntingState::update(Unit* sandworm, dune::core::Map& map, std::chrono::milliseconds currentTime) {
+        auto& path = ai_->getPath();
+        if (!sandworm->isReadyToMove(currentTime)) return;
 
-        // 경로를 따라 이동
-        if (!currentPath_.empty()) {
-            types::Position nextPos = currentPath_.back();
-            currentPath_.pop_back();
+        // 경로를 따라 이동 (먹이 탐색과 경로는 plan()에서 준비합니다)
+        if (!path.empty()) {
+            types::Position nextPos = path.back();
+            path.pop_back();
 
             if (isValidMovePosition(nextPos, map)) {
                 if (Unit* prey = map.getEntityAt<Unit>(nextPos)) {
                     if (isValidTarget(prey)) {
                         sandworm->consumeTarget();
-                        map.addSystemMessage(L"Sandworm successfully caught its prey!");
+                        core::GameEvent killed{ core::GameEventType::UnitKilled };
+                        killed.camp = prey->getCamp();
+                        killed.unitType = prey->getType();
+                        killed.sourceType = types::UnitType::Sandworm;
+                        killed.position = nextPos;
+                        map.getEvents().publish(killed);
                         map.removeUnit(prey);
-                        sandworm->getSandwormAI()->changeState(std::make_unique<DigestingState>(sandworm->getSandwormAI()));
+                        ai_->changeState<DigestingState>();
                         return;
                     }
                 }
 
-                sandworm->moveTo(nextPos);
-                sandworm->updateLastMoveTime(currentTime);
+                if (map.moveUnit(sandworm, nextPos)) {
+                    sandworm->updateLastMoveTime(currentTime);
+                }
+                else {
+                    // 다른 유닛이 경로를 막고 있으면 경로를 다시 계산합니다.
+                    path.clear();
+                }
             }
         }
     }
 
+    std::chrono::milliseconds HuntingState::getNextUpdateTime(const Unit* sandworm, std::chrono::milliseconds currentTime) const {
+        // 사냥은 이동 쿨다운이 끝났을 때만 진행됩니다.
+        // 먹이나 경로를 찾지 못했으면 다음 탐색 주기까지 기다립니다. (쿨다운만 보면 지난 시간이라 매 틱 깨어납니다)
+        if (ai_->getPath().empty()) {
+            return std::max(sandworm->getNextMoveTime(), lastPathUpdate_ + PATH_UPDATE_INTERVAL);
+        }
+        return sandworm->getNextMoveTime();
+    }
+
     bool HuntingState::isValidMovePosition(const types::Position& pos, const dune::core::Map & map) const {
         if (!pos.is_valid()) return false;
 
-        const auto& terrain = map.getTerrainManager().getTerrain(pos);
-        return terrain.getType() != types::TerrainType::Rock &&
-            !map.getEntityAt<Building>(pos);
+        return !map.getOccupancy().isBlocked(pos, core::OccupancyGrid::STATIC_LAYERS);
     }
 
     void DigestingState::update(Unit* sandworm, dune::core::Map& map, std::chrono::milliseconds currentTime) {
@@ -218,27 +151,21 @@ namespace dune::entity {
 
         // 소화 완료 체크
         if (currentTime - digestStartTime_ >= DIGESTION_TIME) {
-            if (sandworm->shouldExcrete()) {
+            if (sandworm->shouldExcrete(map.getRandom(utils::RandomStream::Excretion))) {
                 map.addSystemMessage(L"Sandworm is preparing to create spice...");
-                if (auto ai = sandworm->getSandwormAI()) { // AI가 nullptr이 아닌지 확인
-                    ai->changeState(std::make_unique<BurrowingState>(sandworm->getSandwormAI()));
-                }
-                else {
-                    map.addSystemMessage(L"Error: Sandworm AI not initialized.");
-                }
+                ai_->changeState<BurrowingState>();
             }
             else {
                 map.addSystemMessage(L"Sandworm returns to hunting.");
-                if (auto ai = sandworm->getSandwormAI()) {
-                    ai->changeState(std::make_unique<HuntingState>(sandworm->getSandwormAI()));
-                }
-                else {
-                    map.addSystemMessage(L"Error: Sandworm AI not initialized.");
-                }
+                ai_->changeState<HuntingState>();
             }
         }
     }
 
+    std::chrono::milliseconds DigestingState::getNextUpdateTime(const Unit* sandworm, std::chrono::milliseconds currentTime) const {
+        return digestStartTime_ + DIGESTION_TIME;
+    }
+
     void BurrowingState::update(Unit* sandworm, dune::core::Map& map, std::chrono::milliseconds currentTime) {
         // 굴파기 시작 시간 초기화
         if (burrowStartTime_.count() == 0) {
@@ -252,10 +179,17 @@ namespace dune::entity {
             // 스파이스 생성
             sandworm->excrete();
             map.setTerrain(burrowTarget_, types::TerrainType::Spice);
-            map.addSystemMessage(L"Sandworm has created a new spice field!");
+            core::GameEvent created{ core::GameEventType::SpiceCreated };
+            created.unitType = types::UnitType::Sandworm;
+            created.position = burrowTarget_;
+            map.getEvents().publish(created);
 
             // 사냥 상태로 전환
-            sandworm->getSandwormAI()->changeState(std::make_unique<HuntingState>(sandworm->getSandwormAI()));
+            ai_->changeState<HuntingState>();
         }
     }
+
+    std::chrono::milliseconds BurrowingState::getNextUpdateTime(const Unit* sandworm, std::chrono::milliseconds currentTime) const {
+        return burrowStartTime_ + BURROW_TIME;
+    }
 }
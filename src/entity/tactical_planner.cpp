@@ -0,0 +1,521 @@
+#include "entity/tactical_planner.hpp"
+#include "entity/unit.hpp"
+#include "core/jobs.hpp"
+#include "core/map.hpp"
+#include "utils/constants.hpp"
+#include "utils/log.hpp"
+#include "utils/random.hpp"
+#include "utils/utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace dune::entity::combat {
+    namespace {
+        constexpr std::size_t MAX_PLANNED_UNITS = 8;         // 트리 깊이 (적에게 가까운 아군부터)
+        constexpr std::size_t MAX_TARGET_CHOICES = 3;        // 유닛마다 공격 후보로 볼 가까운 적 수
+        constexpr int ROLLOUT_STEP = 100;                    // 롤아웃 한 단계의 게임 시간 (ms)
+        constexpr int RANDOM_TARGET_PERCENT = 10;            // 기본 정책이 시야 안의 아무 적이나 고를 확률
+        constexpr double EXPLORATION = 1.41;                 // UCT 탐험 계수
+        constexpr std::uint32_t BUDGET_CHECK_INTERVAL = 16;  // 시간 예산을 확인하는 롤아웃 간격
+        constexpr std::uint32_t NO_CHILD = std::numeric_limits<std::uint32_t>::max();
+        constexpr std::uint16_t NO_FIGHTER = std::numeric_limits<std::uint16_t>::max();
+
+        enum class ActionKind : std::uint8_t {
+            Keep,     // 지금 하던 일을 계속 (새 명령 없음)
+            Attack,   // target을 공격
+            Retreat   // 본진으로 후퇴
+        };
+
+        struct Action {
+            ActionKind kind = ActionKind::Keep;
+            std::uint16_t target = NO_FIGHTER;  // Attack일 때 적 전투원 번호
+        };
+
+        // 롤아웃에서 움직이는 유닛 하나입니다. 전투에 쓰는 값만 떠 옵니다.
+        struct Fighter {
+            types::Position position;
+            int health;
+            int attackPower;
+            int range;          // 0이면 공격하지 않음 (하베스터)
+            int cooldown;       // 행동 간격 (ms)
+            int sightRange;
+            int ready;          // 다음 행동까지 남은 시간 (ms)
+            bool own;           // 계획기 진영이면 true
+            bool harvester;
+            ActionKind order = ActionKind::Keep;
+            std::uint16_t target = NO_FIGHTER;  // 추적/공격 중인 적 (Keep이면 지금 AI의 타겟)
+        };
+
+        // 계획 한 번 동안 바뀌지 않는 전장 정보입니다. 모든 트리가 읽기만 합니다.
+        struct Battlefield {
+            int width = 0;
+            int height = 0;
+            std::vector<std::uint8_t> blocked;          // 지형/건물로 막힌 타일
+            std::vector<Fighter> fighters;              // 아군이 앞, 적이 뒤
+            std::vector<Unit*> units;                   // fighters와 같은 순서의 실제 유닛
+            std::vector<std::uint16_t> planned;         // 트리 깊이별로 행동을 정할 아군 번호
+            std::vector<std::vector<Action>> actions;   // planned와 같은 순서의 후보 행동 (0번은 Keep)
+            types::Position home{ -1, -1 };             // 후퇴 목표 (없으면 후퇴 후보 없음)
+            int ownHealth = 0;
+            int enemyHealth = 0;
+            int horizon = 0;
+        };
+
+        struct Node {
+            std::uint32_t firstChild = NO_CHILD;  // 자식은 후보 행동 순서대로 연속해 있습니다.
+            std::uint32_t visits = 0;
+            double value = 0.0;
+        };
+
+        struct Tree {
+            std::vector<Node> nodes;
+            std::uint32_t rollouts = 0;
+        };
+
+        bool isEnemyCamp(types::Camp camp, types::Camp own) {
+            return camp != own && camp != types::Camp::Common;
+        }
+
+        bool isInside(const Battlefield& field, const types::Position& position) {
+            return position.row >= 0 && position.row < field.height &&
+                position.column >= 0 && position.column < field.width;
+        }
+
+        std::size_t tileOf(const Battlefield& field, const types::Position& position) {
+            return static_cast<std::size_t>(position.row) * field.width + position.column;
+        }
+
+        // 본진 둘레에서 가장 가까운 빈 타일을 후퇴 목표로 고릅니다.
+        types::Position findHome(const core::Map& map, types::Camp camp) {
+            for (const auto& building : map.getBuildingManager().getBuildings()) {
+                if (building->getKind() != types::BuildingType::Base || building->getType() != camp) {
+                    continue;
+                }
+                const types::Position origin = building->getPosition();
+                for (int radius = 1; radius <= building->getWidth() + building->getHeight(); ++radius) {
+                    for (int row = origin.row - radius; row <= origin.row + building->getHeight() + radius; ++row) {
+                        for (int column = origin.column - radius; column <= origin.column + building->getWidth() + radius; ++column) {
+                            if (!map.getOccupancy().isBlocked({ row, column })) {
+                                return { row, column };
+                            }
+                        }
+                    }
+                }
+            }
+            return { -1, -1 };
+        }
+
+        /**
+         * @brief 맵에서 전투에 필요한 상태만 떠 옵니다.
+         * @return false 지휘할 유닛이나 적이 없는 경우.
+         */
+        bool captureBattlefield(const core::Map& map, types::Camp camp, std::chrono::milliseconds currentTime,
+            Battlefield& field) {
+            const auto& units = map.getUnitManager();
+            const auto& occupancy = map.getOccupancy();
+            field.width = map.getWidth();
+            field.height = map.getHeight();
+            field.blocked.resize(static_cast<std::size_t>(field.width) * field.height);
+            for (std::size_t i = 0; i < field.blocked.size(); ++i) {
+                field.blocked[i] = occupancy.isBlockedAt(i, core::OccupancyGrid::STATIC_LAYERS) ? 1 : 0;
+            }
+
+            // 아군을 먼저, 적을 나중에 칸 순서대로 담습니다.
+            for (const bool own : { true, false }) {
+                for (std::size_t slot = 0; slot < units.getSlotCount(); ++slot) {
+                    if (!units.isSlotActive(slot)) {
+                        continue;
+                    }
+                    Unit* unit = units.getUnitInSlot(slot);
+                    const types::Camp unitCamp = unit->getCamp();
+                    if (own ? unitCamp != camp : !isEnemyCamp(unitCamp, camp)) {
+                        continue;
+                    }
+                    const types::UnitType type = unit->getType();
+                    const bool harvester = type == types::UnitType::Harvester;
+                    if (!harvester && !unit->getCombatUnitAI()) {
+                        continue;
+                    }
+                    Fighter& fighter = field.fighters.emplace_back();
+                    fighter.position = unit->getPosition();
+                    fighter.health = std::max(unit->getHealth(), 0);
+                    fighter.attackPower = unit->getAttackPower();
+                    fighter.range = harvester ? 0 : CombatUnitState::getAttackRange(type);
+                    fighter.cooldown = std::max(unit->getSpeed(), ROLLOUT_STEP);
+                    fighter.sightRange = unit->getSightRange();
+                    fighter.ready = static_cast<int>(std::max<std::int64_t>((unit->getNextMoveTime() - currentTime).count(), 0));
+                    fighter.own = own;
+                    fighter.harvester = harvester;
+                    field.units.push_back(unit);
+                    (own ? field.ownHealth : field.enemyHealth) += fighter.health;
+                }
+            }
+            if (field.fighters.size() > NO_FIGHTER) {
+                return false;
+            }
+
+            // Keep은 지금 AI가 쫓는 타겟을 이어 갑니다.
+            for (std::size_t i = 0; i < field.fighters.size(); ++i) {
+                const CombatUnitAI* ai = field.units[i]->getCombatUnitAI();
+                if (!ai || (ai->getStateKind() != CombatStateKind::Attacking && ai->getStateKind() != CombatStateKind::Pursuing)) {
+                    continue;
+                }
+                const auto it = std::find(field.units.begin(), field.units.end(), ai->getCurrentTarget());
+                if (it != field.units.end()) {
+                    field.fighters[i].target = static_cast<std::uint16_t>(it - field.units.begin());
+                }
+            }
+
+            std::vector<std::uint16_t> own;
+            std::vector<std::uint16_t> enemies;
+            for (std::size_t i = 0; i < field.fighters.size(); ++i) {
+                if (!field.fighters[i].own) {
+                    enemies.push_back(static_cast<std::uint16_t>(i));
+                }
+                else if (field.fighters[i].range > 0) {
+                    own.push_back(static_cast<std::uint16_t>(i));
+                }
+            }
+            if (own.empty() || enemies.empty()) {
+                return false;
+            }
+
+            const auto distanceToEnemy = [&](std::uint16_t index) {
+                int best = std::numeric_limits<int>::max();
+                for (const std::uint16_t enemy : enemies) {
+                    best = std::min(best, utils::manhattanDistance(field.fighters[index].position, field.fighters[enemy].position));
+                }
+                return best;
+            };
+            std::stable_sort(own.begin(), own.end(), [&](std::uint16_t a, std::uint16_t b) {
+                return distanceToEnemy(a) < distanceToEnemy(b);
+            });
+            own.resize(std::min(own.size(), MAX_PLANNED_UNITS));
+
+            field.home = findHome(map, camp);
+            for (const std::uint16_t index : own) {
+                field.planned.push_back(index);
+                auto& candidates = field.actions.emplace_back();
+                candidates.push_back({ ActionKind::Keep, NO_FIGHTER });
+
+                std::vector<std::uint16_t> nearest = enemies;
+                const types::Position from = field.fighters[index].position;
+                std::stable_sort(nearest.begin(), nearest.end(), [&](std::uint16_t a, std::uint16_t b) {
+                    return utils::manhattanDistance(from, field.fighters[a].position) <
+                        utils::manhattanDistance(from, field.fighters[b].position);
+                });
+                for (std::size_t i = 0; i < std::min(nearest.size(), MAX_TARGET_CHOICES); ++i) {
+                    candidates.push_back({ ActionKind::Attack, nearest[i] });
+                }
+                if (field.home.row >= 0) {
+                    candidates.push_back({ ActionKind::Retreat, NO_FIGHTER });
+                }
+            }
+            return true;
+        }
+
+        // 기본 정책: 하던 공격을 잇고, 없으면 게임 AI처럼 시야 안의 하베스터나 가장 가까운 적을 노립니다.
+        std::uint16_t chooseTarget(const std::vector<Fighter>& fighters, const Fighter& fighter, utils::Xoshiro256& random) {
+            if (fighter.order == ActionKind::Retreat) {
+                return NO_FIGHTER;
+            }
+            if (fighter.target != NO_FIGHTER && fighters[fighter.target].health > 0) {
+                return fighter.target;
+            }
+
+            std::uint16_t best = NO_FIGHTER;
+            int bestDistance = std::numeric_limits<int>::max();
+            int sighted = 0;
+            for (std::size_t i = 0; i < fighters.size(); ++i) {
+                const Fighter& other = fighters[i];
+                if (other.own == fighter.own || other.health <= 0 ||
+                    std::abs(other.position.row - fighter.position.row) > fighter.sightRange ||
+                    std::abs(other.position.column - fighter.position.column) > fighter.sightRange) {
+                    continue;
+                }
+                ++sighted;
+                // 가끔 다른 적을 골라 상대가 항상 최선으로 움직이지 않는 경우도 봅니다.
+                if (random.nextInt(1, sighted) == 1 && random.chance(RANDOM_TARGET_PERCENT)) {
+                    return static_cast<std::uint16_t>(i);
+                }
+                if (other.harvester) {
+                    return static_cast<std::uint16_t>(i);
+                }
+                const int distance = utils::manhattanDistance(fighter.position, other.position);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = static_cast<std::uint16_t>(i);
+                }
+            }
+            return best;
+        }
+
+        // 목표에 가까워지는 빈 이웃 타일로 한 칸 움직입니다. 같은 거리면 무작위로 고릅니다.
+        void stepToward(const Battlefield& field, std::vector<std::uint8_t>& occupied, Fighter& fighter,
+            const types::Position& goal, utils::Xoshiro256& random) {
+            static constexpr types::Position OFFSETS[] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+            const int current = utils::manhattanDistance(fighter.position, goal);
+            types::Position next = fighter.position;
+            int ties = 0;
+            for (const auto& offset : OFFSETS) {
+                const types::Position candidate{ fighter.position.row + offset.row, fighter.position.column + offset.column };
+                if (!isInside(field, candidate) || occupied[tileOf(field, candidate)] ||
+                    utils::manhattanDistance(candidate, goal) >= current) {
+                    continue;
+                }
+                if (random.nextInt(0, ties++) == 0) {
+                    next = candidate;
+                }
+            }
+            if (next != fighter.position) {
+                occupied[tileOf(field, fighter.position)] = 0;
+                occupied[tileOf(field, next)] = 1;
+                fighter.position = next;
+            }
+        }
+
+        /**
+         * @brief 정한 행동으로 horizon만큼 교전을 진행하고 아군 입장의 점수를 [0, 1]로 돌려줍니다.
+         * @param choice 트리에서 정한 앞쪽 유닛들의 행동 번호 (나머지는 Keep).
+         */
+        double rollout(const Battlefield& field, std::span<const std::uint8_t> choice, utils::Xoshiro256& random,
+            std::vector<Fighter>& fighters, std::vector<std::uint8_t>& occupied) {
+            fighters = field.fighters;
+            occupied = field.blocked;
+            for (const Fighter& fighter : fighters) {
+                occupied[tileOf(field, fighter.position)] = 1;
+            }
+            for (std::size_t depth = 0; depth < choice.size(); ++depth) {
+                const Action& action = field.actions[depth][choice[depth]];
+                Fighter& fighter = fighters[field.planned[depth]];
+                if (action.kind != ActionKind::Keep) {
+                    fighter.order = action.kind;
+                    fighter.target = action.target;
+                }
+            }
+
+            for (int elapsed = 0; elapsed < field.horizon; elapsed += ROLLOUT_STEP) {
+                int ownAlive = 0;
+                int enemyAlive = 0;
+                for (Fighter& fighter : fighters) {
+                    if (fighter.health <= 0) {
+                        continue;
+                    }
+                    (fighter.own ? ownAlive : enemyAlive) += 1;
+                    if (fighter.range == 0 || (fighter.ready -= ROLLOUT_STEP) > 0) {
+                        continue;
+                    }
+                    fighter.ready = 0;
+
+                    const std::uint16_t target = chooseTarget(fighters, fighter, random);
+                    if (target != NO_FIGHTER) {
+                        fighter.target = target;
+                        Fighter& enemy = fighters[target];
+                        if (utils::manhattanDistance(fighter.position, enemy.position) <= fighter.range) {
+                            enemy.health = CombatUnitState::getHealthAfterAttack(enemy.health, fighter.attackPower);
+                            if (enemy.health <= 0) {
+                                occupied[tileOf(field, enemy.position)] = field.blocked[tileOf(field, enemy.position)];
+                            }
+                        }
+                        else {
+                            stepToward(field, occupied, fighter, enemy.position, random);
+                        }
+                        fighter.ready = fighter.cooldown;
+                    }
+                    else if (fighter.order == ActionKind::Retreat) {
+                        stepToward(field, occupied, fighter, field.home, random);
+                        fighter.ready = fighter.cooldown;
+                    }
+                }
+                if (ownAlive == 0 || enemyAlive == 0) {
+                    break;
+                }
+            }
+
+            int ownLoss = 0;
+            int enemyLoss = 0;
+            for (std::size_t i = 0; i < fighters.size(); ++i) {
+                const int loss = field.fighters[i].health - std::max(fighters[i].health, 0);
+                (fighters[i].own ? ownLoss : enemyLoss) += loss;
+            }
+            const double ownRatio = field.ownHealth > 0 ? static_cast<double>(ownLoss) / field.ownHealth : 0.0;
+            const double enemyRatio = field.enemyHealth > 0 ? static_cast<double>(enemyLoss) / field.enemyHealth : 0.0;
+            return std::clamp(0.5 + 0.5 * (enemyRatio - ownRatio), 0.0, 1.0);
+        }
+
+        // UCT로 자식을 고릅니다. 아직 가 보지 않은 자식이 있으면 그중 하나를 무작위로 고릅니다.
+        std::uint8_t selectChild(const Tree& tree, const Node& node, std::size_t childCount, utils::Xoshiro256& random) {
+            int unvisited = 0;
+            std::uint8_t chosen = 0;
+            for (std::size_t i = 0; i < childCount; ++i) {
+                if (tree.nodes[node.firstChild + i].visits == 0 && random.nextInt(0, unvisited++) == 0) {
+                    chosen = static_cast<std::uint8_t>(i);
+                }
+            }
+            if (unvisited > 0) {
+                return chosen;
+            }
+
+            const double logVisits = std::log(static_cast<double>(node.visits));
+            double best = -1.0;
+            for (std::size_t i = 0; i < childCount; ++i) {
+                const Node& child = tree.nodes[node.firstChild + i];
+                const double score = child.value / child.visits + EXPLORATION * std::sqrt(logVisits / child.visits);
+                if (score > best) {
+                    best = score;
+                    chosen = static_cast<std::uint8_t>(i);
+                }
+            }
+            return chosen;
+        }
+
+        /**
+         * @brief 트리 하나를 rollouts번 키웁니다. 한 번에 한 단계씩 펼치고 나머지 유닛은 Keep으로 둡니다.
+         * @param expired 다른 트리가 시간 예산을 넘긴 것을 알리는 표시 (예산이 없으면 nullptr).
+         */
+        void growTree(const Battlefield& field, Tree& tree, std::uint32_t rollouts, utils::Xoshiro256 random,
+            std::chrono::steady_clock::time_point deadline, std::atomic<bool>* expired) {
+            std::vector<Fighter> fighters;
+            std::vector<std::uint8_t> occupied;
+            std::vector<std::uint8_t> choice;
+            std::vector<std::uint32_t> path;
+            tree.nodes.assign(1, Node{});
+
+            for (std::uint32_t iteration = 0; iteration < rollouts; ++iteration) {
+                // 예산이 아무리 작아도 트리마다 한 묶음은 돌려 빈 트리로 결정하지 않습니다.
+                if (expired && iteration > 0 && iteration % BUDGET_CHECK_INTERVAL == 0) {
+                    if (expired->load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= deadline) {
+                        expired->store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+
+                choice.clear();
+                path.assign(1, 0);
+                std::uint32_t current = 0;
+                while (choice.size() < field.planned.size()) {
+                    const std::size_t childCount = field.actions[choice.size()].size();
+                    const bool expand = tree.nodes[current].firstChild == NO_CHILD;
+                    if (expand) {
+                        tree.nodes[current].firstChild = static_cast<std::uint32_t>(tree.nodes.size());
+                        tree.nodes.resize(tree.nodes.size() + childCount);
+                    }
+                    const std::uint8_t index = selectChild(tree, tree.nodes[current], childCount, random);
+                    choice.push_back(index);
+                    current = tree.nodes[current].firstChild + index;
+                    path.push_back(current);
+                    if (expand) {
+                        break;
+                    }
+                }
+
+                const double value = rollout(field, choice, random, fighters, occupied);
+                for (const std::uint32_t node : path) {
+                    tree.nodes[node].visits += 1;
+                    tree.nodes[node].value += value;
+                }
+                ++tree.rollouts;
+            }
+        }
+    }
+
+    TacticalPlanner::TacticalPlanner(const TacticalPlannerConfig& config)
+        : config_(config) {
+        config_.interval = std::max<std::uint32_t>(config_.interval, 1);
+        config_.trees = std::max<std::uint32_t>(config_.trees, 1);
+    }
+
+    void TacticalPlanner::plan(core::Map& map, core::JobSystem& jobs, std::chrono::milliseconds currentTime) {
+        const auto start = std::chrono::steady_clock::now();
+        Battlefield field;
+        if (!captureBattlefield(map, config_.camp, currentTime, field)) {
+            return;
+        }
+        field.horizon = static_cast<int>(config_.horizon);
+        ++stats_.decisions;
+
+        // 트리마다 같은 시드에서 겹치지 않는 하위 수열을 씁니다. 시드는 경기 시드와 틱으로만 정해집니다.
+        const std::uint64_t tick = static_cast<std::uint64_t>(currentTime.count() / constants::TICK);
+        utils::Xoshiro256 base(map.getSeed() ^ (tick * 0x9E3779B97F4A7C15ull));
+        std::vector<utils::Xoshiro256> randoms;
+        for (std::uint32_t i = 0; i < config_.trees; ++i) {
+            randoms.push_back(base);
+            base.jump();
+        }
+
+        std::vector<Tree> trees(config_.trees);
+        std::atomic<bool> expired{ false };
+        std::atomic<bool>* budget = config_.deterministic ? nullptr : &expired;
+        const auto deadline = start + config_.timeBudget;
+        jobs.parallelFor(trees.size(), 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::uint32_t share = config_.rollouts / config_.trees + (i < config_.rollouts % config_.trees ? 1 : 0);
+                growTree(field, trees[i], share, randoms[i], deadline, budget);
+            }
+        });
+        if (expired.load()) {
+            ++stats_.budgetStops;
+        }
+
+        // 깊이마다 모든 트리의 방문 수를 합쳐 가장 많이 가 본 행동을 고르고, 그 자식으로 내려갑니다.
+        std::vector<std::uint32_t> cursor(trees.size(), 0);
+        std::vector<std::uint64_t> visits;
+        for (std::size_t depth = 0; depth < field.planned.size(); ++depth) {
+            const auto& candidates = field.actions[depth];
+            visits.assign(candidates.size(), 0);
+            for (std::size_t t = 0; t < trees.size(); ++t) {
+                stats_.rollouts += depth == 0 ? trees[t].rollouts : 0;
+                if (cursor[t] == NO_CHILD || trees[t].nodes.empty() || trees[t].nodes[cursor[t]].firstChild == NO_CHILD) {
+                    cursor[t] = NO_CHILD;
+                    continue;
+                }
+                for (std::size_t i = 0; i < candidates.size(); ++i) {
+                    visits[i] += trees[t].nodes[trees[t].nodes[cursor[t]].firstChild + i].visits;
+                }
+            }
+            const std::size_t best = static_cast<std::size_t>(std::max_element(visits.begin(), visits.end()) - visits.begin());
+            for (std::size_t t = 0; t < trees.size(); ++t) {
+                if (cursor[t] != NO_CHILD) {
+                    cursor[t] = trees[t].nodes[cursor[t]].firstChild + static_cast<std::uint32_t>(best);
+                }
+            }
+
+            // 이미 같은 일을 하고 있으면 명령을 다시 내리지 않아 상태(경로, 공격 쿨다운)를 잃지 않습니다.
+            const Action& action = candidates[best];
+            Unit* unit = field.units[field.planned[depth]];
+            CombatUnitAI* ai = unit->getCombatUnitAI();
+            const CombatStateKind state = ai->getStateKind();
+            if (action.kind == ActionKind::Attack) {
+                Unit* target = field.units[action.target];
+                if (ai->getCurrentTarget() == target &&
+                    (state == CombatStateKind::Attacking || state == CombatStateKind::Pursuing)) {
+                    continue;
+                }
+                map.touchUnit(unit);
+                ai->attackCommand(target);
+            }
+            else if (action.kind == ActionKind::Retreat) {
+                if (state == CombatStateKind::Moving && ai->getMoveTarget() == field.home) {
+                    continue;
+                }
+                map.orderMove(unit, field.home);
+            }
+            else {
+                continue;
+            }
+            map.wakeUnit(unit);
+            ++stats_.commands;
+        }
+
+        utils::log<utils::LogLevel::Debug>([&] {
+            return L"Tactical planner: " + std::to_wstring(field.planned.size()) + L" units, " +
+                std::to_wstring(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()) + L" us";
+        });
+    }
+}
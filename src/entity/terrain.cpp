@@ -53,7 +53,19 @@ namespace dune {
         }
 
         bool Terrain::isBuildable() const {
-            switch (type_) {
+            return isBuildableTerrain(type_);
+        }
+
+        bool Terrain::isWalkable() const {
+            return isWalkableTerrain(type_);
+        }
+
+        bool Terrain::canHarvestSpice() const {
+            return isHarvestableTerrain(type_);
+        }
+
+        bool isBuildableTerrain(types::TerrainType type) {
+            switch (type) {
             case types::TerrainType::Desert: return true;
             case types::TerrainType::Plate:  return true;
             case types::TerrainType::Rock:   return false;
@@ -63,8 +75,8 @@ namespace dune {
             }
         }
 
-        bool Terrain::isWalkable() const {
-            switch (type_) {
+        bool isWalkableTerrain(types::TerrainType type) {
+            switch (type) {
             case types::TerrainType::Desert: return true;
             case types::TerrainType::Plate:  return true;
             case types::TerrainType::Rock:   return false;
@@ -74,8 +86,8 @@ namespace dune {
             }
         }
 
-        bool Terrain::canHarvestSpice() const {
-            return type_ == types::TerrainType::Spice;
+        bool isHarvestableTerrain(types::TerrainType type) {
+            return type == types::TerrainType::Spice;
         }
 
     } // namespace managers
@@ -13,7 +13,7 @@ namespace dune {
             types::UnitType type, int buildCost, int population, types::Position pos, int health, 
             int speed, int attackPower, int sightRange, types::Camp camp
         ) : type_(type), buildCost_(buildCost), population_(population), position_(pos), health_(health), 
-            speed_(speed), attackPower_(attackPower), sightRange_(sightRange), camp_(camp), harvester_ai_(nullptr) 
+            speed_(speed), attackPower_(attackPower), sightRange_(sightRange), camp_(camp) 
         {}
 
 
@@ -30,7 +30,7 @@ namespace dune {
                 length_ = 1;
                 camp_ = types::Camp::Common;
 
-                sandworm_ai_ = std::make_unique<SandwormAI>();
+                ai_.emplace<SandwormAI>();
                 break;
             default:
                 buildCost_ = 5;
@@ -44,6 +44,24 @@ namespace dune {
             }
         }
 
+        Unit::Unit(const core::snapshot::UnitRecord& record) {
+            restoreStats(record);
+        }
+
+        void Unit::restoreStats(const core::snapshot::UnitRecord& record) {
+            camp_ = static_cast<types::Camp>(record.camp);
+            type_ = static_cast<types::UnitType>(record.type);
+            buildCost_ = record.buildCost;
+            population_ = record.population;
+            speed_ = record.speed;
+            attackPower_ = record.attackPower;
+            health_ = record.health;
+            sightRange_ = record.sightRange;
+            position_ = core::snapshot::toPosition(record.position);
+            length_ = record.length;
+            lastMoveTime_ = std::chrono::milliseconds(record.lastMoveTime);
+        }
+
         wchar_t Unit::getRepresentation() const {
             switch (type_) {
             case types::UnitType::Harvester:  return L'H';
@@ -119,8 +137,64 @@ namespace dune {
             }
         }
 
-        bool Unit::shouldExcrete() const {
-            return length_ > 1 && (rand() % 100 < 30);
+        bool Unit::shouldExcrete(utils::Xoshiro256& random) const {
+            return length_ > 1 && random.chance(30);
+        }
+
+        void Unit::save(
+            core::snapshot::UnitRecord& record,
+            std::vector<core::snapshot::PositionRecord>& positions,
+            const core::snapshot::UnitIds& ids
+        ) const {
+            record.id = id_;
+            record.type = static_cast<std::uint8_t>(type_);
+            record.camp = static_cast<std::uint8_t>(camp_);
+            record.buildCost = buildCost_;
+            record.population = population_;
+            record.speed = speed_;
+            record.attackPower = attackPower_;
+            record.health = health_;
+            record.sightRange = sightRange_;
+            record.length = length_;
+            record.position = core::snapshot::toRecord(position_);
+            record.lastMoveTime = lastMoveTime_.count();
+
+            record.ai = {};
+            if (const auto* ai = std::get_if<SandwormAI>(&ai_)) {
+                ai->save(record.ai, positions);
+            }
+            else if (const auto* ai = std::get_if<HarvesterAI>(&ai_)) {
+                ai->save(record.ai, positions);
+            }
+            else if (const auto* ai = std::get_if<combat::CombatUnitAI>(&ai_)) {
+                ai->save(record.ai, positions, ids);
+            }
+        }
+
+        bool Unit::restoreAI(
+            const core::snapshot::AiRecord& record,
+            std::span<const core::snapshot::PositionRecord> positions,
+            const managers::UnitManager& units
+        ) {
+            using core::snapshot::AiKind;
+            switch (record.kind) {
+            case AiKind::None:
+                ai_.emplace<std::monostate>();
+                return true;
+            case AiKind::Sandworm:
+                if (type_ != types::UnitType::Sandworm) return false;
+                return ai_.emplace<SandwormAI>().restore(record, positions);
+            case AiKind::Harvester:
+                if (type_ != types::UnitType::Harvester) return false;
+                return ai_.emplace<HarvesterAI>(position_).restore(record, positions);
+            case AiKind::Combat:
+                if (type_ != types::UnitType::Soldier && type_ != types::UnitType::Fremen &&
+                    type_ != types::UnitType::Fighter && type_ != types::UnitType::HeavyTank) {
+                    return false;
+                }
+                return ai_.emplace<combat::CombatUnitAI>(this).restore(record, positions, units);
+            }
+            return false;
         }
     } // namespace entity
 } // namespace dune
@@ -2,56 +2,162 @@
 #include "managers/terrain_manager.hpp"
 #include "utils/constants.hpp"
 #include "utils/utils.hpp"
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 namespace dune {
     namespace managers {
         // BuildingManager 클래스 구현
 
+        namespace {
+            bool overlaps(const entity::Building& a, const entity::Building& b) {
+                types::Position pa = a.getPosition();
+                types::Position pb = b.getPosition();
+                return pa.row < pb.row + b.getHeight() && pb.row < pa.row + a.getHeight() &&
+                    pa.column < pb.column + b.getWidth() && pb.column < pa.column + a.getWidth();
+            }
+        }
+
+        BuildingManager::BuildingManager(int width, int height)
+            : width_(width)
+            , height_(height)
+            , tileIds_(static_cast<size_t>(width) * height, NO_BUILDING) {}
+
         void BuildingManager::addBuilding(std::unique_ptr<Building> building) {
+            std::uint32_t id;
+            if (!freeIds_.empty()) {
+                id = freeIds_.back();
+                freeIds_.pop_back();
+                slots_[id - 1] = building.get();
+            } else {
+                slots_.push_back(building.get());
+                id = static_cast<std::uint32_t>(slots_.size());
+            }
+            ids_[building.get()] = id;
+            stampTiles(*building, id);
+
             buildings_.push_back(std::move(building));
+            markOccupancy(*buildings_.back(), true);
+            if (changeHandler_) {
+                changeHandler_(*buildings_.back());
+            }
         }
 
         BuildingManager::Building* BuildingManager::getBuildingAt(const types::Position& position) {
-            for (auto& building : buildings_) {
-                if (building->contains(position)) {
-                    return building.get();
-                }
-            }
-            return nullptr;
+            return const_cast<Building*>(static_cast<const BuildingManager*>(this)->getBuildingAt(position));
         }
 
         const BuildingManager::Building* BuildingManager::getBuildingAt(const types::Position& position) const {
-            for (const auto& building : buildings_) {
-                if (building->contains(position)) {
-                    return building.get();
-                }
+            if (position.row < 0 || position.row >= height_ ||
+                position.column < 0 || position.column >= width_) {
+                return nullptr;
             }
-            return nullptr;
+            std::uint32_t id = tileIds_[static_cast<size_t>(position.row) * width_ + position.column];
+            return id == NO_BUILDING ? nullptr : slots_[id - 1];
         }
 
         void BuildingManager::removeBuilding(Building* building) {
-            buildings_.erase(
-                std::remove_if(buildings_.begin(), buildings_.end(),
-                    [building](const std::unique_ptr<Building>& b) {
-                        return b.get() == building;
-                    }),
-                buildings_.end()
-            );
+            removeIf([building](const Building& b) { return &b == building; });
         }
 
         const std::vector<std::unique_ptr<BuildingManager::Building>>& BuildingManager::getBuildings() const {
             return buildings_;
         }
 
+        void BuildingManager::setChangeHandler(ChangeHandler handler) {
+            changeHandler_ = std::move(handler);
+        }
+
+        void BuildingManager::attachOccupancy(core::OccupancyGrid* occupancy) {
+            occupancy_ = occupancy;
+            for (const auto& building : buildings_) {
+                markOccupancy(*building, true);
+            }
+        }
+
+        void BuildingManager::markOccupancy(const Building& building, bool occupied) {
+            if (occupancy_) {
+                occupancy_->assignArea(building.getPosition(), building.getWidth(), building.getHeight(),
+                    core::OccupancyGrid::Building, occupied);
+            }
+        }
+
+        void BuildingManager::stampTiles(const Building& building, std::uint32_t id) {
+            types::Position origin = building.getPosition();
+            int firstRow = std::max(0, origin.row);
+            int lastRow = std::min(height_, origin.row + building.getHeight());
+            int firstColumn = std::max(0, origin.column);
+            int lastColumn = std::min(width_, origin.column + building.getWidth());
+            for (int row = firstRow; row < lastRow; ++row) {
+                for (int column = firstColumn; column < lastColumn; ++column) {
+                    auto& tile = tileIds_[static_cast<size_t>(row) * width_ + column];
+                    if (tile == NO_BUILDING) {
+                        tile = id;
+                    }
+                }
+            }
+        }
+
+        void BuildingManager::releaseTiles(const Building& building) {
+            auto it = ids_.find(&building);
+            if (it == ids_.end()) return;
+            std::uint32_t id = it->second;
+            ids_.erase(it);
+            slots_[id - 1] = nullptr;
+            freeIds_.push_back(id);
+
+            types::Position origin = building.getPosition();
+            int firstRow = std::max(0, origin.row);
+            int lastRow = std::min(height_, origin.row + building.getHeight());
+            int firstColumn = std::max(0, origin.column);
+            int lastColumn = std::min(width_, origin.column + building.getWidth());
+            for (int row = firstRow; row < lastRow; ++row) {
+                for (int column = firstColumn; column < lastColumn; ++column) {
+                    auto& tile = tileIds_[static_cast<size_t>(row) * width_ + column];
+                    if (tile == id) {
+                        tile = NO_BUILDING;
+                    }
+                }
+            }
+        }
+
         void BuildingManager::removeDestroyedBuildings() {
-            buildings_.erase(
-                std::remove_if(buildings_.begin(), buildings_.end(),
-                    [](const std::unique_ptr<Building>& building) {
-                        return building->isDestroyed();
-                    }),
-                buildings_.end()
-            );
+            removeIf([](const Building& building) { return building.isDestroyed(); });
+        }
+
+        template<typename Predicate>
+        void BuildingManager::removeIf(Predicate predicate) {
+            auto first = std::stable_partition(buildings_.begin(), buildings_.end(),
+                [&predicate](const std::unique_ptr<Building>& building) {
+                    return !predicate(*building);
+                });
+            if (first == buildings_.end()) return;
+
+            // 콜백이 변경 후의 상태를 보도록 목록에서 먼저 빼낸 뒤 알립니다.
+            std::vector<std::unique_ptr<Building>> removed(
+                std::make_move_iterator(first), std::make_move_iterator(buildings_.end()));
+            buildings_.erase(first, buildings_.end());
+
+            for (const auto& building : removed) {
+                releaseTiles(*building);
+                markOccupancy(*building, false);
+            }
+
+            // 제거된 건물과 겹쳐 있던 건물은 비워진 타일을 다시 차지합니다 (먼저 추가된 건물 우선).
+            for (const auto& building : buildings_) {
+                bool overlapped = std::any_of(removed.begin(), removed.end(),
+                    [&building](const std::unique_ptr<Building>& gone) { return overlaps(*building, *gone); });
+                if (overlapped) {
+                    markOccupancy(*building, true);
+                    stampTiles(*building, ids_[building.get()]);
+                }
+            }
+            if (changeHandler_) {
+                for (const auto& building : removed) {
+                    changeHandler_(*building);
+                }
+            }
         }
 
     } // namespace managers
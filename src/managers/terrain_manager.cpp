@@ -7,28 +7,88 @@ namespace dune {
         // TerrainManager 클래스 구현
 
         TerrainManager::TerrainManager(int width, int height)
-            : width_(width), height_(height),
-            terrainMap_(height, std::vector<Terrain>(width))
+            : width_(width), height_(height)
         {
-            for (int row = 0; row < height_; ++row) {
-                for (int col = 0; col < width_; ++col) {
-                    types::Position pos{ row, col };
-                    terrainMap_[row][col] = Terrain(types::TerrainType::Desert, pos);
-                }
+            const std::size_t count = static_cast<std::size_t>(width_) * height_;
+            const std::size_t words = (count + 63) / 64;
+            tiles_.assign(count, static_cast<std::uint8_t>(types::TerrainType::Desert));
+            walkable_.assign(words, 0);
+            buildable_.assign(words, 0);
+            harvestable_.assign(words, 0);
+            for (std::size_t i = 0; i < count; ++i) {
+                storeTile(i, types::TerrainType::Desert);
             }
         }
 
-        const TerrainManager::Terrain& TerrainManager::getTerrain(const types::Position& position) const {
-            static Terrain emptyTerrain(types::TerrainType::Empty);
+        TerrainManager::Terrain TerrainManager::getTerrain(const types::Position& position) const {
             if (isValidPosition(position)) {
-                return terrainMap_[position.row][position.column];
+                return Terrain(static_cast<types::TerrainType>(tiles_[indexOf(position)]), position);
             }
-            return emptyTerrain;
+            return Terrain(types::TerrainType::Empty);
+        }
+
+        types::TerrainType TerrainManager::getType(const types::Position& position) const {
+            if (isValidPosition(position)) {
+                return static_cast<types::TerrainType>(tiles_[indexOf(position)]);
+            }
+            return types::TerrainType::Empty;
+        }
+
+        bool TerrainManager::isWalkable(const types::Position& position) const {
+            return isValidPosition(position) && testBit(walkable_, indexOf(position));
+        }
+
+        bool TerrainManager::isBuildable(const types::Position& position) const {
+            return isValidPosition(position) && testBit(buildable_, indexOf(position));
+        }
+
+        bool TerrainManager::canHarvestSpice(const types::Position& position) const {
+            return isValidPosition(position) && testBit(harvestable_, indexOf(position));
         }
 
         void TerrainManager::setTerrain(const types::Position& position, types::TerrainType type) {
             if (isValidPosition(position)) {
-                terrainMap_[position.row][position.column] = Terrain(type, position);
+                storeTile(indexOf(position), type);
+                if (occupancy_) {
+                    occupancy_->assign(position, core::OccupancyGrid::Rock, !entity::isWalkableTerrain(type));
+                }
+                if (changeHandler_) {
+                    changeHandler_(position);
+                }
+            }
+        }
+
+        void TerrainManager::setChangeHandler(ChangeHandler handler) {
+            changeHandler_ = std::move(handler);
+        }
+
+        bool TerrainManager::loadTiles(std::span<const std::uint8_t> tiles) {
+            if (tiles.size() != tiles_.size()) {
+                return false;
+            }
+            for (const std::uint8_t tile : tiles) {
+                if (tile >= static_cast<std::uint8_t>(types::TerrainType::Empty)) {
+                    return false;
+                }
+            }
+
+            for (std::size_t i = 0; i < tiles.size(); ++i) {
+                if (tiles_[i] != tiles[i]) {
+                    const int row = static_cast<int>(i / width_);
+                    setTerrain({ row, static_cast<int>(i) - row * width_ }, static_cast<types::TerrainType>(tiles[i]));
+                }
+            }
+            return true;
+        }
+
+        void TerrainManager::attachOccupancy(core::OccupancyGrid* occupancy) {
+            occupancy_ = occupancy;
+            if (!occupancy_) return;
+            for (int row = 0; row < height_; ++row) {
+                for (int column = 0; column < width_; ++column) {
+                    occupancy_->assign({ row, column }, core::OccupancyGrid::Rock,
+                        !testBit(walkable_, static_cast<std::size_t>(row) * width_ + column));
+                }
             }
         }
         
@@ -37,5 +97,21 @@ namespace dune {
                    position.column >= 0 && position.column < width_;
         }
 
+        void TerrainManager::assignBit(Bitset& bits, std::size_t index, bool value) {
+            const std::uint64_t mask = std::uint64_t{ 1 } << (index & 63);
+            if (value) {
+                bits[index >> 6] |= mask;
+            } else {
+                bits[index >> 6] &= ~mask;
+            }
+        }
+
+        void TerrainManager::storeTile(std::size_t index, types::TerrainType type) {
+            tiles_[index] = static_cast<std::uint8_t>(type);
+            assignBit(walkable_, index, entity::isWalkableTerrain(type));
+            assignBit(buildable_, index, entity::isBuildableTerrain(type));
+            assignBit(harvestable_, index, entity::isHarvestableTerrain(type));
+        }
+
     } // namespace managers
 } // namespace dune
@@ -1,48 +1,207 @@
 #include "managers/unit_manager.hpp"
 #include "utils/utils.hpp"
 #include "utils/constants.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace dune {
     namespace managers {
         // UnitManager 클래스 구현
 
-        UnitManager::UnitManager()
-            : quadTree_(0, 0, constants::MAP_WIDTH, constants::MAP_HEIGHT, 10) {}
+        UnitManager::UnitManager(int width, int height, spatial::SpatialIndexType indexType)
+            : width_(width)
+            , height_(height)
+            , tileUnits_(static_cast<std::size_t>(width) * height, nullptr)
+            , spatialIndex_(spatial::createSpatialIndex(indexType, width, height)) {}
 
         void UnitManager::addUnit(std::unique_ptr<Unit> unit) {
-            types::Position pos = unit->getPosition();
-            unitsByPosition_[pos] = std::move(unit);
-            quadTree_.insert(unitsByPosition_[pos].get());
+            Unit* raw = unit.get();
+            raw->slot_ = units_.size();
+            raw->id_ = static_cast<std::uint32_t>(slotById_.size());
+            slotById_.push_back(raw->slot_);
+            units_.push_back(std::move(unit));
+            active_.push_back(1);
+
+            if (isInside(raw->getPosition())) {
+                tileUnits_[tileOf(raw->getPosition())] = raw;
+            }
+            spatialIndex_->insert(raw);
+            if (occupancy_) {
+                occupancy_->assign(raw->getPosition(), core::OccupancyGrid::Unit, true);
+            }
         }
 
-        UnitManager::Unit* UnitManager::getUnitAt(const types::Position& position) {
-            auto it = unitsByPosition_.find(position);
-            if (it != unitsByPosition_.end()) {
-                return it->second.get();
+        bool UnitManager::restoreUnits(std::span<const core::snapshot::UnitRecord> records, std::uint32_t idCount,
+            std::vector<Unit*>& restored) {
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                if (records[i].id >= idCount || (i > 0 && records[i].id <= records[i - 1].id)) {
+                    return false;
+                }
+            }
+            collectRemovedUnits();
+
+            // 되돌릴 시점 뒤에 생긴 유닛은 번호가 가장 크므로 끝 칸부터 뗍니다.
+            while (!units_.empty() && units_.back()->id_ >= idCount) {
+                detach(units_.back().get());
+                units_.pop_back();
+                active_.pop_back();
+            }
+            slotById_.resize(idCount, NO_SLOT);
+
+            // 바뀐 유닛은 위치가 서로 겹칠 수 있으므로 모두 뗀 뒤에 다시 붙입니다.
+            bool missing = false;
+            for (const auto& record : records) {
+                const std::size_t slot = getSlotOfId(record.id);
+                if (slot == NO_SLOT) {
+                    missing = true;
+                }
+                else {
+                    detach(units_[slot].get());
+                }
+            }
+
+            // 해제된 유닛은 새로 만들어 번호 순서를 지키며 끼워 넣습니다.
+            if (missing) {
+                std::vector<std::unique_ptr<Unit>> units;
+                units.reserve(units_.size() + records.size());
+                std::size_t next = 0;
+                const auto insertMissing = [&](std::uint32_t before) {
+                    for (; next < records.size() && records[next].id < before; ++next) {
+                        if (getSlotOfId(records[next].id) == NO_SLOT) {
+                            units.push_back(std::make_unique<Unit>(records[next]));
+                            units.back()->id_ = records[next].id;
+                        }
+                    }
+                };
+                for (auto& unit : units_) {
+                    insertMissing(unit->id_);
+                    units.push_back(std::move(unit));
+                }
+                insertMissing(idCount);
+
+                units_ = std::move(units);
+                active_.assign(units_.size(), 1);
+                for (std::size_t slot = 0; slot < units_.size(); ++slot) {
+                    units_[slot]->slot_ = slot;
+                    slotById_[units_[slot]->id_] = slot;
+                }
             }
-            return nullptr;
+
+            restored.clear();
+            for (const auto& record : records) {
+                Unit* unit = units_[slotById_[record.id]].get();
+                unit->restoreStats(record);
+                attach(unit);
+                restored.push_back(unit);
+            }
+            return true;
+        }
+
+        UnitManager::Unit* UnitManager::getUnitAt(const types::Position& position) {
+            return isInside(position) ? tileUnits_[tileOf(position)] : nullptr;
         }
 
         const UnitManager::Unit* UnitManager::getUnitAt(const types::Position& position) const {
-            auto it = unitsByPosition_.find(position);
-            if (it != unitsByPosition_.end()) {
-                return it->second.get();
+            return isInside(position) ? tileUnits_[tileOf(position)] : nullptr;
+        }
+
+        bool UnitManager::relocate(Unit* unit, const types::Position& newPosition) {
+            if (!isActive(unit)) return false;  // 관리되지 않거나 이미 제거된 유닛
+
+            types::Position oldPosition = unit->getPosition();
+            if (oldPosition == newPosition) return true;
+            if (!isInside(newPosition) || tileUnits_[tileOf(newPosition)]) {
+                return false;  // 맵 밖이거나 대상 위치에 다른 유닛이 있음
+            }
+
+            // 공간 인덱스는 현재 위치로 저장 위치를 찾으므로 위치를 바꾸기 전에 제거합니다.
+            spatialIndex_->remove(unit);
+
+            if (isInside(oldPosition) && tileUnits_[tileOf(oldPosition)] == unit) {
+                tileUnits_[tileOf(oldPosition)] = nullptr;
+            }
+            tileUnits_[tileOf(newPosition)] = unit;
+            unit->moveTo(newPosition);
+
+            spatialIndex_->insert(unit);
+            if (occupancy_) {
+                occupancy_->assign(oldPosition, core::OccupancyGrid::Unit, false);
+                occupancy_->assign(newPosition, core::OccupancyGrid::Unit, true);
             }
-            return nullptr;
+            return true;
         }
 
         void UnitManager::removeUnit(Unit* unit) {
-            if (!unit) return;
-            // Unit의 위치를 얻어 key로 사용
-            types::Position pos = unit->getPosition();
-            unitsByPosition_.erase(pos);
-            quadTree_.remove(unit);
+            if (!isActive(unit)) return;
+
+            detach(unit);
+            active_[unit->slot_] = 0;
+            hasRemovedUnits_ = true;
+        }
+
+        void UnitManager::detach(Unit* unit) {
+            const types::Position position = unit->getPosition();
+            if (isInside(position) && tileUnits_[tileOf(position)] == unit) {
+                tileUnits_[tileOf(position)] = nullptr;
+            }
+            spatialIndex_->remove(unit);
+            if (occupancy_) {
+                occupancy_->assign(position, core::OccupancyGrid::Unit, false);
+            }
+        }
+
+        void UnitManager::attach(Unit* unit) {
+            const types::Position position = unit->getPosition();
+            if (isInside(position)) {
+                tileUnits_[tileOf(position)] = unit;
+            }
+            spatialIndex_->insert(unit);
+            if (occupancy_) {
+                occupancy_->assign(position, core::OccupancyGrid::Unit, true);
+            }
+        }
+
+        bool UnitManager::isActive(const Unit* unit) const {
+            if (!unit) return false;
+            std::size_t slot = unit->slot_;
+            return slot < units_.size() && units_[slot].get() == unit && active_[slot];
+        }
+
+        void UnitManager::collectRemovedUnits() {
+            if (!hasRemovedUnits_) return;
+
+            // 살아 있는 칸을 앞으로 당기며 순서를 유지합니다.
+            std::size_t kept = 0;
+            for (std::size_t slot = 0; slot < units_.size(); ++slot) {
+                if (!active_[slot]) {
+                    slotById_[units_[slot]->id_] = NO_SLOT;
+                    continue;
+                }
+                if (kept != slot) {
+                    units_[kept] = std::move(units_[slot]);
+                    active_[kept] = 1;
+                    units_[kept]->slot_ = kept;
+                    slotById_[units_[kept]->id_] = kept;
+                }
+                ++kept;
+            }
+            units_.resize(kept);
+            active_.resize(kept);
+            hasRemovedUnits_ = false;
+        }
+
+        void UnitManager::attachOccupancy(core::OccupancyGrid* occupancy) {
+            occupancy_ = occupancy;
+            if (!occupancy_) return;
+            for (std::size_t slot = 0; slot < units_.size(); ++slot) {
+                if (active_[slot]) {
+                    occupancy_->assign(units_[slot]->getPosition(), core::OccupancyGrid::Unit, true);
+                }
+            }
         }
 
-        const UnitManager::UnitMap& 
-            UnitManager::getUnits() const {
-                return unitsByPosition_;
+        const std::vector<std::unique_ptr<UnitManager::Unit>>& UnitManager::getUnits() const {
+            return units_;
         }
 
     } // namespace managers
@@ -0,0 +1,404 @@
+#include "pathfinding/cluster_graph.hpp"
+#include "core/map.hpp"
+#include "core/profiler.hpp"
+#include "utils/utils.hpp"
+#include <algorithm>
+#include <array>
+
+namespace dune {
+    namespace pathfinding {
+
+        namespace {
+            // 경계 구간이 이 길이 이상이면 양 끝에 입구를 두고, 짧으면 가운데 하나만 둡니다.
+            constexpr int WIDE_ENTRANCE_LENGTH = 6;
+
+            struct OpenEntryGreater {
+                template<typename Entry>
+                bool operator()(const Entry& a, const Entry& b) const {
+                    if (a.fCost != b.fCost) return a.fCost > b.fCost;
+                    return a.index > b.index;
+                }
+            };
+        }
+
+        ClusterGraph::ClusterGraph(int clusterSize)
+            : clusterSize_(std::max(2, clusterSize)) {}
+
+        void ClusterGraph::markDirty(const types::Position& origin, int width, int height) {
+            if (!built_) return;  // 아직 만들지 않았다면 첫 탐색 때 전체를 만듭니다.
+
+            int firstColumn = std::max(0, origin.column) / clusterSize_;
+            int lastColumn = std::min(width_ - 1, origin.column + width - 1) / clusterSize_;
+            int firstRow = std::max(0, origin.row) / clusterSize_;
+            int lastRow = std::min(height_ - 1, origin.row + height - 1) / clusterSize_;
+            for (int cy = firstRow; cy <= lastRow; ++cy) {
+                for (int cx = firstColumn; cx <= lastColumn; ++cx) {
+                    clusters_[cy * clusterColumns_ + cx].dirty = true;
+                    anyDirty_ = true;
+                }
+            }
+        }
+
+        void ClusterGraph::build(const core::Map& map) {
+            width_ = map.getWidth();
+            height_ = map.getHeight();
+            clusterColumns_ = (width_ + clusterSize_ - 1) / clusterSize_;
+            clusterRows_ = (height_ + clusterSize_ - 1) / clusterSize_;
+
+            size_t size = static_cast<size_t>(width_) * height_;
+            blocked_.assign(size, 0);
+            localIndex_.assign(size, -1);
+            bfsStamp_.assign(size, 0);
+            bfsDistance_.assign(size, 0);
+            openStamp_.assign(size, 0);
+            closedStamp_.assign(size, 0);
+            gCost_.assign(size, 0);
+            parent_.assign(size, -1);
+            generation_ = 0;
+
+            clusters_.assign(static_cast<size_t>(clusterColumns_) * clusterRows_, Cluster{});
+            for (int cy = 0; cy < clusterRows_; ++cy) {
+                for (int cx = 0; cx < clusterColumns_; ++cx) {
+                    Cluster& cluster = clusters_[cy * clusterColumns_ + cx];
+                    cluster.minRow = cy * clusterSize_;
+                    cluster.minColumn = cx * clusterSize_;
+                    cluster.maxRow = std::min(height_, cluster.minRow + clusterSize_) - 1;
+                    cluster.maxColumn = std::min(width_, cluster.minColumn + clusterSize_) - 1;
+                    refreshBlocked(map, cluster);
+                }
+            }
+
+            verticalBorders_.assign(static_cast<size_t>(std::max(0, clusterColumns_ - 1)) * clusterRows_, {});
+            horizontalBorders_.assign(static_cast<size_t>(clusterColumns_) * std::max(0, clusterRows_ - 1), {});
+            for (int cy = 0; cy < clusterRows_; ++cy) {
+                for (int cx = 0; cx < clusterColumns_; ++cx) {
+                    if (cx + 1 < clusterColumns_) buildVerticalBorder(cx, cy);
+                    if (cy + 1 < clusterRows_) buildHorizontalBorder(cx, cy);
+                }
+            }
+            for (int c = 0; c < static_cast<int>(clusters_.size()); ++c) {
+                rebuildCluster(c);
+            }
+
+            built_ = true;
+            anyDirty_ = false;
+        }
+
+        void ClusterGraph::rebuildDirty(const core::Map& map) {
+            if (!anyDirty_) return;
+
+            std::vector<int> affected;
+            for (int cy = 0; cy < clusterRows_; ++cy) {
+                for (int cx = 0; cx < clusterColumns_; ++cx) {
+                    Cluster& cluster = clusters_[cy * clusterColumns_ + cx];
+                    if (!cluster.dirty) continue;
+
+                    refreshBlocked(map, cluster);
+                    // 이 클러스터의 네 경계를 다시 만들면 이웃 클러스터의 입구도 바뀝니다.
+                    if (cx > 0) buildVerticalBorder(cx - 1, cy);
+                    if (cx + 1 < clusterColumns_) buildVerticalBorder(cx, cy);
+                    if (cy > 0) buildHorizontalBorder(cx, cy - 1);
+                    if (cy + 1 < clusterRows_) buildHorizontalBorder(cx, cy);
+
+                    affected.push_back(cy * clusterColumns_ + cx);
+                    if (cx > 0) affected.push_back(cy * clusterColumns_ + cx - 1);
+                    if (cx + 1 < clusterColumns_) affected.push_back(cy * clusterColumns_ + cx + 1);
+                    if (cy > 0) affected.push_back((cy - 1) * clusterColumns_ + cx);
+                    if (cy + 1 < clusterRows_) affected.push_back((cy + 1) * clusterColumns_ + cx);
+                }
+            }
+
+            std::sort(affected.begin(), affected.end());
+            affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+            for (int c : affected) {
+                rebuildCluster(c);
+                clusters_[c].dirty = false;
+            }
+            anyDirty_ = false;
+        }
+
+        void ClusterGraph::refreshBlocked(const core::Map& map, const Cluster& cluster) {
+            const auto& occupancy = map.getOccupancy();
+            for (int row = cluster.minRow; row <= cluster.maxRow; ++row) {
+                for (int column = cluster.minColumn; column <= cluster.maxColumn; ++column) {
+                    size_t index = static_cast<size_t>(row) * width_ + column;
+                    blocked_[index] = occupancy.isBlockedAt(index, core::OccupancyGrid::STATIC_LAYERS) ? 1 : 0;
+                }
+            }
+        }
+
+        void ClusterGraph::buildVerticalBorder(int cx, int cy) {
+            auto& border = verticalBorders_[cy * (clusterColumns_ - 1) + cx];
+            border.clear();
+
+            const Cluster& left = clusters_[cy * clusterColumns_ + cx];
+            const int column = left.maxColumn;
+            auto open = [&](int row) {
+                int index = row * width_ + column;
+                return !blocked_[index] && !blocked_[index + 1];
+            };
+
+            for (int row = left.minRow; row <= left.maxRow;) {
+                if (!open(row)) { ++row; continue; }
+                int first = row;
+                while (row <= left.maxRow && open(row)) ++row;
+                int last = row - 1;
+
+                if (last - first + 1 >= WIDE_ENTRANCE_LENGTH) {
+                    border.push_back(first * width_ + column);
+                    border.push_back(last * width_ + column);
+                }
+                else {
+                    border.push_back((first + last) / 2 * width_ + column);
+                }
+            }
+        }
+
+        void ClusterGraph::buildHorizontalBorder(int cx, int cy) {
+            auto& border = horizontalBorders_[cy * clusterColumns_ + cx];
+            border.clear();
+
+            const Cluster& top = clusters_[cy * clusterColumns_ + cx];
+            const int row = top.maxRow;
+            auto open = [&](int column) {
+                int index = row * width_ + column;
+                return !blocked_[index] && !blocked_[index + width_];
+            };
+
+            for (int column = top.minColumn; column <= top.maxColumn;) {
+                if (!open(column)) { ++column; continue; }
+                int first = column;
+                while (column <= top.maxColumn && open(column)) ++column;
+                int last = column - 1;
+
+                if (last - first + 1 >= WIDE_ENTRANCE_LENGTH) {
+                    border.push_back(row * width_ + first);
+                    border.push_back(row * width_ + last);
+                }
+                else {
+                    border.push_back(row * width_ + (first + last) / 2);
+                }
+            }
+        }
+
+        void ClusterGraph::rebuildCluster(int clusterIndex) {
+            Cluster& cluster = clusters_[clusterIndex];
+            const int cx = clusterIndex % clusterColumns_;
+            const int cy = clusterIndex / clusterColumns_;
+
+            for (int index : cluster.entrances) {
+                localIndex_[index] = -1;
+            }
+            cluster.entrances.clear();
+
+            auto addEntrance = [&](int index) {
+                if (localIndex_[index] < 0) {
+                    localIndex_[index] = static_cast<int>(cluster.entrances.size());
+                    cluster.entrances.push_back(index);
+                }
+            };
+            if (cx > 0) {
+                for (int index : verticalBorders_[cy * (clusterColumns_ - 1) + cx - 1]) addEntrance(index + 1);
+            }
+            if (cx + 1 < clusterColumns_) {
+                for (int index : verticalBorders_[cy * (clusterColumns_ - 1) + cx]) addEntrance(index);
+            }
+            if (cy > 0) {
+                for (int index : horizontalBorders_[(cy - 1) * clusterColumns_ + cx]) addEntrance(index + width_);
+            }
+            if (cy + 1 < clusterRows_) {
+                for (int index : horizontalBorders_[cy * clusterColumns_ + cx]) addEntrance(index);
+            }
+
+            // 입구마다 클러스터 내부 BFS로 다른 입구까지의 비용을 구합니다.
+            const size_t count = cluster.entrances.size();
+            cluster.costs.assign(count * count, -1);
+            for (size_t i = 0; i < count; ++i) {
+                searchCluster(cluster, cluster.entrances[i]);
+                for (size_t j = 0; j < count; ++j) {
+                    int other = cluster.entrances[j];
+                    if (bfsStamp_[other] == generation_) {
+                        cluster.costs[i * count + j] = bfsDistance_[other];
+                    }
+                }
+            }
+        }
+
+        void ClusterGraph::nextGeneration() {
+            // 세대 번호가 한 바퀴 돌면 이전 표시와 구분할 수 없으므로 표시를 모두 지웁니다.
+            if (++generation_ == 0) {
+                std::fill(bfsStamp_.begin(), bfsStamp_.end(), 0);
+                std::fill(openStamp_.begin(), openStamp_.end(), 0);
+                std::fill(closedStamp_.begin(), closedStamp_.end(), 0);
+                generation_ = 1;
+            }
+        }
+
+        void ClusterGraph::searchCluster(const Cluster& cluster, int source) {
+            nextGeneration();
+            bfsQueue_.clear();
+            bfsQueue_.push_back(source);
+            bfsStamp_[source] = generation_;
+            bfsDistance_[source] = 0;
+
+            for (size_t head = 0; head < bfsQueue_.size(); ++head) {
+                int index = bfsQueue_[head];
+                int row = index / width_;
+                int column = index % width_;
+                const std::array<int, 4> neighbors = {
+                    row > cluster.minRow ? index - width_ : -1,
+                    row < cluster.maxRow ? index + width_ : -1,
+                    column > cluster.minColumn ? index - 1 : -1,
+                    column < cluster.maxColumn ? index + 1 : -1
+                };
+                for (int neighbor : neighbors) {
+                    if (neighbor < 0 || blocked_[neighbor] || bfsStamp_[neighbor] == generation_) continue;
+                    bfsStamp_[neighbor] = generation_;
+                    bfsDistance_[neighbor] = bfsDistance_[index] + 1;
+                    bfsQueue_.push_back(neighbor);
+                }
+            }
+        }
+
+        int ClusterGraph::clusterOf(int index) const {
+            return (index / width_ / clusterSize_) * clusterColumns_ + (index % width_) / clusterSize_;
+        }
+
+        void ClusterGraph::relax(int index, int gCost, int parent, int goalIndex) {
+            if (closedStamp_[index] == generation_) return;
+            if (openStamp_[index] == generation_ && gCost_[index] <= gCost) return;
+
+            openStamp_[index] = generation_;
+            gCost_[index] = gCost;
+            parent_[index] = parent;
+
+            types::Position pos{ index / width_, index % width_ };
+            types::Position goal{ goalIndex / width_, goalIndex % width_ };
+            openHeap_.push_back({ gCost + utils::manhattanDistance(pos, goal), index });
+            std::push_heap(openHeap_.begin(), openHeap_.end(), OpenEntryGreater{});
+        }
+
+        bool ClusterGraph::findRoute(
+            const core::Map& map,
+            const types::Position& start,
+            const types::Position& goal,
+            std::vector<types::Position>& waypoints
+        ) {
+            core::ProfileScope scope(core::ProfileZone::ClusterRoute);
+            scope.setTraceArgs({ start.row, start.column, goal.row, goal.column });
+            waypoints.clear();
+
+            if (!built_ || width_ != map.getWidth() || height_ != map.getHeight()) {
+                build(map);
+            }
+            else {
+                rebuildDirty(map);
+            }
+
+            auto inMap = [this](const types::Position& pos) {
+                return pos.is_valid() && pos.row < height_ && pos.column < width_;
+            };
+            if (!inMap(start) || !inMap(goal) || start == goal) {
+                return false;
+            }
+
+            const int startIndex = start.row * width_ + start.column;
+            const int goalIndex = goal.row * width_ + goal.column;
+            if (blocked_[goalIndex]) {
+                return false;
+            }
+
+            const Cluster& startCluster = clusters_[clusterOf(startIndex)];
+            const Cluster& goalCluster = clusters_[clusterOf(goalIndex)];
+
+            // 목표 클러스터의 입구에서 목표까지의 거리
+            searchCluster(goalCluster, goalIndex);
+            if (&startCluster == &goalCluster && bfsStamp_[startIndex] == generation_) {
+                waypoints.push_back(goal);
+                scope.setTraceArgs({ start.row, start.column, goal.row, goal.column, 1 });
+                return true;
+            }
+            goalDistance_.assign(goalCluster.entrances.size(), -1);
+            for (size_t i = 0; i < goalCluster.entrances.size(); ++i) {
+                int entrance = goalCluster.entrances[i];
+                if (bfsStamp_[entrance] == generation_) goalDistance_[i] = bfsDistance_[entrance];
+            }
+
+            // 시작 위치에서 시작 클러스터 입구까지의 거리
+            searchCluster(startCluster, startIndex);
+            startDistance_.assign(startCluster.entrances.size(), -1);
+            for (size_t i = 0; i < startCluster.entrances.size(); ++i) {
+                int entrance = startCluster.entrances[i];
+                if (bfsStamp_[entrance] == generation_) startDistance_[i] = bfsDistance_[entrance];
+            }
+
+            // 추상 그래프 위의 A* (노드는 입구 타일, 부모 -1은 시작 위치)
+            nextGeneration();
+            openHeap_.clear();
+            for (size_t i = 0; i < startCluster.entrances.size(); ++i) {
+                if (startDistance_[i] >= 0) {
+                    relax(startCluster.entrances[i], startDistance_[i], -1, goalIndex);
+                }
+            }
+
+            const OpenEntryGreater greater;
+            while (!openHeap_.empty()) {
+                std::pop_heap(openHeap_.begin(), openHeap_.end(), greater);
+                OpenEntry current = openHeap_.back();
+                openHeap_.pop_back();
+
+                if (closedStamp_[current.index] == generation_) continue;
+                closedStamp_[current.index] = generation_;
+
+                if (current.index == goalIndex) {
+                    for (int index = goalIndex; index != -1; index = parent_[index]) {
+                        waypoints.push_back({ index / width_, index % width_ });
+                    }
+                    // 시작 위치가 입구였다면 첫 경유지는 이미 도착한 위치입니다.
+                    if (!waypoints.empty() && waypoints.back() == start) {
+                        waypoints.pop_back();
+                    }
+                    scope.setTraceArgs({ start.row, start.column, goal.row, goal.column, static_cast<std::int32_t>(waypoints.size()) });
+                    return !waypoints.empty();
+                }
+
+                const int g = gCost_[current.index];
+                const int clusterIndex = clusterOf(current.index);
+                const Cluster& cluster = clusters_[clusterIndex];
+                const int local = localIndex_[current.index];
+                if (local < 0) continue;  // 입구가 아닌 목표 타일은 위에서 처리됨
+
+                // 목표 클러스터라면 목표로 바로 이어지는 간선
+                if (&cluster == &goalCluster && goalDistance_[local] >= 0) {
+                    relax(goalIndex, g + goalDistance_[local], current.index, goalIndex);
+                }
+
+                // 클러스터 내부 간선 (미리 계산한 비용)
+                const size_t count = cluster.entrances.size();
+                for (size_t j = 0; j < count; ++j) {
+                    int cost = cluster.costs[local * count + j];
+                    if (cost > 0) {
+                        relax(cluster.entrances[j], g + cost, current.index, goalIndex);
+                    }
+                }
+
+                // 이웃 클러스터의 입구로 건너가는 간선
+                int row = current.index / width_;
+                int column = current.index % width_;
+                const std::array<int, 4> neighbors = {
+                    row > 0 ? current.index - width_ : -1,
+                    row + 1 < height_ ? current.index + width_ : -1,
+                    column > 0 ? current.index - 1 : -1,
+                    column + 1 < width_ ? current.index + 1 : -1
+                };
+                for (int neighbor : neighbors) {
+                    if (neighbor < 0 || localIndex_[neighbor] < 0 || clusterOf(neighbor) == clusterIndex) continue;
+                    relax(neighbor, g + 1, current.index, goalIndex);
+                }
+            }
+
+            return false;
+        }
+
+    } // namespace pathfinding
+} // namespace dune
@@ -0,0 +1,176 @@
+#include "pathfinding/flow_field.hpp"
+#include "core/map.hpp"
+#include "core/profiler.hpp"
+#include <algorithm>
+#include <array>
+
+namespace dune {
+    namespace pathfinding {
+
+        namespace {
+            // 방향 설정 (상, 하, 좌, 우)
+            constexpr std::array<types::Position, 4> DIRECTIONS = {
+                types::Position{-1, 0}, // 위
+                types::Position{1, 0},  // 아래
+                types::Position{0, -1}, // 왼쪽
+                types::Position{0, 1}   // 오른쪽
+            };
+        }
+
+        bool isStaticallyBlocked(const core::Map& map, const types::Position& position) {
+            return map.getOccupancy().isBlocked(position, core::OccupancyGrid::STATIC_LAYERS);
+        }
+
+        FlowField::FlowField(const core::Map& map, const types::Position& goal)
+            : width_(map.getWidth())
+            , height_(map.getHeight())
+            , goal_(goal)
+            , distance_(static_cast<size_t>(width_) * height_, -1)
+            , direction_(static_cast<size_t>(width_) * height_, NO_DIRECTION) {
+            core::ProfileScope scope(core::ProfileZone::FlowField);
+            scope.setTraceArgs({ goal.row, goal.column });
+            auto inMap = [this](const types::Position& pos) {
+                return pos.is_valid() && pos.row < height_ && pos.column < width_;
+            };
+            if (!inMap(goal)) return;
+
+            // 지형과 건물로 막힌 타일은 점유 맵에서 바로 읽습니다.
+            const auto& occupancy = map.getOccupancy();
+            auto blocked = [&occupancy](int index) {
+                return occupancy.isBlockedAt(static_cast<size_t>(index), core::OccupancyGrid::STATIC_LAYERS);
+            };
+
+            const int goalIndex = goal.row * width_ + goal.column;
+            if (blocked(goalIndex)) return;
+
+            // 목표에서 시작하는 BFS (모든 이동 비용이 1이므로 다익스트라와 같습니다)
+            std::vector<int> queue;
+            queue.reserve(distance_.size());
+            queue.push_back(goalIndex);
+            distance_[goalIndex] = 0;
+
+            for (size_t head = 0; head < queue.size(); ++head) {
+                int index = queue[head];
+                types::Position pos{ index / width_, index % width_ };
+                for (std::uint8_t dir = 0; dir < DIRECTIONS.size(); ++dir) {
+                    types::Position neighborPos = pos + DIRECTIONS[dir];
+                    if (!inMap(neighborPos)) continue;
+
+                    int neighbor = neighborPos.row * width_ + neighborPos.column;
+                    if (blocked(neighbor) || distance_[neighbor] >= 0) continue;
+
+                    distance_[neighbor] = distance_[index] + 1;
+                    // 이웃에서 현재 타일로 가는 방향은 dir의 반대 방향입니다 (0<->1, 2<->3).
+                    direction_[neighbor] = dir ^ 1;
+                    queue.push_back(neighbor);
+                }
+            }
+            scope.setTraceArgs({ goal.row, goal.column, static_cast<std::int32_t>(queue.size()) });
+        }
+
+        int FlowField::getDistance(const types::Position& position) const {
+            if (!position.is_valid() || position.row >= height_ || position.column >= width_) {
+                return -1;
+            }
+            return distance_[static_cast<size_t>(position.row) * width_ + position.column];
+        }
+
+        bool FlowField::nextStep(const core::Map& map, const types::Position& from, types::Position& next) const {
+            int distance = getDistance(from);
+            if (distance <= 0) return false;
+
+            const auto& occupancy = map.getOccupancy();
+            std::uint8_t preferred = direction_[static_cast<size_t>(from.row) * width_ + from.column];
+            types::Position candidate = from + DIRECTIONS[preferred];
+            if (!occupancy.isBlocked(candidate, core::OccupancyGrid::Unit)) {
+                next = candidate;
+                return true;
+            }
+
+            // 기본 방향이 막혀 있으면 목표에 똑같이 가까워지는 다른 방향으로 돌아갑니다.
+            for (std::uint8_t dir = 0; dir < DIRECTIONS.size(); ++dir) {
+                if (dir == preferred) continue;
+                candidate = from + DIRECTIONS[dir];
+                if (getDistance(candidate) == distance - 1 && !occupancy.isBlocked(candidate, core::OccupancyGrid::Unit)) {
+                    next = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        int FlowField::getCloserNeighbors(const types::Position& from, std::array<types::Position, 4>& neighbors) const {
+            int distance = getDistance(from);
+            if (distance <= 0) return 0;
+
+            int count = 0;
+            for (const auto& dir : DIRECTIONS) {
+                types::Position candidate = from + dir;
+                if (getDistance(candidate) == distance - 1) {
+                    neighbors[count++] = candidate;
+                }
+            }
+            return count;
+        }
+
+        bool FlowField::isAffectedBy(const types::Position& position, bool blockedNow) const {
+            if (!position.is_valid() || position.row >= height_ || position.column >= width_) {
+                return false;
+            }
+            if (blockedNow) {
+                // 도달 가능하던 타일이 막히면 그 타일을 지나던 거리들이 바뀝니다.
+                return getDistance(position) >= 0;
+            }
+            // 막혀 있던 타일이 열리면, 도달 가능한 이웃이 있을 때만 새 길이 생깁니다.
+            if (getDistance(position) >= 0) return false;
+            return std::any_of(DIRECTIONS.begin(), DIRECTIONS.end(), [&](const types::Position& dir) {
+                return getDistance(position + dir) >= 0;
+            });
+        }
+
+        std::shared_ptr<const FlowField> FlowFieldCache::acquire(const core::Map& map, const types::Position& goal) {
+            pruneExpired();
+
+            auto it = fields_.find(goal);
+            if (it != fields_.end()) {
+                if (auto field = it->second.lock(); field && !field->isStale()) {
+                    return field;
+                }
+            }
+
+            auto field = std::make_shared<FlowField>(map, goal);
+            fields_[goal] = field;
+            ++buildCount_;
+            return field;
+        }
+
+        void FlowFieldCache::invalidateArea(const core::Map& map, const types::Position& origin, int width, int height) {
+            pruneExpired();
+            if (fields_.empty()) return;
+
+            for (int row = origin.row; row < origin.row + height; ++row) {
+                for (int column = origin.column; column < origin.column + width; ++column) {
+                    types::Position pos{ row, column };
+                    bool blockedNow = isStaticallyBlocked(map, pos);
+                    for (auto& [goal, weak] : fields_) {
+                        auto field = weak.lock();
+                        if (field && !field->isStale() && field->isAffectedBy(pos, blockedNow)) {
+                            field->markStale();
+                        }
+                    }
+                }
+            }
+        }
+
+        size_t FlowFieldCache::getLiveFieldCount() const {
+            return static_cast<size_t>(std::count_if(fields_.begin(), fields_.end(),
+                [](const auto& entry) { return !entry.second.expired(); }));
+        }
+
+        void FlowFieldCache::pruneExpired() {
+            // 참조하는 유닛이 없어진 흐름장은 이미 해제되었으므로 항목만 지웁니다.
+            std::erase_if(fields_, [](const auto& entry) { return entry.second.expired(); });
+        }
+
+    } // namespace pathfinding
+} // namespace dune
@@ -0,0 +1,252 @@
+#include "pathfinding/path_cache.hpp"
+#include "core/map.hpp"
+#include <algorithm>
+
+namespace dune {
+    namespace pathfinding {
+
+        MovementClass movementClassOf(types::UnitType type) {
+            return type == types::UnitType::Sandworm ? MovementClass::Sandworm : MovementClass::Ground;
+        }
+
+        bool PathCache::findPath(
+            Pathfinder& pathfinder,
+            const core::Map& map,
+            const types::Position& start,
+            const types::Position& goal,
+            MovementClass movementClass,
+            std::vector<types::Position>& path
+        ) {
+            const bool found = lookup(pathfinder, map, start, goal, movementClass, path, stitch_, pendingUpdate_);
+            apply(pendingUpdate_);
+            return found;
+        }
+
+        bool PathCache::lookup(
+            Pathfinder& pathfinder,
+            const core::Map& map,
+            const types::Position& start,
+            const types::Position& goal,
+            MovementClass movementClass,
+            std::vector<types::Position>& path,
+            std::vector<types::Position>& stitch,
+            PathCacheUpdate& update
+        ) const {
+            update.region = -1;
+            update.hit = false;
+            update.path.clear();
+            if (!start.is_valid()) {
+                return pathfinder.findPath(map, start, goal, path);
+            }
+
+            const int regionColumns = (map.getWidth() + REGION_SIZE - 1) / REGION_SIZE;
+            update.region = (start.row / REGION_SIZE) * regionColumns + start.column / REGION_SIZE;
+            update.goal = goal;
+            update.movementClass = movementClass;
+            update.start = start;
+
+            if (const Entry* entry = findEntry(update.region, goal, movementClass)) {
+                if (reuse(pathfinder, map, *entry, start, path, stitch)) {
+                    update.hit = true;
+                    return true;
+                }
+            }
+
+            if (!pathfinder.findPath(map, start, goal, path)) {
+                return false;
+            }
+            update.path.assign(path.begin(), path.end());
+            return true;
+        }
+
+        void PathCache::apply(const PathCacheUpdate& update) {
+            if (update.region < 0) return;
+
+            if (update.hit) {
+                ++stats_.hits;
+                // 같은 틱에 먼저 적용된 갱신이 항목을 덮어썼을 수 있으므로 다시 찾습니다.
+                if (Entry* entry = findEntry(update.region, update.goal, update.movementClass)) {
+                    entry->lastUsed = ++useCounter_;
+                }
+                return;
+            }
+
+            ++stats_.misses;
+            if (!update.path.empty()) {
+                store(update.region, update.goal, update.movementClass, update.start, update.path);
+            }
+        }
+
+        void PathCache::invalidateArea(const types::Position& origin, int width, int height) {
+            const int minRow = origin.row;
+            const int minColumn = origin.column;
+            const int maxRow = origin.row + height - 1;
+            const int maxColumn = origin.column + width - 1;
+
+            auto touches = [&](const Entry& entry) {
+                if (entry.maxCorner.row < minRow || entry.minCorner.row > maxRow ||
+                    entry.maxCorner.column < minColumn || entry.minCorner.column > maxColumn) {
+                    return false;
+                }
+                return std::any_of(entry.path.begin(), entry.path.end(), [&](const types::Position& pos) {
+                    return pos.row >= minRow && pos.row <= maxRow &&
+                        pos.column >= minColumn && pos.column <= maxColumn;
+                });
+            };
+
+            for (size_t i = 0; i < entries_.size();) {
+                if (touches(entries_[i])) {
+                    // 항목 순서는 의미가 없으므로 마지막 항목과 교체 후 제거합니다.
+                    entries_[i] = std::move(entries_.back());
+                    entries_.pop_back();
+                    ++stats_.invalidations;
+                }
+                else {
+                    ++i;
+                }
+            }
+        }
+
+        PathCache::Entry* PathCache::findEntry(int region, const types::Position& goal, MovementClass movementClass) {
+            return const_cast<Entry*>(static_cast<const PathCache*>(this)->findEntry(region, goal, movementClass));
+        }
+
+        const PathCache::Entry* PathCache::findEntry(
+            int region,
+            const types::Position& goal,
+            MovementClass movementClass
+        ) const {
+            for (const auto& entry : entries_) {
+                if (entry.region == region && entry.goal == goal && entry.movementClass == movementClass) {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        void PathCache::store(
+            int region,
+            const types::Position& goal,
+            MovementClass movementClass,
+            const types::Position& start,
+            const std::vector<types::Position>& path
+        ) {
+            Entry* entry = findEntry(region, goal, movementClass);
+            if (!entry) {
+                if (entries_.size() < MAX_ENTRIES) {
+                    entry = &entries_.emplace_back();
+                }
+                else {
+                    // 가장 오래 사용되지 않은 항목을 덮어씁니다.
+                    entry = &*std::min_element(entries_.begin(), entries_.end(),
+                        [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+                }
+            }
+
+            assign(*entry, region, goal, movementClass, start, path);
+            entry->lastUsed = ++useCounter_;
+        }
+
+        void PathCache::assign(
+            Entry& entry,
+            int region,
+            const types::Position& goal,
+            MovementClass movementClass,
+            const types::Position& start,
+            const std::vector<types::Position>& path
+        ) {
+            entry.region = region;
+            entry.goal = goal;
+            entry.movementClass = movementClass;
+            entry.start = start;
+            entry.path.assign(path.begin(), path.end());
+            entry.minCorner = start;
+            entry.maxCorner = start;
+            for (const auto& pos : path) {
+                entry.minCorner.row = std::min(entry.minCorner.row, pos.row);
+                entry.minCorner.column = std::min(entry.minCorner.column, pos.column);
+                entry.maxCorner.row = std::max(entry.maxCorner.row, pos.row);
+                entry.maxCorner.column = std::max(entry.maxCorner.column, pos.column);
+            }
+        }
+
+        void PathCache::restore(std::uint64_t clock) {
+            entries_.clear();
+            useCounter_ = clock;
+        }
+
+        bool PathCache::restoreEntry(
+            int region,
+            const types::Position& goal,
+            MovementClass movementClass,
+            const types::Position& start,
+            const std::vector<types::Position>& path,
+            std::uint64_t lastUsed
+        ) {
+            if (entries_.size() >= MAX_ENTRIES) {
+                return false;
+            }
+            Entry& entry = entries_.emplace_back();
+            assign(entry, region, goal, movementClass, start, path);
+            entry.lastUsed = lastUsed;
+            return true;
+        }
+
+        bool PathCache::reuse(
+            Pathfinder& pathfinder,
+            const core::Map& map,
+            const Entry& entry,
+            const types::Position& start,
+            std::vector<types::Position>& path,
+            std::vector<types::Position>& stitch
+        ) const {
+            if (start == entry.start) {
+                path.assign(entry.path.begin(), entry.path.end());
+            }
+            else {
+                // 시작 영역과 그 바깥 한 칸까지를 국소 탐색 범위로 사용합니다.
+                const int regionRow = start.row / REGION_SIZE * REGION_SIZE;
+                const int regionColumn = start.column / REGION_SIZE * REGION_SIZE;
+                const SearchBounds bounds{
+                    regionRow - 1, regionColumn - 1,
+                    regionRow + REGION_SIZE, regionColumn + REGION_SIZE
+                };
+
+                // 범위 안에 있는 캐시 경로 타일 중 목표에 가장 가까운(앞쪽) 타일에 이어 붙입니다.
+                auto joinIt = std::find_if(entry.path.begin(), entry.path.end(), [&](const types::Position& pos) {
+                    return pos.row >= bounds.minRow && pos.row <= bounds.maxRow &&
+                        pos.column >= bounds.minColumn && pos.column <= bounds.maxColumn;
+                });
+                if (joinIt == entry.path.end()) {
+                    return false;
+                }
+
+                if (*joinIt == start) {
+                    path.assign(entry.path.begin(), joinIt);
+                }
+                else {
+                    if (!pathfinder.findPathWithin(map, start, *joinIt, bounds, stitch)) {
+                        return false;
+                    }
+                    // stitch는 이음 타일이 맨 앞이므로 캐시 경로의 이음 타일 앞부분 뒤에 그대로 붙입니다.
+                    path.assign(entry.path.begin(), joinIt);
+                    path.insert(path.end(), stitch.begin(), stitch.end());
+                }
+                if (path.empty()) {
+                    return false;
+                }
+            }
+
+            // 캐시에는 유닛이 반영되어 있지 않으므로 경로 위(목표 제외)에 유닛이 있으면 다시 탐색합니다.
+            const auto& occupancy = map.getOccupancy();
+            for (size_t i = 1; i < path.size(); ++i) {
+                if (occupancy.isBlocked(path[i], core::OccupancyGrid::Unit)) {
+                    path.clear();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    } // namespace pathfinding
+} // namespace dune
@@ -0,0 +1,169 @@
+#include "pathfinding/pathfinder.hpp"
+#include "core/map.hpp"
+#include "core/profiler.hpp"
+#include "utils/utils.hpp"
+#include <algorithm>
+#include <array>
+
+namespace dune {
+    namespace pathfinding {
+
+        namespace {
+            // 방향 설정 (상, 하, 좌, 우)
+            constexpr std::array<types::Position, 4> DIRECTIONS = {
+                types::Position{-1, 0}, // 위
+                types::Position{1, 0},  // 아래
+                types::Position{0, -1}, // 왼쪽
+                types::Position{0, 1}   // 오른쪽
+            };
+
+            // 힙 정렬 기준: f 비용이 작은 노드, 같으면 목표에 가까운 노드를 먼저 꺼냅니다.
+            struct OpenEntryGreater {
+                template<typename Entry>
+                bool operator()(const Entry& a, const Entry& b) const {
+                    if (a.fCost != b.fCost) return a.fCost > b.fCost;
+                    if (a.hCost != b.hCost) return a.hCost > b.hCost;
+                    return a.index > b.index;
+                }
+            };
+        }
+
+        void Pathfinder::beginSearch(int width, int height) {
+            if (width != width_ || height != height_) {
+                width_ = width;
+                height_ = height;
+                size_t size = static_cast<size_t>(width) * height;
+                gCost_.assign(size, 0);
+                parent_.assign(size, -1);
+                openStamp_.assign(size, 0);
+                closedStamp_.assign(size, 0);
+                generation_ = 0;
+            }
+
+            // 세대 번호가 한 바퀴 돌면 이전 표시와 구분할 수 없으므로 표시를 모두 지웁니다.
+            if (++generation_ == 0) {
+                std::fill(openStamp_.begin(), openStamp_.end(), 0);
+                std::fill(closedStamp_.begin(), closedStamp_.end(), 0);
+                generation_ = 1;
+            }
+            openHeap_.clear();
+        }
+
+        bool Pathfinder::isPassable(const core::Map& map, int index, int goalIndex) const {
+            // 목표 지점의 유닛은 추적/사냥 대상이므로 장애물로 보지 않습니다.
+            const std::uint8_t layers = index == goalIndex
+                ? core::OccupancyGrid::STATIC_LAYERS
+                : core::OccupancyGrid::ALL_LAYERS;
+            return !map.getOccupancy().isBlockedAt(static_cast<size_t>(index), layers);
+        }
+
+        bool Pathfinder::findPath(
+            const core::Map& map,
+            const types::Position& start,
+            const types::Position& goal,
+            std::vector<types::Position>& path
+        ) {
+            return search(map, start, goal, { 0, 0, map.getHeight() - 1, map.getWidth() - 1 }, path);
+        }
+
+        bool Pathfinder::findPathWithin(
+            const core::Map& map,
+            const types::Position& start,
+            const types::Position& goal,
+            const SearchBounds& bounds,
+            std::vector<types::Position>& path
+        ) {
+            // 맵 밖으로 나간 영역은 맵 경계로 자릅니다.
+            SearchBounds clipped{
+                std::max(0, bounds.minRow),
+                std::max(0, bounds.minColumn),
+                std::min(map.getHeight() - 1, bounds.maxRow),
+                std::min(map.getWidth() - 1, bounds.maxColumn)
+            };
+            return search(map, start, goal, clipped, path);
+        }
+
+        bool Pathfinder::search(
+            const core::Map& map,
+            const types::Position& start,
+            const types::Position& goal,
+            const SearchBounds& bounds,
+            std::vector<types::Position>& path
+        ) {
+            core::ProfileScope scope(core::ProfileZone::AStar);
+            scope.setTraceArgs({ start.row, start.column, goal.row, goal.column });
+            path.clear();
+
+            const int width = map.getWidth();
+            const int height = map.getHeight();
+            auto inBounds = [&bounds](const types::Position& pos) {
+                return pos.row >= bounds.minRow && pos.row <= bounds.maxRow &&
+                    pos.column >= bounds.minColumn && pos.column <= bounds.maxColumn;
+            };
+            if (!inBounds(start) || !inBounds(goal) || start == goal) {
+                return false;
+            }
+
+            beginSearch(width, height);
+
+            const int startIndex = start.row * width + start.column;
+            const int goalIndex = goal.row * width + goal.column;
+            const OpenEntryGreater greater;
+            int expanded = 0;  // 확정한 타일 수 (타임라인 기록용)
+
+            gCost_[startIndex] = 0;
+            parent_[startIndex] = -1;
+            openStamp_[startIndex] = generation_;
+            int startH = utils::manhattanDistance(start, goal);
+            openHeap_.push_back({ startH, startH, startIndex });
+
+            while (!openHeap_.empty()) {
+                std::pop_heap(openHeap_.begin(), openHeap_.end(), greater);
+                OpenEntry current = openHeap_.back();
+                openHeap_.pop_back();
+
+                // 더 싼 비용으로 이미 확정된 타일의 낡은 항목은 건너뜁니다.
+                if (closedStamp_[current.index] == generation_) {
+                    continue;
+                }
+                closedStamp_[current.index] = generation_;
+                ++expanded;
+
+                // 목표 지점에 도달하면 goal부터 부모를 따라가며 경로를 채웁니다 (다음 이동 위치가 맨 뒤).
+                if (current.index == goalIndex) {
+                    for (int index = goalIndex; index != startIndex; index = parent_[index]) {
+                        path.push_back({ index / width, index % width });
+                    }
+                    scope.setTraceArgs({ start.row, start.column, goal.row, goal.column, expanded, 1 });
+                    return true;
+                }
+
+                types::Position currentPos{ current.index / width, current.index % width };
+                int newGCost = gCost_[current.index] + 1; // 기본 이동 비용
+
+                for (const auto& dir : DIRECTIONS) {
+                    types::Position neighborPos = currentPos + dir;
+                    if (!inBounds(neighborPos)) continue;
+
+                    int neighbor = neighborPos.row * width + neighborPos.column;
+                    if (closedStamp_[neighbor] == generation_) continue;
+                    if (openStamp_[neighbor] == generation_ && gCost_[neighbor] <= newGCost) continue;
+                    if (!isPassable(map, neighbor, goalIndex)) continue;
+
+                    gCost_[neighbor] = newGCost;
+                    parent_[neighbor] = current.index;
+                    openStamp_[neighbor] = generation_;
+
+                    int hCost = utils::manhattanDistance(neighborPos, goal);
+                    openHeap_.push_back({ newGCost + hCost, hCost, neighbor });
+                    std::push_heap(openHeap_.begin(), openHeap_.end(), greater);
+                }
+            }
+
+            // 경로를 찾지 못한 경우
+            scope.setTraceArgs({ start.row, start.column, goal.row, goal.column, expanded, 0 });
+            return false;
+        }
+
+    } // namespace pathfinding
+} // namespace dune
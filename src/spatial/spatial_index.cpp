@@ -0,0 +1,19 @@
+#include "spatial/spatial_index.hpp"
+#include "spatial/quad_tree.hpp"
+#include "spatial/uniform_grid.hpp"
+
+namespace dune {
+    namespace spatial {
+
+        std::unique_ptr<SpatialIndex> createSpatialIndex(SpatialIndexType type, int width, int height) {
+            switch (type) {
+            case SpatialIndexType::QuadTree:
+                return std::make_unique<QuadTree>(0, 0, width, height, 10);
+            case SpatialIndexType::UniformGrid:
+            default:
+                return std::make_unique<UniformGrid>(width, height);
+            }
+        }
+
+    } // namespace spatial
+} // namespace dune
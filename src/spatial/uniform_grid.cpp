@@ -0,0 +1,78 @@
+#include "spatial/uniform_grid.hpp"
+#include "entity/unit.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace dune {
+    namespace spatial {
+
+        UniformGrid::UniformGrid(int width, int height, int cellSize)
+            : width_(width), height_(height), cellSize_(std::max(1, cellSize))
+            , columns_(std::max(1, (width + cellSize_ - 1) / cellSize_))
+            , rows_(std::max(1, (height + cellSize_ - 1) / cellSize_))
+            , cells_(static_cast<size_t>(columns_) * rows_) {}
+
+        int UniformGrid::cellColumn(int column) const {
+            return std::clamp(column / cellSize_, 0, columns_ - 1);
+        }
+
+        int UniformGrid::cellRow(int row) const {
+            return std::clamp(row / cellSize_, 0, rows_ - 1);
+        }
+
+        int UniformGrid::cellIndex(const types::Position& position) const {
+            return cellRow(position.row) * columns_ + cellColumn(position.column);
+        }
+
+        void UniformGrid::insert(const entity::Unit* unit) {
+            if (!unit) {
+                throw std::invalid_argument("Invalid unit pointer passed to UniformGrid::insert.");
+            }
+            // 셀 안은 고유 번호 순으로 둡니다. 검색 결과의 순서가 넣고 뺀 이력이 아니라 위치와 번호만으로 정해지므로,
+            // 체크포인트로 되돌린 유닛을 다시 넣어도 되돌리지 않은 경기와 같은 순서가 됩니다.
+            auto& cell = cells_[cellIndex(unit->getPosition())];
+            const auto it = std::upper_bound(cell.begin(), cell.end(), unit->getId(),
+                [](std::uint32_t id, const entity::Unit* other) { return id < other->getId(); });
+            cell.insert(it, unit);
+        }
+
+        bool UniformGrid::remove(const entity::Unit* unit) {
+            if (!unit) return false;
+
+            auto& cell = cells_[cellIndex(unit->getPosition())];
+            auto it = std::find(cell.begin(), cell.end(), unit);
+            if (it == cell.end()) {
+                return false;
+            }
+
+            cell.erase(it);
+            return true;
+        }
+
+        void UniformGrid::queryRange(int qx, int qy, int qw, int qh, std::vector<const entity::Unit*>& results) const {
+            int maxX = qx + qw;
+            int maxY = qy + qh;
+            if (maxX < qx || maxY < qy) return;
+
+            // 영역 밖 좌표는 가장자리 셀로 고정되므로 쿼리 범위도 같은 방식으로 셀 범위로 바꿉니다.
+            int firstColumn = cellColumn(qx);
+            int lastColumn = cellColumn(maxX);
+            int firstRow = cellRow(qy);
+            int lastRow = cellRow(maxY);
+
+            for (int cy = firstRow; cy <= lastRow; ++cy) {
+                const auto* rowCells = &cells_[static_cast<size_t>(cy) * columns_];
+                for (int cx = firstColumn; cx <= lastColumn; ++cx) {
+                    for (const auto* unit : rowCells[cx]) {
+                        types::Position pos = unit->getPosition();
+                        if (pos.column >= qx && pos.column <= maxX &&
+                            pos.row >= qy && pos.row <= maxY) {
+                            results.push_back(unit);
+                        }
+                    }
+                }
+            }
+        }
+
+    } // namespace spatial
+} // namespace dune
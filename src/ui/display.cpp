@@ -1,4 +1,5 @@
 #include "ui/display.hpp"
+#include "core/profiler.hpp"
 
 namespace dune {
     namespace ui {
@@ -15,19 +16,40 @@ namespace dune {
             , totalHeight_(constants::RESOURCE_HEIGHT + mapHeight + constants::SYSTEM_MESSAGE_HEIGHT) {}
 
         void Display::update(const types::Resource& resource, const core::Map& map, const Cursor& cursor) {
+            core::ProfileScope scope(core::ProfileZone::DisplayUpdate);
             renderer_.clear();
 
-            resourceBar_.update(resource);
-            resourceBar_.draw(renderer_);
+            // 창들은 서로 겹치지 않는 영역에 그리므로 맵과 나머지 창을 따로 구성할 수 있습니다.
+            // 커서는 맵 위에 덧그리므로 맵 구성이 끝난 뒤에 그립니다.
+            auto drawPanels = [&] {
+                resourceBar_.update(resource);
+                resourceBar_.draw(renderer_);
 
-            mapRenderer_.draw(renderer_, map);
+                statusWindow_.draw(renderer_);
+                commandWindow_.draw(renderer_);
+                messageWindow_.draw(renderer_);
+            };
 
-            statusWindow_.draw(renderer_);
-            commandWindow_.draw(renderer_);
-            messageWindow_.draw(renderer_);
+            if (jobs_) {
+                core::Job mapJob([&] { mapRenderer_.draw(renderer_, map); });
+                core::Job cursorJob([&] { cursor.draw(renderer_, map); });
+                core::Job panelJob(drawPanels);
+                cursorJob.dependsOn(mapJob);
 
-            cursor.draw(renderer_, map);
+                jobs_->submit(cursorJob);
+                jobs_->submit(panelJob);
+                jobs_->submit(mapJob);
+                jobs_->wait(cursorJob);
+                jobs_->wait(panelJob);
+            }
+            else {
+                drawPanels();
+                mapRenderer_.draw(renderer_, map);
+                cursor.draw(renderer_, map);
+            }
 
+            // 콘솔 출력은 한 스레드에서만 합니다.
+            core::ProfileScope flushScope(core::ProfileZone::ConsoleFlush);
             renderer_.render();
         }
 
@@ -35,6 +57,10 @@ namespace dune {
             messageWindow_.addMessage(message);
         }
 
+        void Display::addGameEvent(const core::GameEvent& event) {
+            messageWindow_.addEvent(event);
+        }
+
         void Display::updateStatus(const std::wstring& status) {
             statusWindow_.updateStatus(status);
         }
@@ -53,8 +53,7 @@ namespace dune {
         }
 
         void MapRenderer::drawGroundUnits(Renderer& renderer, const core::Map& map) {
-            for (const auto& entry : map.getUnitManager().getUnits()) {
-                const auto& unitPtr = entry.second;
+            for (const auto& unitPtr : map.getUnitManager().getUnits()) {
                 if (unitPtr->getType() != types::UnitType::DesertEagle) {
                     types::Position pos = unitPtr->getPosition();
                     int drawX = x_ + pos.column + 1;
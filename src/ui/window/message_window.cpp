@@ -1,4 +1,5 @@
 #include "ui/window/message_window.hpp"
+#include "entity/unit_descriptor.hpp"
 #include "utils/constants.hpp"
 #include <locale>
 #include <codecvt>
@@ -36,6 +37,38 @@ namespace dune {
             }
         }
 
+        void MessageWindow::addEvent(const core::GameEvent& event) {
+            switch (event.type) {
+            case core::GameEventType::SpiceDelivered:
+                addMessage(L"Harvester returned with " + std::to_wstring(event.amount) + L" spice.");
+                break;
+            case core::GameEventType::UnitKilled:
+                if (event.sourceType == types::UnitType::Sandworm) {
+                    addMessage(std::wstring(L"Sandworm caught a ") + entity::getUnitDescriptor(event.unitType).name + L"!");
+                }
+                else {
+                    addMessage(std::wstring(L"A ") + entity::getUnitDescriptor(event.unitType).name + L" was destroyed!");
+                }
+                break;
+            case core::GameEventType::BuildingDestroyed:
+                addMessage(L"The building was destroyed!");
+                break;
+            case core::GameEventType::SpiceCreated:
+                addMessage(L"Sandworm has created a new spice field!");
+                break;
+            case core::GameEventType::UnitAttacked:
+                if (event.camp == types::Camp::ArtLadies) {
+                    addMessage(std::wstring(L"Our ") + entity::getUnitDescriptor(event.unitType).name +
+                        L" attacks enemy for " + std::to_wstring(event.amount) + L" damage!");
+                }
+                else {
+                    addMessage(std::wstring(L"Enemy ") + entity::getUnitDescriptor(event.unitType).name +
+                        L" attacks us for " + std::to_wstring(event.amount) + L" damage!");
+                }
+                break;
+            }
+        }
+
         void MessageWindow::draw(Renderer& renderer) {
             cleanupOldMessages();
 
@@ -0,0 +1,67 @@
+#include "utils/command_line.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace dune {
+    namespace utils {
+
+        namespace {
+            bool parseNumber(const std::string& text, std::uint64_t& value) {
+                if (text.empty() || text[0] == '-') {
+                    return false;
+                }
+                char* end = nullptr;
+                value = std::strtoull(text.c_str(), &end, 0);
+                return *end == '\0';
+            }
+        }
+
+        bool CommandLine::parse(int argc, char* argv[], std::initializer_list<OptionSpec> specs) {
+            values_.clear();
+            positionals_.clear();
+            error_.clear();
+
+            for (int i = 1; i < argc; ++i) {
+                const std::string argument = argv[i];
+                if (argument.rfind("--", 0) != 0) {
+                    positionals_.push_back(argument);
+                    continue;
+                }
+
+                const auto spec = std::find_if(specs.begin(), specs.end(),
+                    [&](const OptionSpec& candidate) { return argument == candidate.name; });
+                if (spec == specs.end()) {
+                    error_ = "unknown option: " + argument;
+                    return false;
+                }
+                if (i + 1 >= argc) {
+                    error_ = "missing value for " + argument;
+                    return false;
+                }
+                const std::string value = argv[++i];
+                std::uint64_t number = 0;
+                if (spec->numeric && !parseNumber(value, number)) {
+                    error_ = "not a number for " + argument + ": " + value;
+                    return false;
+                }
+                values_[argument] = value;
+            }
+            return true;
+        }
+
+        std::string CommandLine::getString(const std::string& name, const std::string& fallback) const {
+            const auto it = values_.find(name);
+            return it != values_.end() ? it->second : fallback;
+        }
+
+        std::uint64_t CommandLine::getNumber(const std::string& name, std::uint64_t fallback) const {
+            std::uint64_t value = fallback;
+            const auto it = values_.find(name);
+            if (it != values_.end()) {
+                parseNumber(it->second, value);
+            }
+            return value;
+        }
+
+    } // namespace utils
+} // namespace dune
@@ -0,0 +1,169 @@
+#include "utils/log.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace dune {
+    namespace utils {
+
+        namespace {
+            const char* levelName(LogLevel level) {
+                switch (level) {
+                case LogLevel::Debug:   return "DEBUG";
+                case LogLevel::Info:    return "INFO";
+                case LogLevel::Warning: return "WARN";
+                case LogLevel::Error:   return "ERROR";
+                default:                return "";
+                }
+            }
+
+            // 로그 파일은 UTF-8로 씁니다.
+            void appendUtf8(std::string& out, const wchar_t* text, std::size_t length) {
+                for (std::size_t i = 0; i < length; ++i) {
+                    auto code = static_cast<std::uint32_t>(text[i]);
+                    if (code < 0x80) {
+                        out.push_back(static_cast<char>(code));
+                    }
+                    else if (code < 0x800) {
+                        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                    }
+                    else if (code < 0x10000) {
+                        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                    }
+                    else {
+                        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                    }
+                }
+            }
+        }
+
+        Logger& Logger::instance() {
+            static Logger logger;
+            return logger;
+        }
+
+        Logger::Logger()
+            : slots_(std::make_unique<Slot[]>(CAPACITY))
+            , start_(std::chrono::steady_clock::now()) {
+            for (std::size_t i = 0; i < CAPACITY; ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        Logger::~Logger() {
+            close();
+        }
+
+        bool Logger::open(const std::string& path, LogLevel level) {
+            close();
+
+            file_.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!file_) {
+                return false;
+            }
+
+            stopping_ = false;
+            sinkThread_ = std::thread(&Logger::sinkLoop, this);
+            setLevel(level);
+            return true;
+        }
+
+        void Logger::close() {
+            setLevel(LogLevel::Off);
+            if (sinkThread_.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(sinkMutex_);
+                    stopping_ = true;
+                }
+                sinkCondition_.notify_one();
+                sinkThread_.join();
+            }
+            if (file_.is_open()) {
+                drain();
+                file_.close();
+            }
+        }
+
+        void Logger::write(LogLevel level, const std::wstring& message) {
+            // 빈 칸을 예약합니다. 기록 스레드가 아직 비우지 못한 칸이면 가득 찬 것입니다.
+            std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            for (;;) {
+                slot = &slots_[pos & (CAPACITY - 1)];
+                const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (diff < 0) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                else {
+                    pos = enqueuePos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            Record& record = slot->record;
+            record.level = level;
+            record.length = static_cast<std::uint16_t>(std::min(message.size(), MAX_TEXT));
+            record.micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start_).count();
+            std::copy_n(message.data(), record.length, record.text);
+
+            slot->sequence.store(pos + 1, std::memory_order_release);
+        }
+
+        void Logger::sinkLoop() {
+            std::unique_lock<std::mutex> lock(sinkMutex_);
+            while (!stopping_) {
+                lock.unlock();
+                const std::size_t written = drain();
+                lock.lock();
+
+                // 기록하는 쪽이 잠금을 잡지 않도록 깨우지 않고 주기적으로 확인합니다.
+                if (written == 0) {
+                    sinkCondition_.wait_for(lock, FLUSH_INTERVAL, [this] { return stopping_; });
+                }
+            }
+        }
+
+        std::size_t Logger::drain() {
+            std::string line;
+            std::size_t written = 0;
+            for (;;) {
+                Slot& slot = slots_[dequeuePos_ & (CAPACITY - 1)];
+                if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+                    break;
+                }
+
+                const Record& record = slot.record;
+                char prefix[48];
+                std::snprintf(prefix, sizeof(prefix), "[%10.3f] %-5s ",
+                    record.micros / 1000.0, levelName(record.level));
+                line.assign(prefix);
+                appendUtf8(line, record.text, record.length);
+                line.push_back('\n');
+
+                // 다음 바퀴에서 기록할 수 있도록 칸을 비웁니다.
+                slot.sequence.store(dequeuePos_ + CAPACITY, std::memory_order_release);
+                ++dequeuePos_;
+
+                file_.write(line.data(), static_cast<std::streamsize>(line.size()));
+                ++written;
+            }
+            if (written > 0) {
+                file_.flush();
+            }
+            return written;
+        }
+
+    } // namespace utils
+} // namespace dune
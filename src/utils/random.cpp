@@ -0,0 +1,67 @@
+#include "utils/random.hpp"
+
+namespace dune {
+    namespace utils {
+
+        namespace {
+            std::uint64_t splitmix64(std::uint64_t& x) {
+                std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                return z ^ (z >> 31);
+            }
+        }
+
+        void Xoshiro256::reseed(std::uint64_t seed) {
+            for (auto& word : state_) {
+                word = splitmix64(seed);
+            }
+        }
+
+        int Xoshiro256::nextInt(int min, int max) {
+            // Lemire의 곱셈 방식: 나머지 연산 없이 범위로 줄이고, 치우치는 구간만 다시 뽑습니다.
+            const std::uint32_t range = static_cast<std::uint32_t>(
+                static_cast<std::int64_t>(max) - static_cast<std::int64_t>(min) + 1);
+            std::uint64_t product = (next() >> 32) * range;
+            std::uint32_t low = static_cast<std::uint32_t>(product);
+            if (low < range) {
+                const std::uint32_t threshold = static_cast<std::uint32_t>(-range) % range;
+                while (low < threshold) {
+                    product = (next() >> 32) * range;
+                    low = static_cast<std::uint32_t>(product);
+                }
+            }
+            return min + static_cast<int>(product >> 32);
+        }
+
+        void Xoshiro256::jump() {
+            static constexpr std::uint64_t JUMP[] = {
+                0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+            };
+
+            std::array<std::uint64_t, 4> jumped{};
+            for (std::uint64_t word : JUMP) {
+                for (int bit = 0; bit < 64; ++bit) {
+                    if (word & (std::uint64_t{ 1 } << bit)) {
+                        for (std::size_t i = 0; i < jumped.size(); ++i) {
+                            jumped[i] ^= state_[i];
+                        }
+                    }
+                    next();
+                }
+            }
+            state_ = jumped;
+        }
+
+        void RandomStreams::reseed(std::uint64_t seed) {
+            seed_ = seed;
+            // 같은 수열에서 2^128씩 떨어진 구간을 용도별로 나눠 줍니다.
+            Xoshiro256 base(seed);
+            for (auto& stream : streams_) {
+                stream = base;
+                base.jump();
+            }
+        }
+
+    } // namespace utils
+} // namespace dune